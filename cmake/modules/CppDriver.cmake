@@ -998,6 +998,8 @@ macro(CassConfigure)
   # Determine random availability
   if(CMAKE_SYSTEM_NAME MATCHES "Linux")
     check_symbol_exists(GRND_NONBLOCK "linux/random.h" HAVE_GETRANDOM)
+    # Determine if kernel TLS (kTLS) is available
+    check_symbol_exists(TLS_TX "linux/tls.h" HAVE_KTLS)
   else()
     check_symbol_exists(arc4random_buf "stdlib.h" HAVE_ARC4RANDOM)
   endif()
@@ -1022,6 +1024,17 @@ macro(CassConfigure)
     check_cxx_source_compiles("int main() { return __builtin_bswap64(42); }" HAVE_BUILTIN_BSWAP64)
   endif()
 
+  # Check for C++20 coroutines (used by the coroutine example and unit tests)
+  list(FIND CMAKE_CXX_COMPILE_FEATURES cxx_std_20 CXX_STD_20_INDEX)
+  if(CXX_STD_20_INDEX GREATER -1 AND DEFINED CMAKE_CXX20_STANDARD_COMPILE_OPTION)
+    set(CMAKE_REQUIRED_FLAGS ${CMAKE_CXX20_STANDARD_COMPILE_OPTION})
+    check_cxx_source_compiles("
+      #include <coroutine>
+      int main() { std::coroutine_handle<> handle = std::noop_coroutine(); handle.resume(); return 0; }"
+      HAVE_CXX_COROUTINES)
+    unset(CMAKE_REQUIRED_FLAGS)
+  endif()
+
   # Generate the cassconfig.hpp file
   configure_file(${CASS_ROOT_DIR}/cassconfig.hpp.in ${CASS_SRC_DIR}/cassconfig.hpp)
 endmacro()
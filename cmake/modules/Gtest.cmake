@@ -187,6 +187,15 @@ macro(GtestUnitTests project_name extra_source_files)
   file(GLOB UNIT_TESTS_INCLUDE_FILES ${UNIT_TESTS_SOURCE_DIR}/*.hpp )
   file(GLOB UNIT_TESTS_SOURCE_FILES ${UNIT_TESTS_SOURCE_DIR}/*.cpp)
   file(GLOB UNIT_TESTS_TESTS_SOURCE_FILES ${UNIT_TESTS_SOURCE_DIR}/tests/*.cpp)
+
+  # The coroutine tests require C++20 coroutines (see CassConfigure)
+  set(UNIT_TESTS_COROUTINE_SOURCE_FILE "${UNIT_TESTS_SOURCE_DIR}/tests/test_coroutine.cpp")
+  if(HAVE_CXX_COROUTINES)
+    set_source_files_properties(${UNIT_TESTS_COROUTINE_SOURCE_FILE}
+        PROPERTIES COMPILE_FLAGS ${CMAKE_CXX20_STANDARD_COMPILE_OPTION})
+  else()
+    list(REMOVE_ITEM UNIT_TESTS_TESTS_SOURCE_FILES ${UNIT_TESTS_COROUTINE_SOURCE_FILE})
+  endif()
   source_group("Header Files" FILES ${UNIT_TESTS_INCLUDE_FILES})
   source_group("Source Files" FILES ${UNIT_TESTS_SOURCE_FILES})
   source_group("Source Files\\tests" FILES ${UNIT_TESTS_TESTS_SOURCE_FILES})
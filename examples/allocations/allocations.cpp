@@ -0,0 +1,138 @@
+/*
+  This is free and unencumbered software released into the public domain.
+
+  Anyone is free to copy, modify, publish, use, compile, sell, or
+  distribute this software, either in source code form or as a compiled
+  binary, for any purpose, commercial or non-commercial, and by any
+  means.
+
+  In jurisdictions that recognize copyright laws, the author or authors
+  of this software dedicate any and all copyright interest in the
+  software to the public domain. We make this dedication for the benefit
+  of the public at large and to the detriment of our heirs and
+  successors. We intend this dedication to be an overt act of
+  relinquishment in perpetuity of all present and future rights to this
+  software under copyright law.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+  OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+  OTHER DEALINGS IN THE SOFTWARE.
+
+  For more information, please refer to <http://unlicense.org/>
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <atomic>
+
+#include "cassandra.h"
+
+/*
+ * Reports the number of allocations per request in the steady state. The
+ * driver's allocations are counted by installing allocator functions using
+ * cass_alloc_set_functions() (this includes libuv's allocations with libuv
+ * 1.6.0 and later). Allocations made by standard containers that use the
+ * default allocator aren't counted.
+ */
+
+#define NUM_CONCURRENT_REQUESTS 1000
+#define NUM_WARMUP_ITERATIONS 10
+#define NUM_ITERATIONS 100
+
+static std::atomic<unsigned long long> num_mallocs(0);
+static std::atomic<unsigned long long> num_reallocs(0);
+
+void* counting_malloc(size_t size) {
+  num_mallocs.fetch_add(1, std::memory_order_relaxed);
+  return malloc(size);
+}
+
+void* counting_realloc(void* ptr, size_t size) {
+  num_reallocs.fetch_add(1, std::memory_order_relaxed);
+  return realloc(ptr, size);
+}
+
+void counting_free(void* ptr) {
+  free(ptr);
+}
+
+void run_iterations(CassSession* session, const CassPrepared* prepared, int num_iterations) {
+  CassFuture* futures[NUM_CONCURRENT_REQUESTS];
+  for (int i = 0; i < num_iterations; ++i) {
+    for (int j = 0; j < NUM_CONCURRENT_REQUESTS; ++j) {
+      CassStatement* statement = cass_prepared_bind(prepared);
+      futures[j] = cass_session_execute(session, statement);
+      cass_statement_free(statement);
+    }
+    for (int j = 0; j < NUM_CONCURRENT_REQUESTS; ++j) {
+      cass_future_wait(futures[j]);
+      cass_future_free(futures[j]);
+    }
+  }
+}
+
+int main(int argc, char* argv[]) {
+  const char* hosts = "127.0.0.1";
+  if (argc > 1) {
+    hosts = argv[1];
+  }
+
+  // This must be done before any other driver function is called
+  cass_alloc_set_functions(counting_malloc, counting_realloc, counting_free);
+
+  CassCluster* cluster = cass_cluster_new();
+  cass_cluster_set_contact_points(cluster, hosts);
+  cass_cluster_set_queue_size_io(cluster, 10000);
+  CassSession* session = cass_session_new();
+
+  CassFuture* future = cass_session_connect(session, cluster);
+  CassError rc = cass_future_error_code(future);
+  cass_future_free(future);
+  if (rc != CASS_OK) {
+    fprintf(stderr, "Unable to connect: %s\n", cass_error_desc(rc));
+    cass_session_free(session);
+    cass_cluster_free(cluster);
+    return -1;
+  }
+
+  future = cass_session_prepare(session, "SELECT release_version FROM system.local");
+  const CassPrepared* prepared = cass_future_get_prepared(future);
+  cass_future_free(future);
+
+  if (prepared != NULL) {
+    // Fill the object pools and the connections' buffers
+    run_iterations(session, prepared, NUM_WARMUP_ITERATIONS);
+
+    CassObjectPoolMetrics pool_start;
+    cass_alloc_get_object_pool_metrics(&pool_start);
+    unsigned long long mallocs = num_mallocs.load();
+    unsigned long long reallocs = num_reallocs.load();
+    run_iterations(session, prepared, NUM_ITERATIONS);
+    mallocs = num_mallocs.load() - mallocs;
+    reallocs = num_reallocs.load() - reallocs;
+    CassObjectPoolMetrics pool_end;
+    cass_alloc_get_object_pool_metrics(&pool_end);
+
+    double num_requests = NUM_ITERATIONS * NUM_CONCURRENT_REQUESTS;
+    printf("%.2f mallocs/request\n", mallocs / num_requests);
+    printf("%.2f reallocs/request\n", reallocs / num_requests);
+    /* Misses are included in the mallocs above */
+    printf("%.2f pool hits/request\n", (pool_end.hits - pool_start.hits) / num_requests);
+    printf("%.2f pool misses/request\n", (pool_end.misses - pool_start.misses) / num_requests);
+
+    cass_prepared_free(prepared);
+  } else {
+    fprintf(stderr, "Unable to prepare the query\n");
+  }
+
+  cass_session_free(session);
+  cass_cluster_free(cluster);
+
+  return prepared != NULL ? 0 : -1;
+}
@@ -0,0 +1,184 @@
+/*
+  This is free and unencumbered software released into the public domain.
+
+  Anyone is free to copy, modify, publish, use, compile, sell, or
+  distribute this software, either in source code form or as a compiled
+  binary, for any purpose, commercial or non-commercial, and by any
+  means.
+
+  In jurisdictions that recognize copyright laws, the author or authors
+  of this software dedicate any and all copyright interest in the
+  software to the public domain. We make this dedication for the benefit
+  of the public at large and to the detriment of our heirs and
+  successors. We intend this dedication to be an overt act of
+  relinquishment in perpetuity of all present and future rights to this
+  software under copyright law.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+  OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+  OTHER DEALINGS IN THE SOFTWARE.
+
+  For more information, please refer to <http://unlicense.org/>
+*/
+
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <uv.h>
+
+#include "cassandra_coroutine.h"
+
+/*
+ * A rough benchmark of awaiting requests in C++20 coroutines compared to
+ * chaining them with future callbacks. Each of the concurrent chains
+ * executes the same prepared statement sequentially.
+ */
+
+#define NUM_CONCURRENT_CHAINS 1000
+#define NUM_REQUESTS_PER_CHAIN 100
+
+struct Benchmark {
+  Benchmark()
+    : remaining(NUM_CONCURRENT_CHAINS)
+    , num_errors(0) { }
+
+  void chain_finished() {
+    if (--remaining == 0) {
+      std::lock_guard<std::mutex> lock(mutex);
+      cond.notify_one();
+    }
+  }
+
+  void wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    cond.wait(lock, [this] { return remaining == 0; });
+  }
+
+  CassSession* session;
+  const CassPrepared* prepared;
+  std::atomic<int> remaining;
+  std::atomic<unsigned long long> num_errors;
+  std::mutex mutex;
+  std::condition_variable cond;
+};
+
+struct Chain {
+  Benchmark* benchmark;
+  int count;
+};
+
+void on_result(CassFuture* future, void* data);
+
+void execute_next(Chain* chain) {
+  CassStatement* statement = cass_prepared_bind(chain->benchmark->prepared);
+  CassFuture* future = cass_session_execute(chain->benchmark->session, statement);
+  cass_future_set_callback(future, on_result, chain);
+  cass_future_free(future);
+  cass_statement_free(statement);
+}
+
+void on_result(CassFuture* future, void* data) {
+  Chain* chain = static_cast<Chain*>(data);
+  if (cass_future_error_code(future) != CASS_OK) {
+    chain->benchmark->num_errors++;
+  }
+  if (++chain->count < NUM_REQUESTS_PER_CHAIN) {
+    execute_next(chain);
+  } else {
+    Benchmark* benchmark = chain->benchmark;
+    delete chain;
+    benchmark->chain_finished();
+  }
+}
+
+cass::coro::Task run_chain(Benchmark* benchmark) {
+  for (int i = 0; i < NUM_REQUESTS_PER_CHAIN; ++i) {
+    cass::coro::Statement statement(cass_prepared_bind(benchmark->prepared));
+    cass::coro::Result result =
+        co_await cass::coro::execute(benchmark->session, statement.get());
+    if (!result) {
+      benchmark->num_errors++;
+    }
+  }
+  benchmark->chain_finished();
+}
+
+void report(const char* name, uint64_t elapsed, unsigned long long num_errors) {
+  printf("%-12s %12.2f requests/second (%llu errors)\n",
+         name,
+         (double)NUM_CONCURRENT_CHAINS * NUM_REQUESTS_PER_CHAIN /
+         ((double)elapsed / 1e9),
+         num_errors);
+}
+
+int main(int argc, char* argv[]) {
+  const char* hosts = "127.0.0.1";
+  if (argc > 1) {
+    hosts = argv[1];
+  }
+
+  CassCluster* cluster = cass_cluster_new();
+  cass_cluster_set_contact_points(cluster, hosts);
+  cass_cluster_set_queue_size_io(cluster, 10000);
+  CassSession* session = cass_session_new();
+
+  CassFuture* future = cass_session_connect(session, cluster);
+  CassError rc = cass_future_error_code(future);
+  cass_future_free(future);
+  if (rc != CASS_OK) {
+    fprintf(stderr, "Unable to connect: %s\n", cass_error_desc(rc));
+    cass_session_free(session);
+    cass_cluster_free(cluster);
+    return -1;
+  }
+
+  future = cass_session_prepare(session, "SELECT release_version FROM system.local");
+  const CassPrepared* prepared = cass_future_get_prepared(future);
+  cass_future_free(future);
+
+  if (prepared != NULL) {
+    { // Callbacks
+      Benchmark benchmark;
+      benchmark.session = session;
+      benchmark.prepared = prepared;
+      uint64_t start = uv_hrtime();
+      for (int i = 0; i < NUM_CONCURRENT_CHAINS; ++i) {
+        Chain* chain = new Chain();
+        chain->benchmark = &benchmark;
+        chain->count = 0;
+        execute_next(chain);
+      }
+      benchmark.wait();
+      report("callbacks:", uv_hrtime() - start, benchmark.num_errors);
+    }
+
+    { // Coroutines
+      Benchmark benchmark;
+      benchmark.session = session;
+      benchmark.prepared = prepared;
+      uint64_t start = uv_hrtime();
+      for (int i = 0; i < NUM_CONCURRENT_CHAINS; ++i) {
+        run_chain(&benchmark);
+      }
+      benchmark.wait();
+      report("coroutines:", uv_hrtime() - start, benchmark.num_errors);
+    }
+
+    cass_prepared_free(prepared);
+  } else {
+    fprintf(stderr, "Unable to prepare the query\n");
+  }
+
+  cass_session_free(session);
+  cass_cluster_free(cluster);
+
+  return prepared != NULL ? 0 : -1;
+}
@@ -0,0 +1,184 @@
+/*
+  This is free and unencumbered software released into the public domain.
+
+  Anyone is free to copy, modify, publish, use, compile, sell, or
+  distribute this software, either in source code form or as a compiled
+  binary, for any purpose, commercial or non-commercial, and by any
+  means.
+
+  In jurisdictions that recognize copyright laws, the author or authors
+  of this software dedicate any and all copyright interest in the
+  software to the public domain. We make this dedication for the benefit
+  of the public at large and to the detriment of our heirs and
+  successors. We intend this dedication to be an overt act of
+  relinquishment in perpetuity of all present and future rights to this
+  software under copyright law.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+  OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+  OTHER DEALINGS IN THE SOFTWARE.
+
+  For more information, please refer to <http://unlicense.org/>
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <uv.h>
+
+#include "cassandra.h"
+
+/*
+ * A rough benchmark of sharded sessions. For each core count from 1 to N
+ * (the second argument, default 4) a session with that many I/O threads is
+ * created and the same number of application threads, each bound to its own
+ * I/O thread, execute queries as fast as possible.
+ *
+ * Token aware routing is disabled because sharding is only used without it.
+ */
+
+#define MAX_SHARDS 64
+#define NUM_CONCURRENT_REQUESTS 1000
+#define NUM_ITERATIONS 100
+
+typedef struct Shard_ {
+  CassSession* session;
+  const CassPrepared* prepared;
+  unsigned index;
+  unsigned long long num_errors;
+} Shard;
+
+void print_error(CassFuture* future) {
+  const char* message;
+  size_t message_length;
+  cass_future_error_message(future, &message, &message_length);
+  fprintf(stderr, "Error: %.*s\n", (int)message_length, message);
+}
+
+CassCluster* create_cluster(const char* hosts, unsigned num_shards) {
+  CassCluster* cluster = cass_cluster_new();
+  cass_cluster_set_contact_points(cluster, hosts);
+  cass_cluster_set_num_threads_io(cluster, num_shards);
+  cass_cluster_set_session_sharding(cluster, cass_true);
+  cass_cluster_set_token_aware_routing(cluster, cass_false);
+  cass_cluster_set_queue_size_io(cluster, 10000);
+  cass_cluster_set_core_connections_per_host(cluster, 1);
+  cass_cluster_set_max_requests_per_flush(cluster, 10000);
+  return cluster;
+}
+
+void run_shard(void* data) {
+  int i, j;
+  Shard* shard = (Shard*)data;
+  CassFuture* futures[NUM_CONCURRENT_REQUESTS];
+
+  cass_session_bind_thread(shard->session, shard->index);
+
+  for (i = 0; i < NUM_ITERATIONS; ++i) {
+    for (j = 0; j < NUM_CONCURRENT_REQUESTS; ++j) {
+      CassStatement* statement = cass_prepared_bind(shard->prepared);
+      futures[j] = cass_session_execute(shard->session, statement);
+      cass_statement_free(statement);
+    }
+
+    for (j = 0; j < NUM_CONCURRENT_REQUESTS; ++j) {
+      if (cass_future_error_code(futures[j]) != CASS_OK) {
+        shard->num_errors++;
+      }
+      cass_future_free(futures[j]);
+    }
+  }
+}
+
+int run_benchmark(const char* hosts, unsigned num_shards) {
+  unsigned i;
+  CassError rc;
+  uint64_t start, elapsed;
+  unsigned long long num_errors = 0;
+  uv_thread_t threads[MAX_SHARDS];
+  Shard shards[MAX_SHARDS];
+  const CassPrepared* prepared = NULL;
+  CassFuture* future = NULL;
+  CassCluster* cluster = create_cluster(hosts, num_shards);
+  CassSession* session = cass_session_new();
+
+  future = cass_session_connect(session, cluster);
+  rc = cass_future_error_code(future);
+  if (rc != CASS_OK) {
+    print_error(future);
+    cass_future_free(future);
+    cass_session_free(session);
+    cass_cluster_free(cluster);
+    return -1;
+  }
+  cass_future_free(future);
+
+  future = cass_session_prepare(session, "SELECT release_version FROM system.local");
+  rc = cass_future_error_code(future);
+  if (rc != CASS_OK) {
+    print_error(future);
+  } else {
+    prepared = cass_future_get_prepared(future);
+  }
+  cass_future_free(future);
+
+  if (prepared != NULL) {
+    start = uv_hrtime();
+
+    for (i = 0; i < num_shards; ++i) {
+      shards[i].session = session;
+      shards[i].prepared = prepared;
+      shards[i].index = i;
+      shards[i].num_errors = 0;
+      uv_thread_create(&threads[i], run_shard, (void*)&shards[i]);
+    }
+
+    for (i = 0; i < num_shards; ++i) {
+      uv_thread_join(&threads[i]);
+      num_errors += shards[i].num_errors;
+    }
+
+    elapsed = uv_hrtime() - start;
+
+    printf("%2u core(s): %12.2f requests/second (%llu errors)\n",
+           num_shards,
+           (double)num_shards * NUM_ITERATIONS * NUM_CONCURRENT_REQUESTS /
+           ((double)elapsed / 1e9),
+           num_errors);
+
+    cass_prepared_free(prepared);
+  }
+
+  cass_session_free(session);
+  cass_cluster_free(cluster);
+
+  return prepared != NULL ? 0 : -1;
+}
+
+int main(int argc, char* argv[]) {
+  unsigned i;
+  unsigned max_shards = 4;
+  char* hosts = "127.0.0.1";
+  if (argc > 1) {
+    hosts = argv[1];
+  }
+  if (argc > 2) {
+    max_shards = (unsigned)atoi(argv[2]);
+    if (max_shards < 1 || max_shards > MAX_SHARDS) {
+      fprintf(stderr, "The number of cores must be between 1 and %d\n", MAX_SHARDS);
+      return -1;
+    }
+  }
+
+  for (i = 1; i <= max_shards; ++i) {
+    if (run_benchmark(hosts, i) != 0) {
+      return -1;
+    }
+  }
+
+  return 0;
+}
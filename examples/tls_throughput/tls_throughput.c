@@ -0,0 +1,252 @@
+/*
+  This is free and unencumbered software released into the public domain.
+
+  Anyone is free to copy, modify, publish, use, compile, sell, or
+  distribute this software, either in source code form or as a compiled
+  binary, for any purpose, commercial or non-commercial, and by any
+  means.
+
+  In jurisdictions that recognize copyright laws, the author or authors
+  of this software dedicate any and all copyright interest in the
+  software to the public domain. We make this dedication for the benefit
+  of the public at large and to the detriment of our heirs and
+  successors. We intend this dedication to be an overt act of
+  relinquishment in perpetuity of all present and future rights to this
+  software under copyright law.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+  OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+  OTHER DEALINGS IN THE SOFTWARE.
+
+  For more information, please refer to <http://unlicense.org/>
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <uv.h>
+
+#include "cassandra.h"
+
+/*
+ * A rough benchmark of TLS throughput. A blob of the given size (in KB, the
+ * third argument, default 256) is written and then read back repeatedly
+ * using a TLS connection. Kernel TLS offload is enabled when the fourth
+ * argument is "ktls". The trusted certificate is read from the file given as
+ * the second argument (peer verification is disabled if it can't be loaded).
+ *
+ * Usage: tls_throughput [hosts] [cert.pem] [size in KB] [ktls]
+ */
+
+#define NUM_CONCURRENT_REQUESTS 64
+#define NUM_ITERATIONS 100
+
+void print_error(CassFuture* future) {
+  const char* message;
+  size_t message_length;
+  cass_future_error_message(future, &message, &message_length);
+  fprintf(stderr, "Error: %.*s\n", (int)message_length, message);
+}
+
+int load_trusted_cert_file(const char* file, CassSsl* ssl) {
+  CassError rc;
+  char* cert;
+  long cert_size;
+  size_t bytes_read;
+
+  FILE *in = fopen(file, "rb");
+  if (in == NULL) {
+    fprintf(stderr, "Error loading certificate file '%s'\n", file);
+    return 0;
+  }
+
+  fseek(in, 0, SEEK_END);
+  cert_size = ftell(in);
+  rewind(in);
+
+  cert = (char*)malloc(cert_size);
+  bytes_read = fread(cert, 1, cert_size, in);
+  fclose(in);
+
+  rc = CASS_ERROR_SSL_INVALID_CERT;
+  if (bytes_read == (size_t) cert_size) {
+    rc = cass_ssl_add_trusted_cert_n(ssl, cert, cert_size);
+  }
+
+  free(cert);
+  return rc == CASS_OK;
+}
+
+CassError execute_query(CassSession* session, const char* query) {
+  CassError rc;
+  CassStatement* statement = cass_statement_new(query, 0);
+  CassFuture* future = cass_session_execute(session, statement);
+
+  rc = cass_future_error_code(future);
+  if (rc != CASS_OK) {
+    print_error(future);
+  }
+
+  cass_future_free(future);
+  cass_statement_free(statement);
+
+  return rc;
+}
+
+const CassPrepared* prepare_query(CassSession* session, const char* query) {
+  const CassPrepared* prepared = NULL;
+  CassFuture* future = cass_session_prepare(session, query);
+
+  if (cass_future_error_code(future) != CASS_OK) {
+    print_error(future);
+  } else {
+    prepared = cass_future_get_prepared(future);
+  }
+
+  cass_future_free(future);
+
+  return prepared;
+}
+
+unsigned long long run(CassSession* session, const CassPrepared* prepared,
+                       const cass_byte_t* blob, size_t blob_size) {
+  int i, j;
+  unsigned long long num_errors = 0;
+  CassFuture* futures[NUM_CONCURRENT_REQUESTS];
+
+  for (i = 0; i < NUM_ITERATIONS; ++i) {
+    for (j = 0; j < NUM_CONCURRENT_REQUESTS; ++j) {
+      CassStatement* statement = cass_prepared_bind(prepared);
+      cass_statement_bind_int32(statement, 0, j);
+      if (blob != NULL) {
+        cass_statement_bind_bytes(statement, 1, blob, blob_size);
+      }
+      futures[j] = cass_session_execute(session, statement);
+      cass_statement_free(statement);
+    }
+
+    for (j = 0; j < NUM_CONCURRENT_REQUESTS; ++j) {
+      if (cass_future_error_code(futures[j]) != CASS_OK) {
+        if (num_errors++ == 0) {
+          print_error(futures[j]);
+        }
+      }
+      cass_future_free(futures[j]);
+    }
+  }
+
+  return num_errors;
+}
+
+void print_throughput(const char* name, uint64_t elapsed, size_t blob_size,
+                      unsigned long long num_errors) {
+  double total = (double)NUM_ITERATIONS * NUM_CONCURRENT_REQUESTS * blob_size;
+  printf("%s: %10.2f MB/second (%llu errors)\n",
+         name,
+         total / (1024.0 * 1024.0) / ((double)elapsed / 1e9),
+         num_errors);
+}
+
+int main(int argc, char* argv[]) {
+  int rc = -1;
+  uint64_t start;
+  size_t blob_size = 256 * 1024;
+  cass_byte_t* blob;
+  unsigned long long num_errors;
+  const CassPrepared* insert = NULL;
+  const CassPrepared* select = NULL;
+  CassFuture* future = NULL;
+  CassCluster* cluster = cass_cluster_new();
+  CassSession* session = cass_session_new();
+  CassSsl* ssl = cass_ssl_new();
+  char* hosts = "127.0.0.1";
+  char* cert_file = "cert.pem";
+
+  if (argc > 1) {
+    hosts = argv[1];
+  }
+  if (argc > 2) {
+    cert_file = argv[2];
+  }
+  if (argc > 3) {
+    blob_size = (size_t)atoi(argv[3]) * 1024;
+    if (blob_size == 0) {
+      fprintf(stderr, "The size must be at least 1 KB\n");
+      return -1;
+    }
+  }
+  if (argc > 4 && strcmp(argv[4], "ktls") == 0) {
+    if (cass_ssl_set_kernel_offload(ssl, cass_true) != CASS_OK) {
+      fprintf(stderr, "Kernel TLS offload isn't supported by this build\n");
+    }
+  }
+
+  cass_ssl_set_verify_flags(ssl, CASS_SSL_VERIFY_PEER_CERT);
+  if (!load_trusted_cert_file(cert_file, ssl)) {
+    fprintf(stderr, "Failed to load certificate disabling peer verification\n");
+    cass_ssl_set_verify_flags(ssl, CASS_SSL_VERIFY_NONE);
+  }
+
+  cass_cluster_set_contact_points(cluster, hosts);
+  cass_cluster_set_ssl(cluster, ssl);
+  cass_cluster_set_num_threads_io(cluster, 1);
+  cass_cluster_set_core_connections_per_host(cluster, 1);
+
+  future = cass_session_connect(session, cluster);
+  if (cass_future_error_code(future) != CASS_OK) {
+    print_error(future);
+    goto done;
+  }
+
+  if (execute_query(session,
+                    "CREATE KEYSPACE IF NOT EXISTS examples WITH replication = { "
+                    "'class': 'SimpleStrategy', 'replication_factor': '1' }") != CASS_OK ||
+      execute_query(session,
+                    "CREATE TABLE IF NOT EXISTS examples.tls_throughput "
+                    "(key int PRIMARY KEY, value blob)") != CASS_OK) {
+    goto done;
+  }
+
+  insert = prepare_query(session,
+                         "INSERT INTO examples.tls_throughput (key, value) VALUES (?, ?)");
+  select = prepare_query(session,
+                         "SELECT value FROM examples.tls_throughput WHERE key = ?");
+  if (insert == NULL || select == NULL) {
+    goto done;
+  }
+
+  blob = (cass_byte_t*)malloc(blob_size);
+  memset(blob, 'a', blob_size);
+
+  printf("Value size: %u KB\n", (unsigned)(blob_size / 1024));
+
+  start = uv_hrtime();
+  num_errors = run(session, insert, blob, blob_size);
+  print_throughput("Writes", uv_hrtime() - start, blob_size, num_errors);
+
+  start = uv_hrtime();
+  num_errors = run(session, select, NULL, blob_size);
+  print_throughput(" Reads", uv_hrtime() - start, blob_size, num_errors);
+
+  free(blob);
+  rc = 0;
+
+done:
+  if (insert != NULL) {
+    cass_prepared_free(insert);
+  }
+  if (select != NULL) {
+    cass_prepared_free(select);
+  }
+  cass_future_free(future);
+  cass_session_free(session);
+  cass_cluster_free(cluster);
+  cass_ssl_free(ssl);
+
+  return rc;
+}
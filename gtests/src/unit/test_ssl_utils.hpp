@@ -0,0 +1,129 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_TEST_SSL_UTILS_HPP_INCLUDED__
+#define __CASS_TEST_SSL_UTILS_HPP_INCLUDED__
+
+#include "ssl.hpp"
+
+#ifdef HAVE_OPENSSL
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+#endif
+
+#if defined(HAVE_OPENSSL) && \
+    OPENSSL_VERSION_NUMBER >= 0x30000000L && !defined(LIBRESSL_VERSION_NUMBER)
+#define HAVE_TEST_TLS_SERVER
+
+// A minimal in-process stand-in for a TLS server (like "openssl s_server")
+// with a self-signed certificate. Connections use memory BIOs so the
+// encrypted bytes can be moved between the driver's sessions, the server
+// and sockets.
+class TlsServer {
+public:
+  class Connection {
+  public:
+    Connection(SSL_CTX* ctx)
+      : ssl_(SSL_new(ctx))
+      , rbio_(BIO_new(BIO_s_mem()))
+      , wbio_(BIO_new(BIO_s_mem())) {
+      SSL_set_bio(ssl_, rbio_, wbio_);
+      SSL_set_accept_state(ssl_);
+    }
+
+    ~Connection() {
+      // Keep the session resumable
+      SSL_set_shutdown(ssl_, SSL_SENT_SHUTDOWN | SSL_RECEIVED_SHUTDOWN);
+      SSL_free(ssl_);
+    }
+
+    bool is_handshake_done() const { return SSL_is_init_finished(ssl_) != 0; }
+
+    void do_handshake() { SSL_do_handshake(ssl_); }
+
+    void receive(const char* data, size_t size) { BIO_write(rbio_, data, size); }
+
+    size_t send(char* data, size_t size) {
+      int rc = BIO_read(wbio_, data, size);
+      return rc > 0 ? rc : 0;
+    }
+
+    int write(const char* data, size_t size) { return SSL_write(ssl_, data, size); }
+    int read(char* data, size_t size) { return SSL_read(ssl_, data, size); }
+
+    // Runs the handshake with a driver session to completion
+    bool handshake(cass::SslSession* session) {
+      char buf[16 * 1024];
+      for (int i = 0; i < 10; ++i) {
+        session->do_handshake();
+        if (session->has_error()) return false;
+        size_t size = session->outgoing().read(buf, sizeof(buf));
+        receive(buf, size);
+        do_handshake();
+        size = send(buf, sizeof(buf));
+        session->incoming().write(buf, size);
+        if (session->is_handshake_done() && is_handshake_done()) {
+          // Process any post-handshake messages (e.g. TLS 1.3 session tickets)
+          session->decrypt(buf, sizeof(buf));
+          return !session->has_error();
+        }
+      }
+      return false;
+    }
+
+  private:
+    SSL* ssl_;
+    BIO* rbio_;
+    BIO* wbio_;
+  };
+
+  TlsServer(int max_version)
+    : ctx_(SSL_CTX_new(TLS_server_method()))
+    , key_(EVP_EC_gen("P-256"))
+    , cert_(X509_new()) {
+    X509_set_version(cert_, 2);
+    ASN1_INTEGER_set(X509_get_serialNumber(cert_), 1);
+    X509_gmtime_adj(X509_getm_notBefore(cert_), 0);
+    X509_gmtime_adj(X509_getm_notAfter(cert_), 60 * 60);
+    X509_set_pubkey(cert_, key_);
+    X509_NAME* name = X509_get_subject_name(cert_);
+    X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+                               reinterpret_cast<const unsigned char*>("127.0.0.1"), -1, -1, 0);
+    X509_set_issuer_name(cert_, name);
+    X509_sign(cert_, key_, EVP_sha256());
+
+    SSL_CTX_use_certificate(ctx_, cert_);
+    SSL_CTX_use_PrivateKey(ctx_, key_);
+    SSL_CTX_set_max_proto_version(ctx_, max_version);
+  }
+
+  ~TlsServer() {
+    X509_free(cert_);
+    EVP_PKEY_free(key_);
+    SSL_CTX_free(ctx_);
+  }
+
+  Connection* accept() { return new Connection(ctx_); }
+
+private:
+  SSL_CTX* ctx_;
+  EVP_PKEY* key_;
+  X509* cert_;
+};
+
+#endif
+
+#endif
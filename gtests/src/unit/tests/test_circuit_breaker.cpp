@@ -0,0 +1,168 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "cassandra.h"
+#include "circuit_breaker.hpp"
+#include "dc_aware_policy.hpp"
+#include "scoped_ptr.hpp"
+
+#define ONE_MS (1000LL * 1000LL)
+
+static cass::CircuitBreaker::Settings settings(double failure_ratio, unsigned min_requests) {
+  cass::CircuitBreaker::Settings settings;
+  settings.failure_ratio = failure_ratio;
+  settings.min_requests = min_requests;
+  settings.open_time_ns = 100 * ONE_MS;
+  settings.window_ns = 1000 * ONE_MS;
+  return settings;
+}
+
+TEST(CircuitBreakerUnitTest, Open) {
+  cass::CircuitBreaker circuit_breaker(settings(0.5, 10));
+  uint64_t now = 1000 * ONE_MS;
+
+  // Not enough requests
+  for (int i = 0; i < 9; ++i) {
+    EXPECT_FALSE(circuit_breaker.on_failure(now, now));
+  }
+  EXPECT_EQ(cass::CircuitBreaker::CLOSED, circuit_breaker.state());
+
+  // A new window starts over
+  now += 1000 * ONE_MS;
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_FALSE(circuit_breaker.on_success(now, now));
+  }
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_FALSE(circuit_breaker.on_failure(now, now));
+  }
+  EXPECT_TRUE(circuit_breaker.allow_request(now));
+
+  // Half of the requests failed
+  EXPECT_TRUE(circuit_breaker.on_failure(now, now));
+  EXPECT_EQ(cass::CircuitBreaker::OPEN, circuit_breaker.state());
+  EXPECT_FALSE(circuit_breaker.allow_request(now));
+  EXPECT_FALSE(circuit_breaker.allow_request(now + 99 * ONE_MS));
+
+  // Late responses don't change an open circuit
+  EXPECT_FALSE(circuit_breaker.on_success(now, now));
+  EXPECT_EQ(cass::CircuitBreaker::OPEN, circuit_breaker.state());
+}
+
+TEST(CircuitBreakerUnitTest, HalfOpen) {
+  cass::CircuitBreaker circuit_breaker(settings(1.0, 1));
+  uint64_t now = 1000 * ONE_MS;
+
+  EXPECT_TRUE(circuit_breaker.on_failure(now, now));
+  EXPECT_FALSE(circuit_breaker.allow_request(now));
+
+  // A single probe is let through after the open time
+  now += 100 * ONE_MS;
+  EXPECT_TRUE(circuit_breaker.allow_request(now));
+  EXPECT_EQ(cass::CircuitBreaker::HALF_OPEN, circuit_breaker.state());
+  EXPECT_FALSE(circuit_breaker.allow_request(now));
+
+  // A failed probe opens the circuit again
+  EXPECT_TRUE(circuit_breaker.on_failure(now, now));
+  EXPECT_EQ(cass::CircuitBreaker::OPEN, circuit_breaker.state());
+  EXPECT_FALSE(circuit_breaker.allow_request(now + 50 * ONE_MS));
+
+  // A probe that never completes is replaced
+  now += 100 * ONE_MS;
+  EXPECT_TRUE(circuit_breaker.allow_request(now));
+  EXPECT_FALSE(circuit_breaker.allow_request(now + 50 * ONE_MS));
+  now += 100 * ONE_MS;
+  EXPECT_TRUE(circuit_breaker.allow_request(now));
+
+  // A successful probe closes the circuit
+  EXPECT_TRUE(circuit_breaker.on_success(now, now));
+  EXPECT_EQ(cass::CircuitBreaker::CLOSED, circuit_breaker.state());
+  EXPECT_TRUE(circuit_breaker.allow_request(now));
+  EXPECT_TRUE(circuit_breaker.allow_request(now));
+}
+
+TEST(CircuitBreakerUnitTest, OnlyProbeCloses) {
+  cass::CircuitBreaker circuit_breaker(settings(1.0, 1));
+  uint64_t sent = 1000 * ONE_MS;
+  uint64_t now = sent;
+
+  EXPECT_TRUE(circuit_breaker.on_failure(now, now));
+  now += 100 * ONE_MS;
+  EXPECT_TRUE(circuit_breaker.allow_request(now));
+
+  // A late response to a request sent before the circuit opened is ignored
+  EXPECT_FALSE(circuit_breaker.on_success(now + ONE_MS, sent));
+  EXPECT_FALSE(circuit_breaker.on_failure(now + ONE_MS, sent));
+  EXPECT_EQ(cass::CircuitBreaker::HALF_OPEN, circuit_breaker.state());
+
+  // The probe's success closes the circuit
+  EXPECT_TRUE(circuit_breaker.on_success(now + ONE_MS, now));
+  EXPECT_EQ(cass::CircuitBreaker::CLOSED, circuit_breaker.state());
+
+  // The window starts over when the circuit closes
+  now += 2 * ONE_MS;
+  EXPECT_TRUE(circuit_breaker.on_failure(now, now));
+  EXPECT_EQ(cass::CircuitBreaker::OPEN, circuit_breaker.state());
+
+  // A request sent while closed isn't the next probe
+  now += 100 * ONE_MS;
+  EXPECT_TRUE(circuit_breaker.allow_request(now));
+  EXPECT_FALSE(circuit_breaker.on_failure(now, now - 50 * ONE_MS));
+  EXPECT_EQ(cass::CircuitBreaker::HALF_OPEN, circuit_breaker.state());
+}
+
+TEST(CircuitBreakerUnitTest, QueryPlan) {
+  cass::HostMap hosts;
+  for (int i = 1; i <= 3; ++i) {
+    cass::Address address(i == 1 ? "1.0.0.0" : i == 2 ? "2.0.0.0" : "3.0.0.0", 9042);
+    cass::Host::Ptr host(new cass::Host(address, false));
+    host->set_up();
+    host->set_rack_and_dc("rack", "dc");
+    host->enable_circuit_breaker(settings(1.0, 1));
+    hosts[address] = host;
+  }
+
+  cass::DCAwarePolicy policy("dc", 0, false);
+  policy.init(cass::Host::Ptr(), hosts, NULL);
+
+  cass::Address open_address("2.0.0.0", 9042);
+  hosts[open_address]->record_request_failure(0);
+
+  // The host with the open circuit is skipped by every plan
+  for (int i = 0; i < 3; ++i) {
+    cass::ScopedPtr<cass::QueryPlan> qp(policy.new_query_plan("ks", NULL));
+    cass::Address address;
+    int count = 0;
+    while (qp->compute_next(&address)) {
+      EXPECT_FALSE(open_address == address);
+      ++count;
+    }
+    EXPECT_EQ(2, count);
+  }
+}
+
+TEST(CircuitBreakerUnitTest, Options) {
+  CassCluster* cluster = cass_cluster_new();
+
+  EXPECT_EQ(CASS_OK, cass_cluster_set_circuit_breaker(cluster, 0.5, 20, 1000));
+  EXPECT_EQ(CASS_OK, cass_cluster_set_circuit_breaker(cluster, 0.0, 0, 0));
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS, cass_cluster_set_circuit_breaker(cluster, 1.5, 20, 1000));
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS, cass_cluster_set_circuit_breaker(cluster, 0.5, 0, 1000));
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS, cass_cluster_set_circuit_breaker(cluster, 0.5, 20, 0));
+
+  cass_cluster_free(cluster);
+}
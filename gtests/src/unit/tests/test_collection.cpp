@@ -0,0 +1,124 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#include <gtest/gtest.h>
+
+#include "collection.hpp"
+#include "constants.hpp"
+#include "tuple.hpp"
+
+#include <string>
+
+namespace {
+
+std::string to_string(const cass::Buffer& buf) {
+  return std::string(buf.data(), buf.size());
+}
+
+} // namespace
+
+TEST(CollectionUnitTest, AppendArray) {
+  const cass_int64_t values[] = { 0, 1, -1, 0x0102030405060708LL, 42 };
+  const size_t count = sizeof(values) / sizeof(values[0]);
+
+  cass::Collection expected(CASS_COLLECTION_TYPE_LIST, count + 2);
+  cass::Collection array(CASS_COLLECTION_TYPE_LIST, 2);
+
+  // Arrays keep their position relative to single values
+  EXPECT_EQ(CASS_OK, expected.append(static_cast<cass_int64_t>(-2)));
+  for (size_t i = 0; i < count; ++i) {
+    EXPECT_EQ(CASS_OK, expected.append(values[i]));
+  }
+  EXPECT_EQ(CASS_OK, expected.append(static_cast<cass_int64_t>(-3)));
+
+  EXPECT_EQ(CASS_OK, array.append(static_cast<cass_int64_t>(-2)));
+  EXPECT_EQ(CASS_OK, array.append(values, count));
+  EXPECT_EQ(CASS_OK, array.append(values, 0));
+  EXPECT_EQ(CASS_OK, array.append(static_cast<cass_int64_t>(-3)));
+
+  EXPECT_EQ(expected.item_count(), array.item_count());
+  EXPECT_EQ(to_string(expected.encode()), to_string(array.encode()));
+  for (int version = 2; version <= CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION; ++version) {
+    EXPECT_EQ(expected.get_size_with_length(version), array.get_size_with_length(version));
+    EXPECT_EQ(to_string(expected.encode_with_length(version)),
+              to_string(array.encode_with_length(version)));
+  }
+}
+
+TEST(CollectionUnitTest, AppendArrayTypes) {
+  CassUuid uuids[2];
+  ASSERT_EQ(CASS_OK, cass_uuid_from_string("d8775a70-6ea4-11e4-9fa7-0db22d2a6140", &uuids[0]));
+  ASSERT_EQ(CASS_OK, cass_uuid_from_string("550e8400-e29b-41d4-a716-446655440000", &uuids[1]));
+  const cass_int32_t ints[] = { 1, -2 };
+  const cass_float_t floats[] = { 1.5f, -2.25f };
+  const cass_double_t doubles[] = { 1.5, -2.25 };
+
+  cass::Collection expected(CASS_COLLECTION_TYPE_LIST, 8);
+  cass::Collection array(CASS_COLLECTION_TYPE_LIST, 0);
+  for (size_t i = 0; i < 2; ++i) {
+    EXPECT_EQ(CASS_OK, expected.append(ints[i]));
+  }
+  for (size_t i = 0; i < 2; ++i) {
+    EXPECT_EQ(CASS_OK, expected.append(floats[i]));
+  }
+  for (size_t i = 0; i < 2; ++i) {
+    EXPECT_EQ(CASS_OK, expected.append(doubles[i]));
+  }
+  for (size_t i = 0; i < 2; ++i) {
+    EXPECT_EQ(CASS_OK, expected.append(uuids[i]));
+  }
+  EXPECT_EQ(CASS_OK, array.append(ints, 2));
+  EXPECT_EQ(CASS_OK, array.append(floats, 2));
+  EXPECT_EQ(CASS_OK, array.append(doubles, 2));
+  EXPECT_EQ(CASS_OK, array.append(uuids, 2));
+  EXPECT_EQ(to_string(expected.encode()), to_string(array.encode()));
+}
+
+TEST(CollectionUnitTest, AppendArrayInvalidType) {
+  const cass_int64_t values[] = { 1, 2 };
+
+  cass::DataType::Vec types;
+  types.push_back(cass::DataType::ConstPtr(new cass::DataType(CASS_VALUE_TYPE_INT)));
+  cass::Collection collection(
+        cass::CollectionType::ConstPtr(new cass::CollectionType(CASS_VALUE_TYPE_LIST, types, false)), 2);
+  EXPECT_EQ(CASS_ERROR_LIB_INVALID_VALUE_TYPE, collection.append(values, 2));
+  EXPECT_EQ(0u, collection.item_count());
+
+  // Map keys and values alternate
+  types.clear();
+  types.push_back(cass::DataType::ConstPtr(new cass::DataType(CASS_VALUE_TYPE_BIGINT)));
+  types.push_back(cass::DataType::ConstPtr(new cass::DataType(CASS_VALUE_TYPE_TEXT)));
+  cass::Collection collection_map(
+        cass::CollectionType::ConstPtr(new cass::CollectionType(CASS_VALUE_TYPE_MAP, types, false)), 2);
+  EXPECT_EQ(CASS_ERROR_LIB_INVALID_VALUE_TYPE, collection_map.append(values, 2));
+  EXPECT_EQ(CASS_OK, collection_map.append(values, 1));
+  EXPECT_EQ(1u, collection_map.item_count());
+}
+
+TEST(CollectionUnitTest, TupleSetArray) {
+  const cass_int32_t values[] = { 1, 2, 3 };
+
+  cass::Tuple expected(4);
+  cass::Tuple array(4);
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(CASS_OK, expected.set(i + 1, values[i]));
+  }
+  EXPECT_EQ(CASS_OK, array.set(1, values, 3));
+  EXPECT_EQ(to_string(expected.encode()), to_string(array.encode()));
+
+  EXPECT_EQ(CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS, array.set(2, values, 3));
+}
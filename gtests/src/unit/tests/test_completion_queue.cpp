@@ -0,0 +1,122 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "completion_queue.hpp"
+#include "future.hpp"
+
+#include <uv.h>
+
+static void on_set(CassFuture* future, void* data) { }
+
+TEST(CompletionQueueUnitTest, NextN) {
+  CassCompletionQueue* queue = cass_completion_queue_new();
+  CassCompletion completions[4];
+
+  int tags[3];
+  cass::Future* futures[3];
+  for (int i = 0; i < 3; ++i) {
+    futures[i] = new cass::Future(cass::CASS_FUTURE_TYPE_SESSION);
+    futures[i]->inc_ref();
+    EXPECT_EQ(CASS_OK, cass_completion_queue_add(queue, CassFuture::to(futures[i]), &tags[i]));
+  }
+
+  // Futures that aren't set aren't in the queue
+  EXPECT_EQ(0u, cass_completion_queue_next_n(queue, completions, 4, 0));
+  EXPECT_EQ(0u, cass_completion_queue_next_n(queue, completions, 4, 1000));
+
+  // The futures can be freed after they're added
+  futures[1]->set();
+  futures[0]->set();
+  cass_future_free(CassFuture::to(futures[0]));
+  futures[0] = NULL;
+
+  // The completions are in the order the futures were set
+  ASSERT_EQ(1u, cass_completion_queue_next_n(queue, completions, 1, 0));
+  EXPECT_EQ(&tags[1], completions[0].data);
+  EXPECT_TRUE(cass_future_ready(completions[0].future));
+  cass_future_free(completions[0].future);
+
+  ASSERT_EQ(1u, cass_completion_queue_next_n(queue, completions, 4, 0));
+  EXPECT_EQ(&tags[0], completions[0].data);
+  EXPECT_EQ(CASS_OK, cass_future_error_code(completions[0].future));
+  cass_future_free(completions[0].future);
+
+  // The queue is kept alive by the futures attached to it
+  cass_completion_queue_free(queue);
+  futures[2]->set();
+  cass_future_free(CassFuture::to(futures[1]));
+  cass_future_free(CassFuture::to(futures[2]));
+}
+
+TEST(CompletionQueueUnitTest, AlreadySet) {
+  cass::CompletionQueue::Ptr queue(new cass::CompletionQueue());
+
+  cass::Future::Ptr future(new cass::Future(cass::CASS_FUTURE_TYPE_SESSION));
+  future->set();
+  EXPECT_TRUE(future->set_completion_queue(queue.get(), NULL));
+  EXPECT_EQ(1u, queue->size());
+
+  // A future can't be added twice or also have a callback
+  cass::Future::Ptr other(new cass::Future(cass::CASS_FUTURE_TYPE_SESSION));
+  EXPECT_TRUE(other->set_completion_queue(queue.get(), NULL));
+  EXPECT_FALSE(other->set_completion_queue(queue.get(), NULL));
+  EXPECT_FALSE(other->set_callback(on_set, NULL));
+
+  cass::Future::Ptr with_callback(new cass::Future(cass::CASS_FUTURE_TYPE_SESSION));
+  EXPECT_TRUE(with_callback->set_callback(on_set, NULL));
+  EXPECT_FALSE(with_callback->set_completion_queue(queue.get(), NULL));
+}
+
+struct Producer {
+  cass::Future::Ptr futures[100];
+};
+
+static void set_futures(void* arg) {
+  Producer* producer = static_cast<Producer*>(arg);
+  for (int i = 0; i < 100; ++i) {
+    producer->futures[i]->set();
+  }
+}
+
+TEST(CompletionQueueUnitTest, Wait) {
+  cass::CompletionQueue::Ptr queue(new cass::CompletionQueue());
+
+  Producer producer;
+  for (int i = 0; i < 100; ++i) {
+    producer.futures[i].reset(new cass::Future(cass::CASS_FUTURE_TYPE_SESSION));
+    producer.futures[i]->set_completion_queue(queue.get(), NULL);
+  }
+
+  uv_thread_t thread;
+  uv_thread_create(&thread, set_futures, &producer);
+
+  // The consumer waits for the futures set by another thread
+  size_t total = 0;
+  CassCompletion completions[16];
+  while (total < 100) {
+    size_t n = queue->next_n(completions, 16, 10 * 1000 * 1000);
+    ASSERT_GT(n, 0u);
+    for (size_t i = 0; i < n; ++i) {
+      cass_future_free(completions[i].future);
+    }
+    total += n;
+  }
+
+  uv_thread_join(&thread);
+  EXPECT_EQ(0u, queue->size());
+}
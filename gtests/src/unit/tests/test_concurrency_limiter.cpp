@@ -0,0 +1,195 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "cassandra.h"
+#include "concurrency_limiter.hpp"
+#include "host.hpp"
+#include "loop_waker.hpp"
+
+#include <uv.h>
+
+#define ONE_MS (1000LL * 1000LL)
+#define WINDOW_NS (100LL * ONE_MS)
+
+static cass::ConcurrencyLimiter::Settings settings(unsigned initial_limit,
+                                                   unsigned min_limit,
+                                                   unsigned max_limit) {
+  cass::ConcurrencyLimiter::Settings settings;
+  settings.initial_limit = initial_limit;
+  settings.min_limit = min_limit;
+  settings.max_limit = max_limit;
+  settings.window_ns = WINDOW_NS;
+  return settings;
+}
+
+// Runs "count" windows each with a single request using the current limit
+static void run_windows(cass::ConcurrencyLimiter* limiter, uint64_t* now,
+                        uint64_t latency_ns, int count) {
+  for (int i = 0; i < count; ++i) {
+    *now += WINDOW_NS;
+    limiter->on_sample(*now, latency_ns, limiter->limit());
+  }
+}
+
+TEST(ConcurrencyLimiterUnitTest, GrowAndShrink) {
+  cass::ConcurrencyLimiter limiter(settings(10, 1, 100));
+  uint64_t now = 0;
+  EXPECT_EQ(10u, limiter.limit());
+
+  // The limit grows while the latency is stable
+  run_windows(&limiter, &now, ONE_MS, 10);
+  unsigned limit = limiter.limit();
+  EXPECT_GT(limit, 10u);
+  run_windows(&limiter, &now, ONE_MS, 100);
+  EXPECT_EQ(100u, limiter.limit()); // Up to the maximum
+
+  // It shrinks when the latency rises
+  limit = limiter.limit();
+  run_windows(&limiter, &now, 10 * ONE_MS, 10);
+  EXPECT_LE(limiter.limit(), limit / 2);
+
+  // A lasting change becomes the new long term latency and the limit grows
+  // again
+  run_windows(&limiter, &now, 10 * ONE_MS, 200);
+  EXPECT_EQ(100u, limiter.limit());
+}
+
+TEST(ConcurrencyLimiterUnitTest, Unused) {
+  cass::ConcurrencyLimiter limiter(settings(10, 1, 100));
+  uint64_t now = 0;
+
+  // The limit doesn't grow when the host isn't using it
+  for (int i = 0; i < 10; ++i) {
+    now += WINDOW_NS;
+    limiter.on_sample(now, ONE_MS, 1);
+  }
+  EXPECT_EQ(10u, limiter.limit());
+}
+
+TEST(ConcurrencyLimiterUnitTest, Drops) {
+  cass::ConcurrencyLimiter limiter(settings(100, 5, 100));
+  uint64_t now = WINDOW_NS;
+
+  // Multiple drops in a window only decrease the limit once
+  limiter.on_drop(now, 100);
+  EXPECT_EQ(90u, limiter.limit());
+  limiter.on_drop(now + 1, 100);
+  EXPECT_EQ(90u, limiter.limit());
+
+  // The limit doesn't go below the minimum
+  for (int i = 0; i < 100; ++i) {
+    now += WINDOW_NS;
+    limiter.on_drop(now, 100);
+  }
+  EXPECT_EQ(5u, limiter.limit());
+}
+
+TEST(ConcurrencyLimiterUnitTest, Options) {
+  CassCluster* cluster = cass_cluster_new();
+
+  EXPECT_EQ(CASS_OK, cass_cluster_set_adaptive_concurrency_limit(cluster, 20, 1, 1000));
+  EXPECT_EQ(CASS_OK, cass_cluster_set_adaptive_concurrency_limit(cluster, 0, 0, 0));
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS,
+            cass_cluster_set_adaptive_concurrency_limit(cluster, 20, 0, 1000));
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS,
+            cass_cluster_set_adaptive_concurrency_limit(cluster, 20, 100, 10));
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS,
+            cass_cluster_set_adaptive_concurrency_limit(cluster, 2000, 1, 1000));
+
+  cass_cluster_free(cluster);
+}
+
+namespace {
+
+// An IO worker's loop that's idle until it's woken
+struct Worker {
+  Worker()
+    : waker(new cass::LoopWaker())
+    , is_woken(false) {
+    uv_loop_init(&loop);
+    waker->init(&loop, this, on_wake);
+    uv_timer_init(&loop, &timeout);
+    timeout.data = this;
+    uv_timer_start(&timeout, on_timeout, 5000, 0);
+  }
+
+  ~Worker() {
+    uv_loop_close(&loop);
+  }
+
+  void close_handles() {
+    waker->close_handles();
+    uv_close(reinterpret_cast<uv_handle_t*>(&timeout), NULL);
+  }
+
+#if UV_VERSION_MAJOR == 0
+  static void on_wake(uv_async_t* async, int status) {
+#else
+  static void on_wake(uv_async_t* async) {
+#endif
+    Worker* worker = static_cast<Worker*>(async->data);
+    worker->is_woken = true;
+    worker->close_handles();
+  }
+
+#if UV_VERSION_MAJOR == 0
+  static void on_timeout(uv_timer_t* timer, int status) {
+#else
+  static void on_timeout(uv_timer_t* timer) {
+#endif
+    static_cast<Worker*>(timer->data)->close_handles();
+  }
+
+  static void run(void* data) {
+    uv_run(&static_cast<Worker*>(data)->loop, UV_RUN_DEFAULT);
+  }
+
+  uv_loop_t loop;
+  uv_timer_t timeout;
+  cass::LoopWaker::Ptr waker;
+  bool is_woken;
+};
+
+} // namespace
+
+TEST(ConcurrencyLimiterUnitTest, WakeWaitingWorkers) {
+  cass::Host::Ptr host(new cass::Host(cass::Address("127.0.0.1", 9042), false));
+  host->enable_concurrency_limiting(settings(2, 1, 100));
+
+  Worker worker1, worker2;
+  EXPECT_FALSE(host->wait_for_concurrency(worker1.waker)); // Not at the limit
+
+  // Both workers have requests waiting for the host
+  host->inc_inflight_requests();
+  host->inc_inflight_requests();
+  EXPECT_TRUE(host->is_at_concurrency_limit());
+  EXPECT_TRUE(host->wait_for_concurrency(worker1.waker));
+  EXPECT_TRUE(host->wait_for_concurrency(worker2.waker));
+
+  uv_thread_t thread1, thread2;
+  ASSERT_EQ(0, uv_thread_create(&thread1, Worker::run, &worker1));
+  ASSERT_EQ(0, uv_thread_create(&thread2, Worker::run, &worker2));
+
+  // A request finishing (e.g. on a third worker) wakes both idle workers
+  host->dec_inflight_requests();
+
+  uv_thread_join(&thread1);
+  uv_thread_join(&thread2);
+  EXPECT_TRUE(worker1.is_woken);
+  EXPECT_TRUE(worker2.is_woken);
+}
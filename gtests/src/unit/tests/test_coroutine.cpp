@@ -0,0 +1,163 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+// Only built when the compiler supports C++20 coroutines (see CassConfigure)
+
+#include <gtest/gtest.h>
+
+#include "cassandra_coroutine.h"
+
+#include "constants.hpp"
+#include "request_handler.hpp"
+#include "result_response.hpp"
+#include "serialization.hpp"
+
+#include <uv.h>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+CassFuture* to_external(const cass::ResponseFuture::Ptr& future) {
+  future->inc_ref(); // Released by the awaitable
+  return CassFuture::to(future.get());
+}
+
+// A rows result without metadata or rows
+cass::Response::Ptr empty_rows() {
+  const size_t size = 4 * sizeof(int32_t);
+  cass::ResultResponse* result = new cass::ResultResponse();
+  cass::Response::Ptr response(result);
+  result->set_buffer(size);
+  char* pos = result->data();
+  cass::encode_int32(pos, CASS_RESULT_KIND_ROWS); pos += sizeof(int32_t);
+  cass::encode_int32(pos, CASS_RESULT_FLAG_NO_METADATA); pos += sizeof(int32_t);
+  cass::encode_int32(pos, 0); pos += sizeof(int32_t); // Column count
+  cass::encode_int32(pos, 0); // Row count
+  EXPECT_TRUE(result->decode(CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION, result->data(), size));
+  return response;
+}
+
+void set_result(const cass::ResponseFuture::Ptr& future) {
+  ASSERT_TRUE(future->set_response(cass::Address("127.0.0.1", 9042), empty_rows()));
+}
+
+// What the coroutine saw after it was resumed
+struct Outcome {
+  Outcome()
+    : is_done(false)
+    , error_code(CASS_OK)
+    , row_count(0) { }
+
+  bool is_done;
+  CassError error_code;
+  std::string error_message;
+  size_t row_count;
+  uv_thread_t thread;
+};
+
+template <class Executor>
+cass::coro::Task await_result(CassFuture* future, Executor executor, Outcome* outcome) {
+  cass::coro::Result result =
+      co_await cass::coro::FutureAwaitable<cass::coro::internal::GetResult, Executor>(future, executor);
+  outcome->thread = uv_thread_self();
+  outcome->error_code = result.error_code();
+  outcome->error_message = result.error_message();
+  if (result.get() != nullptr) {
+    outcome->row_count = cass_result_row_count(result.get());
+  }
+  outcome->is_done = true;
+}
+
+cass::coro::Task await_result(CassFuture* future, Outcome* outcome) {
+  return await_result(future, cass::coro::InlineExecutor(), outcome);
+}
+
+void set_result_on_thread(void* arg) {
+  cass::ResponseFuture* future = static_cast<cass::ResponseFuture*>(arg);
+  uv_sleep(10);
+  future->set_response(cass::Address("127.0.0.1", 9042), empty_rows());
+}
+
+// Queues the coroutine so the test decides where it's resumed
+struct QueueExecutor {
+  std::vector<std::coroutine_handle<> >* handles;
+  void operator()(std::coroutine_handle<> handle) const { handles->push_back(handle); }
+};
+
+} // namespace
+
+TEST(CoroutineUnitTest, ReadyFuture) {
+  cass::ResponseFuture::Ptr future(new cass::ResponseFuture());
+  set_result(future);
+
+  // The coroutine doesn't suspend when the future is already set
+  Outcome outcome;
+  uv_thread_t self = uv_thread_self();
+  await_result(to_external(future), &outcome);
+  ASSERT_TRUE(outcome.is_done);
+  EXPECT_TRUE(uv_thread_equal(&self, &outcome.thread));
+  EXPECT_EQ(CASS_OK, outcome.error_code);
+  EXPECT_EQ(0u, outcome.row_count);
+}
+
+TEST(CoroutineUnitTest, PendingFuture) {
+  cass::ResponseFuture::Ptr future(new cass::ResponseFuture());
+
+  Outcome outcome;
+  await_result(to_external(future), &outcome);
+  EXPECT_FALSE(outcome.is_done);
+
+  // The coroutine is resumed by the thread that sets the future
+  uv_thread_t thread;
+  uv_thread_create(&thread, set_result_on_thread, future.get());
+  uv_thread_join(&thread);
+  ASSERT_TRUE(outcome.is_done);
+  EXPECT_TRUE(uv_thread_equal(&thread, &outcome.thread));
+  EXPECT_EQ(CASS_OK, outcome.error_code);
+}
+
+TEST(CoroutineUnitTest, Error) {
+  cass::ResponseFuture::Ptr future(new cass::ResponseFuture());
+
+  Outcome outcome;
+  await_result(to_external(future), &outcome);
+  EXPECT_FALSE(outcome.is_done);
+
+  future->set_error(CASS_ERROR_LIB_REQUEST_TIMED_OUT, "Request timed out");
+  ASSERT_TRUE(outcome.is_done);
+  EXPECT_EQ(CASS_ERROR_LIB_REQUEST_TIMED_OUT, outcome.error_code);
+  EXPECT_EQ("Request timed out", outcome.error_message);
+  EXPECT_EQ(0u, outcome.row_count);
+}
+
+TEST(CoroutineUnitTest, Executor) {
+  cass::ResponseFuture::Ptr future(new cass::ResponseFuture());
+  std::vector<std::coroutine_handle<> > handles;
+  QueueExecutor executor = { &handles };
+
+  Outcome outcome;
+  await_result(to_external(future), executor, &outcome);
+  set_result(future);
+
+  // Setting the future hands the coroutine to the executor
+  EXPECT_FALSE(outcome.is_done);
+  ASSERT_EQ(1u, handles.size());
+  handles[0].resume();
+  ASSERT_TRUE(outcome.is_done);
+  EXPECT_EQ(CASS_OK, outcome.error_code);
+}
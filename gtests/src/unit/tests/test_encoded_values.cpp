@@ -0,0 +1,230 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "encode.hpp"
+#include "encoded_values.hpp"
+#include "query_request.hpp"
+
+#include <string>
+
+namespace {
+
+std::string to_string(const cass::Buffer& buf) {
+  return std::string(buf.data(), buf.size());
+}
+
+void on_release(void* data) {
+  ++*static_cast<int*>(data);
+}
+
+} // namespace
+
+TEST(EncodedValuesUnitTest, Unset) {
+  cass::EncodedValues values(3);
+  EXPECT_EQ(3u, values.count());
+  EXPECT_EQ(3 * sizeof(int32_t), values.size());
+  for (size_t i = 0; i < values.count(); ++i) {
+    EXPECT_TRUE(values.is_unset(i));
+    EXPECT_FALSE(values.is_null(i));
+  }
+  EXPECT_EQ(to_string(cass::encode_with_length(cass::CassUnset())) +
+            to_string(cass::encode_with_length(cass::CassUnset())) +
+            to_string(cass::encode_with_length(cass::CassUnset())),
+            to_string(values.encode()));
+}
+
+TEST(EncodedValuesUnitTest, SetAndResize) {
+  cass::EncodedValues values(3);
+
+  values.set(1, cass::encode_with_length(static_cast<cass_int32_t>(42)));
+  values.set(2, cass::encode_with_length(cass::CassNull()));
+  EXPECT_FALSE(values.is_unset(1));
+  EXPECT_TRUE(values.is_null(2));
+
+  // Growing the first value moves the values that follow
+  std::string s(100, 'a');
+  values.set_bytes(0, s.data(), s.size());
+  EXPECT_EQ(sizeof(int32_t) + s.size(), values.get_size(0));
+  EXPECT_EQ(to_string(cass::encode_with_length(static_cast<cass_int32_t>(42))),
+            to_string(values.get(1)));
+  EXPECT_TRUE(values.is_null(2));
+
+  // Same size values are overwritten in place
+  size_t size = values.size();
+  values.set(1, cass::encode_with_length(static_cast<cass_int32_t>(43)));
+  EXPECT_EQ(size, values.size());
+
+  // Shrinking
+  values.set_bytes(0, "b", 1);
+
+  cass::CassString str("b", 1);
+  EXPECT_EQ(to_string(cass::encode_with_length(str)) +
+            to_string(cass::encode_with_length(static_cast<cass_int32_t>(43))) +
+            to_string(cass::encode_with_length(cass::CassNull())),
+            to_string(values.encode()));
+
+  values.reset(2);
+  EXPECT_EQ(2u, values.count());
+  EXPECT_TRUE(values.is_unset(0));
+  EXPECT_TRUE(values.is_unset(1));
+}
+
+TEST(EncodedValuesUnitTest, CopyOnWrite) {
+  cass::EncodedValues values(8);
+  for (size_t i = 0; i < values.count(); ++i) {
+    values.set(i, cass::encode_with_length(static_cast<cass_int64_t>(i)));
+  }
+
+  cass::Buffer before(values.encode());
+  std::string expected(to_string(before));
+
+  // Values that are still referenced by an encoded request are not modified
+  values.set(0, cass::encode_with_length(static_cast<cass_int64_t>(100)));
+  values.set_bytes(1, "abc", 3);
+  EXPECT_EQ(expected, to_string(before));
+  EXPECT_NE(expected, to_string(values.encode()));
+}
+
+TEST(EncodedValuesUnitTest, Statement) {
+  CassUuid uuid;
+  ASSERT_EQ(cass_uuid_from_string("d8775a70-6ea4-11e4-9fa7-0db22d2a6140", &uuid), CASS_OK);
+  cass::CassString str("abcdefghijklmnopqrstuvwxyz", 26);
+
+  cass::QueryRequest separate("", 4);
+  cass::QueryRequest contiguous("", 4);
+  contiguous.set_contiguous(true);
+
+  cass::QueryRequest* requests[] = { &separate, &contiguous };
+  for (size_t i = 0; i < 2; ++i) {
+    cass::QueryRequest* request = requests[i];
+    EXPECT_EQ(CASS_OK, request->set(0, uuid));
+    EXPECT_EQ(CASS_OK, request->set(1, str));
+    EXPECT_EQ(CASS_OK, request->set(2, static_cast<cass_int32_t>(1)));
+    EXPECT_EQ(CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS,
+              request->set(4, static_cast<cass_int32_t>(1)));
+    request->add_key_index(0);
+    request->add_key_index(1);
+  }
+
+  EXPECT_TRUE(separate.is_unset(3));
+  EXPECT_TRUE(contiguous.is_unset(3));
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(to_string(separate.get_buffer(i, CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION)),
+              to_string(contiguous.get_buffer(i, CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION)));
+  }
+
+  std::string separate_key, contiguous_key;
+  EXPECT_TRUE(separate.get_routing_key(&separate_key));
+  EXPECT_TRUE(contiguous.get_routing_key(&contiguous_key));
+  EXPECT_EQ(separate_key, contiguous_key);
+
+  // Changing the mode keeps the bound values
+  separate.set_contiguous(true);
+  contiguous.set_contiguous(false);
+  EXPECT_TRUE(separate.is_contiguous());
+  EXPECT_FALSE(contiguous.is_contiguous());
+  EXPECT_TRUE(separate.is_unset(3));
+  EXPECT_TRUE(contiguous.is_unset(3));
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(to_string(separate.get_buffer(i, CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION)),
+              to_string(contiguous.get_buffer(i, CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION)));
+  }
+}
+
+TEST(EncodedValuesUnitTest, Clone) {
+  cass::CassString str("abcdefghijklmnopqrstuvwxyz", 26);
+
+  cass::Statement::Ptr prototype(new cass::QueryRequest("", 2));
+  prototype->set_contiguous(true);
+  prototype->set_consistency(CASS_CONSISTENCY_QUORUM);
+  prototype->set_page_size(100);
+  EXPECT_EQ(CASS_OK, prototype->set(cass::StringRef("a"), str));
+  EXPECT_EQ(CASS_OK, prototype->set(cass::StringRef("b"), static_cast<cass_int32_t>(1)));
+
+  cass::Statement::Ptr clone(prototype->clone());
+  EXPECT_TRUE(clone->is_contiguous());
+  EXPECT_TRUE(clone->has_names_for_values());
+  EXPECT_EQ(CASS_CONSISTENCY_QUORUM, clone->consistency());
+  EXPECT_EQ(100, clone->page_size());
+  for (size_t i = 0; i < 2; ++i) {
+    EXPECT_EQ(to_string(prototype->get_buffer(i, CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION)),
+              to_string(clone->get_buffer(i, CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION)));
+  }
+
+  // Rebinding the prototype doesn't change the clone
+  EXPECT_EQ(CASS_OK, prototype->set(cass::StringRef("b"), static_cast<cass_int32_t>(2)));
+  EXPECT_EQ(to_string(cass::encode_with_length(static_cast<cass_int32_t>(1))),
+            to_string(clone->get_buffer(1, CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION)));
+
+  // The names are kept
+  EXPECT_EQ(CASS_OK, clone->set(cass::StringRef("b"), static_cast<cass_int32_t>(3)));
+  EXPECT_EQ(to_string(cass::encode_with_length(static_cast<cass_int32_t>(3))),
+            to_string(clone->get_buffer(1, CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION)));
+  EXPECT_EQ(to_string(cass::encode_with_length(static_cast<cass_int32_t>(2))),
+            to_string(prototype->get_buffer(1, CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION)));
+}
+
+TEST(EncodedValuesUnitTest, External) {
+  std::string blob(1024, 'x');
+  std::string small("abc");
+  cass::CassBytes bytes(reinterpret_cast<const cass_byte_t*>(blob.data()), blob.size());
+  const int version = CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION;
+
+  for (int contiguous = 0; contiguous < 2; ++contiguous) {
+    int released = 0;
+
+    cass::Statement::Ptr statement(new cass::QueryRequest("", 3));
+    statement->set_contiguous(contiguous != 0);
+    EXPECT_EQ(CASS_OK, cass_statement_bind_bytes_external(CassStatement::to(statement.get()), 0,
+                                                          bytes.data, bytes.size,
+                                                          on_release, &released));
+    EXPECT_EQ(CASS_OK, cass_statement_bind_int32(CassStatement::to(statement.get()), 1, 42));
+
+    // Small values are copied and released immediately
+    EXPECT_EQ(CASS_OK, cass_statement_bind_string_external(CassStatement::to(statement.get()), 2,
+                                                           small.data(), small.size(),
+                                                           on_release, &released));
+    EXPECT_EQ(1, released);
+
+    // Errors also release the memory
+    EXPECT_EQ(CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS,
+              cass_statement_bind_string_external(CassStatement::to(statement.get()), 3,
+                                                  blob.data(), blob.size(),
+                                                  on_release, &released));
+    EXPECT_EQ(2, released);
+
+    EXPECT_EQ(to_string(cass::encode_with_length(bytes)),
+              to_string(statement->get_buffer(0, version)));
+    EXPECT_EQ(sizeof(int32_t) + blob.size(), statement->get_size(0, version));
+
+    // The external memory is written as-is
+    cass::BufferVec bufs;
+    EXPECT_EQ(sizeof(int32_t) + blob.size(), statement->get_buffers(0, version, &bufs));
+    ASSERT_EQ(2u, bufs.size());
+    EXPECT_EQ(blob.data(), bufs[1].data());
+
+    // Clones and pending buffers keep the memory referenced
+    cass::Statement::Ptr clone(statement->clone());
+    statement.reset();
+    EXPECT_EQ(2, released);
+    clone.reset();
+    EXPECT_EQ(2, released);
+    bufs.clear();
+    EXPECT_EQ(3, released);
+  }
+}
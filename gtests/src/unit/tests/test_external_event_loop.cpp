@@ -0,0 +1,97 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "cassandra.h"
+
+#include <uv.h>
+
+// Nothing is expected to be listening on this port
+#define UNUSED_PORT 9999
+
+static void connect_unavailable(CassCluster* cluster, CassSession* session,
+                                uv_loop_t* loop) {
+  CassFuture* future = cass_session_connect(session, cluster);
+
+  // The connection attempt is only processed when the loop is run
+  int iterations = 0;
+  while (!cass_future_ready(future) && iterations++ < 10000) {
+    if (loop != NULL) {
+      uv_run(loop, UV_RUN_ONCE);
+    } else {
+      ASSERT_EQ(CASS_OK, cass_session_event_loop_run(session, cass_true));
+    }
+  }
+
+  ASSERT_TRUE(cass_future_ready(future));
+  EXPECT_EQ(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE, cass_future_error_code(future));
+  cass_future_free(future);
+}
+
+TEST(ExternalEventLoopUnitTest, NotEnabled) {
+  CassSession* session = cass_session_new();
+  EXPECT_EQ(-1, cass_session_event_loop_fd(session));
+  EXPECT_EQ(-1, cass_session_event_loop_timeout(session));
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS,
+            cass_session_event_loop_run(session, cass_false));
+  cass_session_free(session);
+
+  CassCluster* cluster = cass_cluster_new();
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS, cass_cluster_set_event_loop(cluster, NULL));
+  cass_cluster_free(cluster);
+}
+
+TEST(ExternalEventLoopUnitTest, DrivenByApplication) {
+  CassCluster* cluster = cass_cluster_new();
+  cass_cluster_set_contact_points(cluster, "127.0.0.1");
+  cass_cluster_set_port(cluster, UNUSED_PORT);
+  cass_cluster_set_num_threads_io(cluster, 4); // Ignored
+  ASSERT_EQ(CASS_OK, cass_cluster_set_external_event_loop(cluster, cass_true));
+
+  CassSession* session = cass_session_new();
+  connect_unavailable(cluster, session, NULL);
+
+#if !defined(_WIN32)
+  EXPECT_GE(cass_session_event_loop_fd(session), 0);
+#endif
+
+  // Reconnecting reuses the session's loop
+  connect_unavailable(cluster, session, NULL);
+
+  cass_session_free(session);
+  cass_cluster_free(cluster);
+}
+
+TEST(ExternalEventLoopUnitTest, AttachedToApplicationLoop) {
+  uv_loop_t loop;
+  ASSERT_EQ(0, uv_loop_init(&loop));
+
+  CassCluster* cluster = cass_cluster_new();
+  cass_cluster_set_contact_points(cluster, "127.0.0.1");
+  cass_cluster_set_port(cluster, UNUSED_PORT);
+  ASSERT_EQ(CASS_OK, cass_cluster_set_event_loop(cluster, &loop));
+
+  CassSession* session = cass_session_new();
+  connect_unavailable(cluster, session, &loop);
+
+  cass_session_free(session);
+  cass_cluster_free(cluster);
+
+  // All of the session's handles have been closed
+  EXPECT_EQ(0, uv_run(&loop, UV_RUN_NOWAIT));
+  EXPECT_EQ(0, uv_loop_close(&loop));
+}
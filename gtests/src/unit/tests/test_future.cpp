@@ -0,0 +1,127 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "future.hpp"
+
+#include <uv.h>
+
+static CassFuture* new_future() {
+  cass::Future* future = new cass::Future(cass::CASS_FUTURE_TYPE_SESSION);
+  future->inc_ref();
+  return CassFuture::to(future);
+}
+
+struct DelayedSet {
+  CassFuture* future;
+  uint64_t delay_ms;
+};
+
+static void set_after_delay(void* arg) {
+  DelayedSet* delayed = static_cast<DelayedSet*>(arg);
+  uv_sleep(delayed->delay_ms);
+  delayed->future->set();
+}
+
+TEST(FutureUnitTest, WaitTimed) {
+  CassFuture* future = new_future();
+  EXPECT_FALSE(cass_future_ready(future));
+  EXPECT_FALSE(cass_future_wait_timed(future, 0));
+  EXPECT_FALSE(cass_future_wait_timed(future, 1000));
+
+  DelayedSet delayed = { future, 10 };
+  uv_thread_t thread;
+  uv_thread_create(&thread, set_after_delay, &delayed);
+  EXPECT_TRUE(cass_future_wait_timed(future, 10 * 1000 * 1000));
+  EXPECT_TRUE(cass_future_ready(future));
+  uv_thread_join(&thread);
+
+  // Waiting on a set future returns immediately
+  cass_future_wait(future);
+  EXPECT_TRUE(cass_future_wait_timed(future, 0));
+  cass_future_free(future);
+}
+
+TEST(FutureUnitTest, WaitAny) {
+  CassFuture* futures[3] = { new_future(), new_future(), new_future() };
+  size_t index = 0;
+
+  EXPECT_FALSE(cass_future_wait_any_timed(futures, 3, 0, &index));
+  EXPECT_FALSE(cass_future_wait_any_timed(futures, 3, 1000, &index));
+
+  DelayedSet delayed = { futures[2], 10 };
+  uv_thread_t thread;
+  uv_thread_create(&thread, set_after_delay, &delayed);
+  EXPECT_EQ(2u, cass_future_wait_any(futures, 3));
+  uv_thread_join(&thread);
+
+  futures[1]->set();
+  EXPECT_TRUE(cass_future_wait_any_timed(futures, 2, 0, &index));
+  EXPECT_EQ(1u, index);
+
+  EXPECT_EQ(0u, cass_future_wait_any(futures, 0));
+
+  // The first future can still be waited on by itself
+  EXPECT_FALSE(cass_future_wait_timed(futures[0], 1000));
+  futures[0]->set();
+  cass_future_wait(futures[0]);
+
+  for (int i = 0; i < 3; ++i) {
+    cass_future_free(futures[i]);
+  }
+}
+
+TEST(FutureUnitTest, WaitAll) {
+  CassFuture* futures[2] = { new_future(), new_future() };
+
+  futures[0]->set();
+  EXPECT_FALSE(cass_future_wait_all_timed(futures, 2, 1000));
+
+  DelayedSet delayed = { futures[1], 10 };
+  uv_thread_t thread;
+  uv_thread_create(&thread, set_after_delay, &delayed);
+  cass_future_wait_all(futures, 2);
+  EXPECT_TRUE(cass_future_ready(futures[1]));
+  uv_thread_join(&thread);
+
+  EXPECT_TRUE(cass_future_wait_all_timed(futures, 2, 0));
+
+  for (int i = 0; i < 2; ++i) {
+    cass_future_free(futures[i]);
+  }
+}
+
+static void wait_for_future(void* arg) {
+  cass_future_wait(static_cast<CassFuture*>(arg));
+}
+
+TEST(FutureUnitTest, ManyWaiters) {
+  CassFuture* future = new_future();
+
+  uv_thread_t threads[4];
+  for (int i = 0; i < 4; ++i) {
+    uv_thread_create(&threads[i], wait_for_future, future);
+  }
+  uv_sleep(10);
+  future->set();
+
+  // All of the waiting threads are woken up
+  for (int i = 0; i < 4; ++i) {
+    uv_thread_join(&threads[i]);
+  }
+  cass_future_free(future);
+}
@@ -0,0 +1,121 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "host.hpp"
+#include "latency_aware_policy.hpp"
+#include "round_robin_policy.hpp"
+
+#include <uv.h>
+
+static const uint64_t ONE_MS = 1000LL * 1000LL; // 1 ms in ns
+
+static void record_latencies(void* data) {
+  cass::Host* host = static_cast<cass::Host*>(data);
+  for (int i = 0; i < 10000; ++i) {
+    host->update_latency(ONE_MS);
+  }
+}
+
+TEST(LatencyTrackerUnitTest, ConcurrentUpdates)
+{
+  const int num_threads = 4;
+  cass::Host host(cass::Address("127.0.0.1", 9042), false);
+  host.enable_latency_tracking(100LL * ONE_MS, 0);
+
+  uv_thread_t threads[num_threads];
+  for (int i = 0; i < num_threads; ++i) {
+    uv_thread_create(&threads[i], record_latencies, &host);
+  }
+  for (int i = 0; i < num_threads; ++i) {
+    uv_thread_join(&threads[i]);
+  }
+
+  // Latencies that weren't merged by the recording threads are merged by
+  // the next update
+  uv_sleep(1);
+  host.update_latency(ONE_MS);
+
+  cass::TimestampedAverage current = host.get_current_average();
+  EXPECT_EQ(static_cast<uint64_t>(num_threads * 10000 + 1), current.num_measured);
+  EXPECT_EQ(static_cast<int64_t>(ONE_MS), current.average);
+  EXPECT_EQ(-1, current.tail); // Not tracked
+}
+
+TEST(LatencyTrackerUnitTest, Tail)
+{
+  cass::Host host(cass::Address("127.0.0.1", 9042), false);
+  host.enable_latency_tracking(100LL * ONE_MS, 0, 99.0);
+
+  // Latencies from 1 us to 1 ms
+  for (int i = 0; i < 100000; ++i) {
+    host.update_latency((i * 7919 % 1000 + 1) * 1000LL);
+  }
+
+  cass::TimestampedAverage current = host.get_current_average();
+  EXPECT_NEAR(990.0 * 1000.0, static_cast<double>(current.tail), 50.0 * 1000.0);
+}
+
+TEST(LatencyTrackerUnitTest, Score)
+{
+  cass::LatencyAwarePolicy::Settings settings;
+  settings.min_measured = 0;
+
+  cass::Host::Ptr host(new cass::Host(cass::Address("127.0.0.1", 9042), false));
+  host->enable_latency_tracking(settings.scale_ns, settings.min_measured, 99.0);
+
+  {
+    cass::LatencyAwarePolicy policy(new cass::RoundRobinPolicy(), settings);
+    EXPECT_EQ(-1, policy.score(host, uv_hrtime())); // No measurements
+  }
+
+  for (int i = 0; i < 1000; ++i) {
+    host->update_latency((i % 10 == 0 ? 10 : 1) * ONE_MS);
+  }
+  cass::TimestampedAverage current = host->get_current_average();
+  ASSERT_GT(current.tail, current.average);
+
+  host->inc_inflight_requests();
+  host->inc_inflight_requests();
+  EXPECT_EQ(2, host->inflight_requests());
+
+  { // The average latency by default
+    cass::LatencyAwarePolicy policy(new cass::RoundRobinPolicy(), settings);
+    EXPECT_EQ(current.average, policy.score(host, current.timestamp));
+  }
+
+  settings.tail_percentile = 99.0;
+  {
+    cass::LatencyAwarePolicy policy(new cass::RoundRobinPolicy(), settings);
+    EXPECT_EQ(current.tail, policy.score(host, current.timestamp));
+  }
+
+  settings.weight_inflight = true;
+  {
+    cass::LatencyAwarePolicy policy(new cass::RoundRobinPolicy(), settings);
+    EXPECT_EQ(3 * current.tail, policy.score(host, current.timestamp));
+  }
+
+  // Stale measurements aren't scored
+  {
+    cass::LatencyAwarePolicy policy(new cass::RoundRobinPolicy(), settings);
+    EXPECT_EQ(-1, policy.score(host, current.timestamp + settings.retry_period_ns + 1));
+  }
+
+  host->dec_inflight_requests(2);
+  EXPECT_EQ(0, host->inflight_requests());
+}
@@ -0,0 +1,115 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "dense_hash_map.hpp"
+#include "memory.hpp"
+#include "ref_counted.hpp"
+
+#include <stdlib.h>
+
+namespace {
+
+int malloc_count = 0;
+int realloc_count = 0;
+int free_count = 0;
+
+void* counting_malloc(size_t size) {
+  ++malloc_count;
+  return malloc(size);
+}
+
+void* counting_realloc(void* ptr, size_t size) {
+  ++realloc_count;
+  return realloc(ptr, size);
+}
+
+void counting_free(void* ptr) {
+  ++free_count;
+  free(ptr);
+}
+
+} // namespace
+
+TEST(MemoryUntrackedUnitTest, DefaultAllocator) {
+  // The default allocator's blocks have no header and aren't counted
+  void* ptr = cass::Memory::malloc(100);
+  ASSERT_TRUE(ptr != NULL);
+  EXPECT_EQ(0, cass_alloc_get_allocated_bytes());
+  ptr = cass::Memory::realloc(ptr, 300);
+  ASSERT_TRUE(ptr != NULL);
+  EXPECT_EQ(0, cass_alloc_get_allocated_bytes());
+  free(ptr);
+}
+
+class MemoryUnitTest : public testing::Test {
+public:
+  virtual void SetUp() {
+    malloc_count = realloc_count = free_count = 0;
+    cass_alloc_set_functions(counting_malloc, counting_realloc, counting_free);
+  }
+
+  virtual void TearDown() {
+    cass_alloc_set_functions(NULL, NULL, NULL);
+  }
+};
+
+TEST_F(MemoryUnitTest, AllocatedBytes) {
+  int64_t allocated = cass_alloc_get_allocated_bytes();
+
+  void* ptr = cass::Memory::malloc(100);
+  ASSERT_TRUE(ptr != NULL);
+  EXPECT_EQ(allocated + 100, cass_alloc_get_allocated_bytes());
+
+  ptr = cass::Memory::realloc(ptr, 300);
+  ASSERT_TRUE(ptr != NULL);
+  EXPECT_EQ(allocated + 300, cass_alloc_get_allocated_bytes());
+
+  cass::Memory::free(ptr);
+  EXPECT_EQ(allocated, cass_alloc_get_allocated_bytes());
+
+  EXPECT_EQ(1, malloc_count);
+  EXPECT_EQ(1, realloc_count);
+  EXPECT_EQ(1, free_count);
+}
+
+TEST_F(MemoryUnitTest, RefBuffer) {
+  int64_t allocated = cass_alloc_get_allocated_bytes();
+  {
+    cass::RefBuffer::Ptr buffer(cass::RefBuffer::create(1024));
+    EXPECT_EQ(1, malloc_count);
+    EXPECT_GE(cass_alloc_get_allocated_bytes(), allocated + 1024);
+  }
+  EXPECT_EQ(1, free_count);
+  EXPECT_EQ(allocated, cass_alloc_get_allocated_bytes());
+}
+
+TEST_F(MemoryUnitTest, DenseHashMap) {
+  int64_t allocated = cass_alloc_get_allocated_bytes();
+  {
+    cass::DenseHashMap<int, int> map;
+    map.set_empty_key(-1);
+    for (int i = 0; i < 1000; ++i) {
+      map[i] = i;
+    }
+    EXPECT_GT(malloc_count, 0);
+    EXPECT_GE(cass_alloc_get_allocated_bytes(),
+              allocated + static_cast<int64_t>(1000 * sizeof(std::pair<const int, int>)));
+  }
+  EXPECT_EQ(malloc_count, free_count);
+  EXPECT_EQ(allocated, cass_alloc_get_allocated_bytes());
+}
@@ -215,3 +215,27 @@ TEST(MetricsUnitTest, MeterWithThreads) {
   EXPECT_NEAR(meter.five_minute_rate(), expected, abs_error);
   EXPECT_NEAR(meter.fifteen_minute_rate(), expected, abs_error);
 }
+
+TEST(MetricsUnitTest, RequestLatenciesByPriority) {
+  cass::Metrics metrics(1);
+
+  metrics.record_request(100 * 1000, CASS_REQUEST_PRIORITY_INTERACTIVE);
+  metrics.record_request(200 * 1000);
+  metrics.record_request(300 * 1000, CASS_REQUEST_PRIORITY_BACKGROUND);
+
+  cass::Metrics::Histogram::Snapshot snapshot;
+
+  metrics.request_latencies_by_priority(CASS_REQUEST_PRIORITY_INTERACTIVE).get_snapshot(&snapshot);
+  EXPECT_EQ(100, snapshot.max);
+
+  metrics.request_latencies_by_priority(CASS_REQUEST_PRIORITY_NORMAL).get_snapshot(&snapshot);
+  EXPECT_EQ(200, snapshot.max);
+
+  metrics.request_latencies_by_priority(CASS_REQUEST_PRIORITY_BACKGROUND).get_snapshot(&snapshot);
+  EXPECT_EQ(300, snapshot.max);
+
+  // All priorities are included in the overall request latencies
+  metrics.request_latencies.get_snapshot(&snapshot);
+  EXPECT_EQ(100, snapshot.min);
+  EXPECT_EQ(300, snapshot.max);
+}
@@ -0,0 +1,131 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "cassandra.h"
+#include "object_pool.hpp"
+
+#include <uv.h>
+
+struct Small : public cass::Pooled {
+  char data[40];
+};
+
+// A size that isn't used by the driver's objects
+struct Medium : public cass::Pooled {
+  char data[1000];
+};
+
+struct Large : public cass::Pooled {
+  char data[4096];
+};
+
+TEST(ObjectPoolUnitTest, Reuse) {
+  Small* small = new Small();
+  size_t cached = cass::ObjectPool::cached_count();
+  delete small;
+  EXPECT_EQ(cached + 1, cass::ObjectPool::cached_count());
+
+  // The freed block is reused for objects of the same size
+  Small* reused = new Small();
+  EXPECT_EQ(small, reused);
+  EXPECT_EQ(cached, cass::ObjectPool::cached_count());
+  delete reused;
+
+  // Large objects aren't cached
+  cached = cass::ObjectPool::cached_count();
+  delete new Large();
+  EXPECT_EQ(cached, cass::ObjectPool::cached_count());
+}
+
+struct Objects {
+  Medium* objects[64];
+  size_t cached_count;
+};
+
+static void free_objects(void* arg) {
+  Objects* objects = static_cast<Objects*>(arg);
+  for (int i = 0; i < 64; ++i) {
+    delete objects->objects[i];
+  }
+  objects->cached_count = cass::ObjectPool::cached_count();
+}
+
+static void allocate_and_exit(void* arg) {
+  Objects* objects = static_cast<Objects*>(arg);
+  for (int i = 0; i < 64; ++i) {
+    objects->objects[i] = new Medium();
+  }
+}
+
+TEST(ObjectPoolUnitTest, FreedByOtherThread) {
+  Objects objects;
+  for (int i = 0; i < 64; ++i) {
+    objects.objects[i] = new Medium();
+  }
+
+  uv_thread_t thread;
+  uv_thread_create(&thread, free_objects, &objects);
+  uv_thread_join(&thread);
+
+  // The blocks are returned to the thread that allocated them
+  EXPECT_EQ(0u, objects.cached_count);
+  size_t cached = cass::ObjectPool::cached_count();
+  Medium* medium = new Medium();
+  EXPECT_EQ(cached + 63, cass::ObjectPool::cached_count());
+  delete medium;
+}
+
+TEST(ObjectPoolUnitTest, FreedAfterThreadExits) {
+  Objects objects;
+  uv_thread_t thread;
+  uv_thread_create(&thread, allocate_and_exit, &objects);
+  uv_thread_join(&thread);
+
+  // The exited thread's blocks are freed instead of being cached
+  size_t cached = cass::ObjectPool::cached_count();
+  for (int i = 0; i < 64; ++i) {
+    delete objects.objects[i];
+  }
+  EXPECT_EQ(cached, cass::ObjectPool::cached_count());
+}
+
+TEST(ObjectPoolUnitTest, Metrics) {
+  // Make sure a block of this size is cached by this thread
+  delete new Small();
+
+  CassObjectPoolMetrics before;
+  cass_alloc_get_object_pool_metrics(&before);
+  delete new Small();
+
+  CassObjectPoolMetrics after;
+  cass_alloc_get_object_pool_metrics(&after);
+  EXPECT_EQ(before.hits + 1, after.hits);
+  EXPECT_EQ(before.misses, after.misses);
+
+  // The counts of threads that have exited are kept
+  Objects objects;
+  uv_thread_t thread;
+  uv_thread_create(&thread, allocate_and_exit, &objects);
+  uv_thread_join(&thread);
+  for (int i = 0; i < 64; ++i) {
+    delete objects.objects[i];
+  }
+
+  cass_alloc_get_object_pool_metrics(&before);
+  EXPECT_GE(before.misses, after.misses + 64);
+}
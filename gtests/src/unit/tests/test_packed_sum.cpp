@@ -0,0 +1,58 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#include <gtest/gtest.h>
+
+#include "packed_sum.hpp"
+
+TEST(PackedSumUnitTest, AddAndTake) {
+  cass::PackedSum packed;
+  EXPECT_TRUE(packed.add(10));
+  EXPECT_TRUE(packed.add(32));
+
+  uint64_t count, sum;
+  packed.take(&count, &sum);
+  EXPECT_EQ(2u, count);
+  EXPECT_EQ(42u, sum);
+
+  packed.take(&count, &sum);
+  EXPECT_EQ(0u, count);
+  EXPECT_EQ(0u, sum);
+}
+
+TEST(PackedSumUnitTest, Overflow) {
+  cass::PackedSum packed;
+  const uint64_t max_sum = (static_cast<uint64_t>(1) << 44) - 1;
+
+  // Values that would overflow the sum are dropped
+  EXPECT_TRUE(packed.add(max_sum - 1));
+  EXPECT_FALSE(packed.add(2));
+  EXPECT_TRUE(packed.add(1));
+
+  uint64_t count, sum;
+  packed.take(&count, &sum);
+  EXPECT_EQ(2u, count);
+  EXPECT_EQ(max_sum, sum);
+
+  // So are values past the maximum count
+  for (uint64_t i = 0; i < (1 << 20) - 1; ++i) {
+    ASSERT_TRUE(packed.add(0));
+  }
+  EXPECT_FALSE(packed.add(0));
+  packed.take(&count, &sum);
+  EXPECT_EQ(static_cast<uint64_t>((1 << 20) - 1), count);
+}
@@ -0,0 +1,240 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#include <gtest/gtest.h>
+
+#include "constants.hpp"
+#include "pager.hpp"
+#include "query_request.hpp"
+#include "request_handler.hpp"
+#include "result_response.hpp"
+#include "serialization.hpp"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+// Records the requests instead of sending them
+class TestPager : public cass::Pager {
+public:
+  TestPager(const cass::Statement* statement)
+    : cass::Pager(NULL, statement) { }
+
+  std::vector<cass::ResponseFuture::Ptr> futures;
+  std::vector<std::string> paging_states;
+
+protected:
+  virtual cass::Future::Ptr execute(const cass::Statement::Ptr& statement) {
+    cass::ResponseFuture::Ptr future(new cass::ResponseFuture());
+    futures.push_back(future);
+    paging_states.push_back(statement->paging_state());
+    return future;
+  }
+};
+
+// A rows result without metadata or rows. The paging state is only added
+// if it's not empty.
+cass::Response::Ptr page(const std::string& paging_state) {
+  int32_t flags = CASS_RESULT_FLAG_NO_METADATA;
+  size_t size = 4 * sizeof(int32_t);
+  if (!paging_state.empty()) {
+    flags |= CASS_RESULT_FLAG_HAS_MORE_PAGES;
+    size += sizeof(int32_t) + paging_state.size();
+  }
+
+  cass::ResultResponse* result = new cass::ResultResponse();
+  cass::Response::Ptr response(result);
+  result->set_buffer(size);
+  char* pos = result->data();
+  cass::encode_int32(pos, CASS_RESULT_KIND_ROWS); pos += sizeof(int32_t);
+  cass::encode_int32(pos, flags); pos += sizeof(int32_t);
+  cass::encode_int32(pos, 0); pos += sizeof(int32_t);
+  if (!paging_state.empty()) {
+    cass::encode_int32(pos, paging_state.size()); pos += sizeof(int32_t);
+    memcpy(pos, paging_state.data(), paging_state.size()); pos += paging_state.size();
+  }
+  cass::encode_int32(pos, 0);
+  EXPECT_TRUE(result->decode(CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION, result->data(), size));
+  return response;
+}
+
+void complete(const cass::ResponseFuture::Ptr& future, const cass::Response::Ptr& response) {
+  ASSERT_TRUE(future->set_response(cass::Address("127.0.0.1", 9042), response));
+}
+
+} // namespace
+
+TEST(PagerUnitTest, Prefetch) {
+  cass::QueryRequest statement("SELECT * FROM table", 0);
+  cass::SharedRefPtr<TestPager> pager(new TestPager(&statement));
+
+  // Nothing is sent until the first page is requested
+  EXPECT_TRUE(pager->has_more_pages());
+  EXPECT_EQ(0u, pager->futures.size());
+
+  cass::Future::Ptr first(pager->next_page());
+  ASSERT_EQ(1u, pager->futures.size());
+  EXPECT_EQ("", pager->paging_states[0]);
+
+  // The next page is requested as soon as the previous page arrives
+  complete(pager->futures[0], page("a"));
+  EXPECT_TRUE(first->ready());
+  ASSERT_EQ(2u, pager->futures.size());
+  EXPECT_EQ("a", pager->paging_states[1]);
+
+  // The prefetched page is buffered until it's taken
+  complete(pager->futures[1], page("b"));
+  EXPECT_EQ(2u, pager->futures.size());
+  EXPECT_GT(pager->buffered_bytes(), 0u);
+
+  cass::Future::Ptr second(pager->next_page());
+  EXPECT_TRUE(second->ready());
+  EXPECT_EQ(0u, pager->buffered_bytes());
+  ASSERT_EQ(3u, pager->futures.size());
+  EXPECT_EQ("b", pager->paging_states[2]);
+
+  // The last page
+  complete(pager->futures[2], page(""));
+  EXPECT_TRUE(pager->has_more_pages());
+  cass::Future::Ptr third(pager->next_page());
+  EXPECT_TRUE(third->ready());
+  EXPECT_EQ(NULL, third->error());
+  EXPECT_FALSE(pager->has_more_pages());
+  EXPECT_EQ(3u, pager->futures.size());
+
+  cass::Future::Ptr none(pager->next_page());
+  ASSERT_TRUE(none->ready());
+  ASSERT_TRUE(none->error() != NULL);
+  EXPECT_EQ(CASS_ERROR_LIB_NO_PAGING_STATE, none->error()->code);
+}
+
+TEST(PagerUnitTest, MaxBufferedBytes) {
+  cass::QueryRequest statement("SELECT * FROM table", 0);
+  cass::SharedRefPtr<TestPager> pager(new TestPager(&statement));
+  pager->set_prefetch_depth(3);
+  pager->set_max_buffered_bytes(1);
+
+  cass::Future::Ptr first(pager->next_page());
+  complete(pager->futures[0], page("a"));
+  ASSERT_EQ(2u, pager->futures.size());
+
+  // The memory cap stops prefetching before the depth is reached
+  complete(pager->futures[1], page("b"));
+  EXPECT_EQ(2u, pager->futures.size());
+
+  cass::Future::Ptr second(pager->next_page());
+  EXPECT_EQ(3u, pager->futures.size());
+}
+
+TEST(PagerUnitTest, Error) {
+  cass::QueryRequest statement("SELECT * FROM table", 0);
+  cass::SharedRefPtr<TestPager> pager(new TestPager(&statement));
+
+  cass::Future::Ptr first(pager->next_page());
+  ASSERT_TRUE(pager->futures[0]->set_error(CASS_ERROR_LIB_REQUEST_TIMED_OUT, "Timed out"));
+  ASSERT_TRUE(first->ready());
+  ASSERT_TRUE(first->error() != NULL);
+  EXPECT_EQ(CASS_ERROR_LIB_REQUEST_TIMED_OUT, first->error()->code);
+
+  // Paging stops after an error
+  EXPECT_FALSE(pager->has_more_pages());
+  EXPECT_EQ(1u, pager->futures.size());
+}
+
+TEST(PagerUnitTest, Close) {
+  cass::QueryRequest statement("SELECT * FROM table", 0);
+  cass::SharedRefPtr<TestPager> pager(new TestPager(&statement));
+
+  cass::Future::Ptr first(pager->next_page());
+  pager->close();
+  complete(pager->futures[0], page("a"));
+
+  // The page in flight is still set but nothing else is requested
+  EXPECT_TRUE(first->ready());
+  EXPECT_EQ(1u, pager->futures.size());
+  EXPECT_FALSE(pager->has_more_pages());
+}
+
+TEST(PagerUnitTest, NoPrefetch) {
+  cass::QueryRequest statement("SELECT * FROM table", 0);
+  cass::SharedRefPtr<TestPager> pager(new TestPager(&statement));
+  pager->set_prefetch_depth(0);
+
+  // Pages are only requested when the application asks for them
+  cass::Future::Ptr first(pager->next_page());
+  ASSERT_EQ(1u, pager->futures.size());
+  complete(pager->futures[0], page("a"));
+  EXPECT_TRUE(first->ready());
+  EXPECT_EQ(1u, pager->futures.size());
+
+  cass::Future::Ptr second(pager->next_page());
+  ASSERT_EQ(2u, pager->futures.size());
+  EXPECT_EQ("a", pager->paging_states[1]);
+  complete(pager->futures[1], page("b"));
+  EXPECT_TRUE(second->ready());
+  EXPECT_EQ(2u, pager->futures.size());
+  EXPECT_EQ(0u, pager->buffered_bytes());
+}
+
+TEST(PagerUnitTest, PrefetchDepth) {
+  cass::QueryRequest statement("SELECT * FROM table", 0);
+  cass::SharedRefPtr<TestPager> pager(new TestPager(&statement));
+  pager->set_prefetch_depth(2);
+  pager->set_max_buffered_bytes(0); // No cap
+
+  cass::Future::Ptr first(pager->next_page());
+  complete(pager->futures[0], page("a"));
+  complete(pager->futures[1], page("b"));
+  ASSERT_EQ(3u, pager->futures.size());
+  EXPECT_EQ("b", pager->paging_states[2]);
+
+  // Two pages are waiting to be taken
+  complete(pager->futures[2], page("c"));
+  EXPECT_EQ(3u, pager->futures.size());
+
+  cass::Future::Ptr second(pager->next_page());
+  EXPECT_TRUE(second->ready());
+  ASSERT_EQ(4u, pager->futures.size());
+  EXPECT_EQ("c", pager->paging_states[3]);
+}
+
+TEST(PagerUnitTest, WaitForPagesInOrder) {
+  cass::QueryRequest statement("SELECT * FROM table", 0);
+  cass::SharedRefPtr<TestPager> pager(new TestPager(&statement));
+  pager->set_prefetch_depth(0);
+
+  // The application can ask for pages before the previous ones arrive
+  cass::Future::Ptr first(pager->next_page());
+  cass::Future::Ptr second(pager->next_page());
+  cass::Future::Ptr third(pager->next_page());
+  ASSERT_EQ(1u, pager->futures.size());
+
+  complete(pager->futures[0], page("a"));
+  EXPECT_TRUE(first->ready());
+  EXPECT_FALSE(second->ready());
+  ASSERT_EQ(2u, pager->futures.size());
+
+  // The futures after the last page are failed
+  complete(pager->futures[1], page(""));
+  EXPECT_TRUE(second->ready());
+  EXPECT_EQ(NULL, second->error());
+  ASSERT_TRUE(third->ready());
+  ASSERT_TRUE(third->error() != NULL);
+  EXPECT_EQ(CASS_ERROR_LIB_NO_PAGING_STATE, third->error()->code);
+  EXPECT_EQ(2u, pager->futures.size());
+}
@@ -0,0 +1,147 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#include <gtest/gtest.h>
+
+#include "cassandra.h"
+#include "rate_limiter.hpp"
+
+#include <uv.h>
+
+#define NS_PER_SECOND (1000LL * 1000LL * 1000LL)
+
+static cass::RateLimiter::Settings settings(double requests_per_second, unsigned burst) {
+  cass::RateLimiter::Settings settings;
+  settings.requests_per_second = requests_per_second;
+  settings.burst = burst;
+  return settings;
+}
+
+TEST(RateLimiterUnitTest, Burst) {
+  cass::RateLimiter rate_limiter(settings(10.0, 5));
+  uint64_t now = 100 * NS_PER_SECOND;
+
+  // The burst is available right away
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_TRUE(rate_limiter.try_acquire(now));
+  }
+  EXPECT_FALSE(rate_limiter.try_acquire(now));
+
+  // A token is added every 100 ms
+  EXPECT_FALSE(rate_limiter.try_acquire(now + NS_PER_SECOND / 20));
+  EXPECT_TRUE(rate_limiter.try_acquire(now + NS_PER_SECOND / 10));
+  EXPECT_FALSE(rate_limiter.try_acquire(now + NS_PER_SECOND / 10));
+
+  // Tokens don't accumulate past the burst
+  now += 10 * NS_PER_SECOND;
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_TRUE(rate_limiter.try_acquire(now));
+  }
+  EXPECT_FALSE(rate_limiter.try_acquire(now));
+}
+
+TEST(RateLimiterUnitTest, Wait) {
+  cass::RateLimiter rate_limiter(settings(10.0, 1));
+  uint64_t now = 100 * NS_PER_SECOND;
+  uint64_t wait_ns;
+
+  EXPECT_TRUE(rate_limiter.acquire(now, 0, &wait_ns));
+  EXPECT_EQ(0u, wait_ns);
+
+  // Waiting requests are spaced out by the rate
+  EXPECT_TRUE(rate_limiter.acquire(now, NS_PER_SECOND, &wait_ns));
+  EXPECT_EQ(static_cast<uint64_t>(NS_PER_SECOND / 10), wait_ns);
+  EXPECT_TRUE(rate_limiter.acquire(now, NS_PER_SECOND, &wait_ns));
+  EXPECT_EQ(static_cast<uint64_t>(2 * NS_PER_SECOND / 10), wait_ns);
+
+  // A request that would wait too long doesn't take a token
+  EXPECT_FALSE(rate_limiter.acquire(now, NS_PER_SECOND / 10, &wait_ns));
+  EXPECT_TRUE(rate_limiter.acquire(now, NS_PER_SECOND, &wait_ns));
+  EXPECT_EQ(static_cast<uint64_t>(3 * NS_PER_SECOND / 10), wait_ns);
+}
+
+#define NUM_THREADS 4
+#define NUM_ITERATIONS 1000
+
+struct AcquireThreadArgs {
+  uv_thread_t thread;
+  cass::RateLimiter* rate_limiter;
+  int acquired;
+};
+
+static void acquire_thread(void* data) {
+  AcquireThreadArgs* args = static_cast<AcquireThreadArgs*>(data);
+  for (int i = 0; i < NUM_ITERATIONS; ++i) {
+    if (args->rate_limiter->try_acquire(100 * NS_PER_SECOND)) {
+      args->acquired++;
+    }
+  }
+}
+
+TEST(RateLimiterUnitTest, VeryLowRate) {
+  // The interval doesn't fit in 64 bits and is capped
+  cass::RateLimiter rate_limiter(settings(1e-12, 1000));
+  uint64_t now = 100 * NS_PER_SECOND;
+  EXPECT_TRUE(rate_limiter.try_acquire(now));
+
+  uint64_t wait_ns;
+  for (int i = 1; i < 1000; ++i) {
+    EXPECT_TRUE(rate_limiter.acquire(now, 0, &wait_ns));
+  }
+  EXPECT_FALSE(rate_limiter.acquire(now + 1000 * NS_PER_SECOND, 1000 * NS_PER_SECOND, &wait_ns));
+  EXPECT_GT(wait_ns, static_cast<uint64_t>(1000 * NS_PER_SECOND));
+}
+
+TEST(RateLimiterUnitTest, Threads) {
+  cass::RateLimiter rate_limiter(settings(1.0, 100));
+
+  AcquireThreadArgs args[NUM_THREADS];
+  for (int i = 0; i < NUM_THREADS; ++i) {
+    args[i].rate_limiter = &rate_limiter;
+    args[i].acquired = 0;
+    uv_thread_create(&args[i].thread, acquire_thread, &args[i]);
+  }
+
+  int acquired = 0;
+  for (int i = 0; i < NUM_THREADS; ++i) {
+    uv_thread_join(&args[i].thread);
+    acquired += args[i].acquired;
+  }
+
+  // Exactly the burst is handed out
+  EXPECT_EQ(100, acquired);
+}
+
+TEST(RateLimiterUnitTest, Options) {
+  CassCluster* cluster = cass_cluster_new();
+
+  EXPECT_EQ(CASS_OK, cass_cluster_set_rate_limit(cluster, CASS_REQUEST_PRIORITY_BACKGROUND, 100.0, 10));
+  EXPECT_EQ(CASS_OK, cass_cluster_set_rate_limit(cluster, CASS_REQUEST_PRIORITY_BACKGROUND, 0.0, 1));
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS,
+            cass_cluster_set_rate_limit(cluster, CASS_REQUEST_PRIORITY_NORMAL, -1.0, 1));
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS,
+            cass_cluster_set_rate_limit(cluster, CASS_REQUEST_PRIORITY_NORMAL, 100.0, 0));
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS,
+            cass_cluster_set_rate_limit(cluster, static_cast<CassRequestPriority>(3), 100.0, 1));
+
+  EXPECT_EQ(CASS_OK, cass_cluster_set_host_rate_limit(cluster, 1000.0, 100));
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS, cass_cluster_set_host_rate_limit(cluster, 1000.0, 0));
+
+  EXPECT_EQ(CASS_OK, cass_cluster_set_rate_limit_max_delay(cluster, 0));
+
+  cass_cluster_free(cluster);
+}
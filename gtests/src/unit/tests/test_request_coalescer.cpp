@@ -0,0 +1,93 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "request_coalescer.hpp"
+#include "request_handler.hpp"
+#include "result_response.hpp"
+
+TEST(RequestCoalescerUnitTest, Response) {
+  cass::RequestCoalescer coalescer;
+
+  cass::ResponseFuture::Ptr leader(new cass::ResponseFuture());
+  cass::RequestCoalescer::Call::Ptr call(coalescer.join("key", leader.get()));
+  ASSERT_TRUE(call);
+
+  // Identical requests wait for the request in flight
+  cass::ResponseFuture::Ptr follower1(new cass::ResponseFuture());
+  cass::ResponseFuture::Ptr follower2(new cass::ResponseFuture());
+  EXPECT_FALSE(coalescer.join("key", follower1.get()));
+  EXPECT_FALSE(coalescer.join("key", follower2.get()));
+
+  // Other requests are sent
+  cass::ResponseFuture::Ptr other(new cass::ResponseFuture());
+  cass::RequestCoalescer::Call::Ptr other_call(coalescer.join("other", other.get()));
+  EXPECT_TRUE(other_call);
+  EXPECT_EQ(2u, coalescer.size());
+
+  cass::Address address("127.0.0.1", 9042);
+  cass::Response::Ptr response(new cass::ResultResponse());
+  ASSERT_TRUE(leader->set_response(address, response));
+  call->finish(leader.get());
+  EXPECT_EQ(1u, coalescer.size());
+
+  // The followers share the same response
+  ASSERT_TRUE(follower1->ready());
+  ASSERT_TRUE(follower2->ready());
+  EXPECT_EQ(NULL, follower1->error());
+  EXPECT_EQ(response.get(), follower1->response().get());
+  EXPECT_EQ(response.get(), follower2->response().get());
+  EXPECT_TRUE(address == follower1->address());
+
+  // The next request is sent again
+  cass::ResponseFuture::Ptr next(new cass::ResponseFuture());
+  EXPECT_TRUE(coalescer.join("key", next.get()));
+}
+
+TEST(RequestCoalescerUnitTest, Error) {
+  cass::RequestCoalescer coalescer;
+
+  cass::ResponseFuture::Ptr leader(new cass::ResponseFuture());
+  cass::RequestCoalescer::Call::Ptr call(coalescer.join("key", leader.get()));
+  cass::ResponseFuture::Ptr follower(new cass::ResponseFuture());
+  EXPECT_FALSE(coalescer.join("key", follower.get()));
+
+  ASSERT_TRUE(leader->set_error(CASS_ERROR_LIB_REQUEST_TIMED_OUT, "Request timed out"));
+  call->finish(leader.get());
+
+  ASSERT_TRUE(follower->ready());
+  ASSERT_TRUE(follower->error() != NULL);
+  EXPECT_EQ(CASS_ERROR_LIB_REQUEST_TIMED_OUT, follower->error()->code);
+  EXPECT_EQ("Request timed out", follower->error()->message);
+}
+
+TEST(RequestCoalescerUnitTest, Dropped) {
+  cass::RequestCoalescer coalescer;
+
+  cass::ResponseFuture::Ptr follower(new cass::ResponseFuture());
+  {
+    cass::ResponseFuture::Ptr leader(new cass::ResponseFuture());
+    cass::RequestCoalescer::Call::Ptr call(coalescer.join("key", leader.get()));
+    EXPECT_FALSE(coalescer.join("key", follower.get()));
+  }
+
+  // A call that's dropped without finishing doesn't leave its followers waiting
+  EXPECT_EQ(0u, coalescer.size());
+  ASSERT_TRUE(follower->ready());
+  ASSERT_TRUE(follower->error() != NULL);
+  EXPECT_EQ(CASS_ERROR_LIB_INTERNAL_ERROR, follower->error()->code);
+}
@@ -0,0 +1,131 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#include <gtest/gtest.h>
+
+#include "config.hpp"
+#include "connection.hpp"
+#include "constants.hpp"
+#include "metrics.hpp"
+#include "request_handler.hpp"
+#include "statement.hpp"
+
+#include <uv.h>
+
+#define ONE_MS (1000LL * 1000LL)
+
+static cass::RequestHandler::Ptr new_request_handler(CassStatement* statement,
+                                                     const cass::ResponseFuture::Ptr& future =
+                                                         cass::ResponseFuture::Ptr(new cass::ResponseFuture())) {
+  return cass::RequestHandler::Ptr(
+        new cass::RequestHandler(cass::Request::ConstPtr(statement->from()), future));
+}
+
+static bool is_expired(CassStatement* statement) {
+  return new_request_handler(statement)->is_expired();
+}
+
+class NopListener : public cass::Connection::Listener {
+public:
+  virtual void on_ready(cass::Connection* connection) { }
+  virtual void on_close(cass::Connection* connection) { }
+  virtual void on_event(cass::EventResponse* response) { }
+};
+
+TEST(RequestDeadlineUnitTest, Expired) {
+  CassStatement* statement = cass_statement_new("SELECT * FROM table", 0);
+
+  // Disabled by default
+  EXPECT_EQ(CASS_UINT64_MAX, statement->deadline_ms());
+  EXPECT_FALSE(is_expired(statement));
+
+  EXPECT_EQ(CASS_OK, cass_statement_set_deadline(statement, 0));
+  EXPECT_TRUE(is_expired(statement));
+
+  EXPECT_EQ(CASS_OK, cass_statement_set_deadline(statement, 60 * 1000));
+  EXPECT_FALSE(is_expired(statement));
+
+  // Too far in the future to be represented
+  EXPECT_EQ(CASS_OK, cass_statement_set_deadline(statement, CASS_UINT64_MAX - 1));
+  EXPECT_FALSE(is_expired(statement));
+
+  cass_statement_free(statement);
+}
+
+TEST(RequestDeadlineUnitTest, CapTimeout) {
+  CassStatement* statement = cass_statement_new("SELECT * FROM table", 0);
+  EXPECT_EQ(CASS_OK, cass_statement_set_request_timeout(statement, 12000));
+
+  // No deadline
+  cass::RequestHandler::Ptr request_handler(new_request_handler(statement));
+  EXPECT_EQ(12000u, request_handler->request_timeout_ms(request_handler->start_time_ns()));
+
+  // The timeout is capped by the time left before the deadline
+  EXPECT_EQ(CASS_OK, cass_statement_set_deadline(statement, 5000));
+  request_handler = new_request_handler(statement);
+  uint64_t start = request_handler->start_time_ns();
+  EXPECT_EQ(5000u, request_handler->request_timeout_ms(start));
+  EXPECT_EQ(1000u, request_handler->request_timeout_ms(start + 4000 * ONE_MS + ONE_MS / 2));
+
+  // An expired request still gets a short timeout
+  EXPECT_EQ(1u, request_handler->request_timeout_ms(start + 6000 * ONE_MS));
+
+  // A deadline is used when there's no request timeout
+  EXPECT_EQ(CASS_OK, cass_statement_set_request_timeout(statement, 0));
+  request_handler = new_request_handler(statement);
+  EXPECT_EQ(5000u, request_handler->request_timeout_ms(request_handler->start_time_ns()));
+
+  // The request timeout is used when it's shorter
+  EXPECT_EQ(CASS_OK, cass_statement_set_request_timeout(statement, 2000));
+  request_handler = new_request_handler(statement);
+  EXPECT_EQ(2000u, request_handler->request_timeout_ms(request_handler->start_time_ns()));
+
+  cass_statement_free(statement);
+}
+
+TEST(RequestDeadlineUnitTest, NotWritten) {
+  uv_loop_t loop;
+  ASSERT_EQ(0, uv_loop_init(&loop));
+
+  cass::Config config;
+  cass::Metrics metrics(1);
+  cass::Host::Ptr host(new cass::Host(cass::Address("127.0.0.1", 9042), false));
+  NopListener listener;
+  cass::Connection* connection = new cass::Connection(&loop, config, &metrics, host, "",
+                                                      CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION,
+                                                      &listener);
+  connection->connect();
+
+  CassStatement* statement = cass_statement_new("SELECT * FROM table", 0);
+  EXPECT_EQ(CASS_OK, cass_statement_set_deadline(statement, 0));
+  cass::ResponseFuture::Ptr future(new cass::ResponseFuture());
+  cass::RequestHandler::Ptr request_handler(new_request_handler(statement, future));
+  cass::RequestExecution::Ptr request_execution(new cass::RequestExecution(request_handler, host));
+
+  // The expired request fails without getting a stream or being written
+  EXPECT_TRUE(connection->write(request_execution));
+  EXPECT_EQ(0u, connection->pending_request_count());
+  ASSERT_TRUE(future->ready());
+  ASSERT_TRUE(future->error() != NULL);
+  EXPECT_EQ(CASS_ERROR_LIB_REQUEST_TIMED_OUT, future->error()->code);
+  EXPECT_EQ(1, metrics.pending_request_timeouts.sum());
+
+  connection->close();
+  uv_run(&loop, UV_RUN_DEFAULT);
+  uv_loop_close(&loop);
+  cass_statement_free(statement);
+}
@@ -0,0 +1,125 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "constants.hpp"
+#include "response.hpp"
+#include "result_response.hpp"
+
+#include <string.h>
+
+// A v4 RESULT (VOID) frame on stream 1
+static const char VOID_RESULT_FRAME[] = {
+  '\x84', '\x00', '\x00', '\x01', CQL_OPCODE_RESULT,
+  '\x00', '\x00', '\x00', '\x04',
+  '\x00', '\x00', '\x00', CASS_RESULT_KIND_VOID
+};
+
+TEST(ResponseUnitTest, Decode)
+{
+  char frame[sizeof(VOID_RESULT_FRAME)];
+  memcpy(frame, VOID_RESULT_FRAME, sizeof(frame));
+
+  cass::ResponseMessage response;
+  EXPECT_EQ(0u, response.body_remaining());
+  EXPECT_EQ(static_cast<ssize_t>(sizeof(frame)), response.decode(frame, sizeof(frame)));
+  ASSERT_TRUE(response.is_body_ready());
+  EXPECT_EQ(1, response.stream());
+  EXPECT_EQ(CQL_OPCODE_RESULT, response.opcode());
+  EXPECT_EQ(0u, response.body_remaining());
+}
+
+TEST(ResponseUnitTest, CommitBody)
+{
+  char frame[sizeof(VOID_RESULT_FRAME)];
+  memcpy(frame, VOID_RESULT_FRAME, sizeof(frame));
+
+  cass::ResponseMessage response;
+
+  // Only the header goes through decode()
+  EXPECT_EQ(CASS_HEADER_SIZE_V3, response.decode(frame, CASS_HEADER_SIZE_V3));
+  EXPECT_FALSE(response.is_body_ready());
+  ASSERT_EQ(4u, response.body_remaining());
+
+  // The body is written in place in two parts
+  memcpy(response.body_buffer_pos(), frame + CASS_HEADER_SIZE_V3, 2);
+  EXPECT_EQ(2, response.commit_body(2));
+  EXPECT_FALSE(response.is_body_ready());
+  ASSERT_EQ(2u, response.body_remaining());
+
+  memcpy(response.body_buffer_pos(), frame + CASS_HEADER_SIZE_V3 + 2, 2);
+  EXPECT_EQ(2, response.commit_body(2));
+  ASSERT_TRUE(response.is_body_ready());
+  EXPECT_EQ(0u, response.body_remaining());
+
+  cass::ResultResponse* result =
+      static_cast<cass::ResultResponse*>(response.response_body().get());
+  EXPECT_EQ(CASS_RESULT_KIND_VOID, result->kind());
+}
+
+class DiscardStreamFilter : public cass::ResponseMessage::BodyFilter {
+public:
+  DiscardStreamFilter(int16_t stream)
+    : stream_(stream) { }
+
+  virtual bool is_body_discarded(int16_t stream) const { return stream == stream_; }
+
+private:
+  int16_t stream_;
+};
+
+TEST(ResponseUnitTest, DiscardBody)
+{
+  // Two frames back-to-back
+  char frames[2 * sizeof(VOID_RESULT_FRAME)];
+  memcpy(frames, VOID_RESULT_FRAME, sizeof(VOID_RESULT_FRAME));
+  memcpy(frames + sizeof(VOID_RESULT_FRAME), VOID_RESULT_FRAME, sizeof(VOID_RESULT_FRAME));
+
+  DiscardStreamFilter filter(1);
+
+  { // The whole frame at once; the rest of the input isn't consumed
+    cass::ResponseMessage response(&filter);
+    EXPECT_EQ(static_cast<ssize_t>(sizeof(VOID_RESULT_FRAME)),
+              response.decode(frames, sizeof(frames)));
+    ASSERT_TRUE(response.is_body_ready());
+    EXPECT_TRUE(response.is_body_discarded());
+    EXPECT_FALSE(response.response_body());
+    EXPECT_EQ(sizeof(VOID_RESULT_FRAME), response.frame_size());
+  }
+
+  { // The body in parts
+    cass::ResponseMessage response(&filter);
+    EXPECT_EQ(CASS_HEADER_SIZE_V3, response.decode(frames, CASS_HEADER_SIZE_V3));
+    EXPECT_TRUE(response.is_body_discarded());
+    EXPECT_EQ(0u, response.body_remaining()); // Nothing to write in place
+    EXPECT_EQ(2, response.decode(frames + CASS_HEADER_SIZE_V3, 2));
+    EXPECT_FALSE(response.is_body_ready());
+    EXPECT_EQ(2, response.decode(frames + CASS_HEADER_SIZE_V3 + 2,
+                                 sizeof(frames) - CASS_HEADER_SIZE_V3 - 2));
+    EXPECT_TRUE(response.is_body_ready());
+  }
+
+  { // Other streams are decoded
+    DiscardStreamFilter other(2);
+    cass::ResponseMessage response(&other);
+    EXPECT_EQ(static_cast<ssize_t>(sizeof(VOID_RESULT_FRAME)),
+              response.decode(frames, sizeof(frames)));
+    ASSERT_TRUE(response.is_body_ready());
+    EXPECT_FALSE(response.is_body_discarded());
+    ASSERT_TRUE(response.response_body());
+  }
+}
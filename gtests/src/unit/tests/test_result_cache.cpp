@@ -0,0 +1,297 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "cluster.hpp"
+#include "execute_request.hpp"
+#include "prepared.hpp"
+#include "query_request.hpp"
+#include "request_handler.hpp"
+#include "result_cache.hpp"
+#include "result_response.hpp"
+
+#include <string.h>
+
+#define TTL_NS (1000ULL * 1000 * 1000)
+
+static void append_int32(std::string* body, int32_t value) {
+  body->push_back(static_cast<char>(value >> 24));
+  body->push_back(static_cast<char>(value >> 16));
+  body->push_back(static_cast<char>(value >> 8));
+  body->push_back(static_cast<char>(value));
+}
+
+static void append_uint16(std::string* body, uint16_t value) {
+  body->push_back(static_cast<char>(value >> 8));
+  body->push_back(static_cast<char>(value));
+}
+
+static void append_string(std::string* body, const std::string& value) {
+  append_uint16(body, static_cast<uint16_t>(value.size()));
+  body->append(value);
+}
+
+// Metadata for a single int column with a global table spec
+static void append_metadata(std::string* body,
+                            const std::string& table, const std::string& column) {
+  append_int32(body, CASS_RESULT_FLAG_GLOBAL_TABLESPEC);
+  append_int32(body, 1);
+  append_string(body, "ks");
+  append_string(body, table);
+  append_string(body, column);
+  append_uint16(body, CASS_VALUE_TYPE_INT);
+}
+
+static cass::ResultResponse::Ptr decode_result(const std::string& body) {
+  cass::ResultResponse::Ptr result(new cass::ResultResponse());
+  result->set_buffer(body.size());
+  memcpy(result->data(), body.data(), body.size());
+  EXPECT_TRUE(result->decode(4, result->data(), body.size()));
+  return result;
+}
+
+// A statement on "ks"."<table>" with its partition key bound. Reads return a
+// single column and writes don't return any.
+static cass::Prepared::ConstPtr prepare(const std::string& id,
+                                        const std::string& table,
+                                        bool is_read) {
+  std::string body;
+  append_int32(&body, CASS_RESULT_KIND_PREPARED);
+  append_string(&body, id);
+  append_int32(&body, CASS_RESULT_FLAG_GLOBAL_TABLESPEC);
+  append_int32(&body, 1);
+  append_int32(&body, 1); // Partition key count
+  append_uint16(&body, 0);
+  append_string(&body, "ks");
+  append_string(&body, table);
+  append_string(&body, "k");
+  append_uint16(&body, CASS_VALUE_TYPE_INT);
+  if (is_read) {
+    append_metadata(&body, table, "v");
+  } else {
+    append_int32(&body, 0);
+    append_int32(&body, 0);
+  }
+
+  cass::Metadata::SchemaSnapshot schema(0, 4, cass::VersionNumber(),
+                                        cass::KeyspaceMetadata::MapPtr(
+                                          new cass::KeyspaceMetadata::Map()),
+                                        cass::TableSplitMetadata::MapPtr(
+                                          new cass::TableSplitMetadata::Map()));
+  return cass::Prepared::ConstPtr(
+        new cass::Prepared(decode_result(body),
+                           cass::PrepareRequest::ConstPtr(new cass::PrepareRequest(id)),
+                           schema));
+}
+
+static cass::SharedRefPtr<cass::ExecuteRequest> bind(const cass::Prepared::ConstPtr& prepared,
+                                                     cass_int32_t key) {
+  cass::SharedRefPtr<cass::ExecuteRequest> request(new cass::ExecuteRequest(prepared.get()));
+  EXPECT_EQ(CASS_OK, cass_statement_bind_int32(CassStatement::to(request.get()), 0, key));
+  return request;
+}
+
+static cass::Response::Ptr rows(const std::string& table) {
+  std::string body;
+  append_int32(&body, CASS_RESULT_KIND_ROWS);
+  append_metadata(&body, table, "v");
+  append_int32(&body, 1);
+  append_int32(&body, 4);
+  append_int32(&body, 42);
+  return decode_result(body);
+}
+
+class ResultCacheUnitTest : public testing::Test {
+public:
+  ResultCacheUnitTest()
+    : address("127.0.0.1", 9042)
+    , read1(prepare("read1", "table1", true))
+    , read2(prepare("read2", "table2", true))
+    , write1(prepare("write1", "table1", false)) {
+    settings.max_size_bytes = 1024 * 1024;
+    settings.ttl_ns = TTL_NS;
+  }
+
+  // Executes a read through the cache returning true if it was a hit
+  bool read(cass::ResultCache* cache,
+            const cass::SharedRefPtr<cass::ExecuteRequest>& request,
+            uint64_t now_ns = 0) {
+    std::string key;
+    EXPECT_TRUE(request->get_result_key(&key));
+    cass::Address cached_address;
+    cass::ResultCache::Fill::Ptr fill;
+    if (cache->get(request.get(), key, now_ns, &cached_address, &fill)) {
+      EXPECT_TRUE(address == cached_address);
+      EXPECT_FALSE(fill);
+      return true;
+    }
+    EXPECT_TRUE(fill);
+    fills.push_back(fill);
+    return false;
+  }
+
+  // Completes the oldest read that missed
+  void finish_read(cass::ResultCache* cache, const std::string& table,
+                   uint64_t now_ns = 0) {
+    ASSERT_FALSE(fills.empty());
+    cass::ResponseFuture::Ptr future(new cass::ResponseFuture());
+    future->set_response(address, rows(table));
+    cache->add(fills.front(), future.get(), now_ns);
+    fills.erase(fills.begin());
+  }
+
+  cass::ResultCache::Settings settings;
+  cass::Address address;
+  cass::Prepared::ConstPtr read1;
+  cass::Prepared::ConstPtr read2;
+  cass::Prepared::ConstPtr write1;
+  std::vector<cass::ResultCache::Fill::Ptr> fills;
+};
+
+TEST_F(ResultCacheUnitTest, HitAndMiss) {
+  cass::ResultCache cache(settings);
+
+  EXPECT_FALSE(read(&cache, bind(read1, 1)));
+  finish_read(&cache, "table1");
+  EXPECT_TRUE(read(&cache, bind(read1, 1)));
+
+  // Different values are different results
+  EXPECT_FALSE(read(&cache, bind(read1, 2)));
+
+  cass::ResultCache::Stats stats(cache.stats());
+  EXPECT_EQ(1u, stats.hits);
+  EXPECT_EQ(2u, stats.misses);
+  EXPECT_EQ(1u, stats.entries);
+  EXPECT_GT(stats.size_bytes, 0u);
+}
+
+TEST_F(ResultCacheUnitTest, Expired) {
+  cass::ResultCache cache(settings);
+
+  EXPECT_FALSE(read(&cache, bind(read1, 1), 0));
+  finish_read(&cache, "table1", 0);
+  EXPECT_TRUE(read(&cache, bind(read1, 1), TTL_NS - 1));
+  EXPECT_FALSE(read(&cache, bind(read1, 1), TTL_NS));
+  EXPECT_EQ(0u, cache.stats().entries);
+}
+
+TEST_F(ResultCacheUnitTest, Errors) {
+  cass::ResultCache cache(settings);
+
+  EXPECT_FALSE(read(&cache, bind(read1, 1)));
+  cass::ResponseFuture::Ptr future(new cass::ResponseFuture());
+  future->set_error(CASS_ERROR_LIB_REQUEST_TIMED_OUT, "Request timed out");
+  cache.add(fills.front(), future.get(), 0);
+  EXPECT_EQ(0u, cache.stats().entries);
+}
+
+TEST_F(ResultCacheUnitTest, InvalidatedByWrite) {
+  cass::ResultCache cache(settings);
+
+  EXPECT_FALSE(read(&cache, bind(read1, 1)));
+  finish_read(&cache, "table1");
+  EXPECT_FALSE(read(&cache, bind(read2, 1)));
+  finish_read(&cache, "table2");
+
+  // Writes (even failed ones) invalidate their table
+  cache.invalidate(bind(write1, 1).get(), NULL);
+  EXPECT_FALSE(read(&cache, bind(read1, 1)));
+  EXPECT_TRUE(read(&cache, bind(read2, 1)));
+
+  // Reads don't invalidate anything
+  fills.clear();
+  cass::Response::Ptr response(rows("table2"));
+  cache.invalidate(bind(read2, 1).get(), response.get());
+  EXPECT_TRUE(read(&cache, bind(read2, 1)));
+}
+
+TEST_F(ResultCacheUnitTest, InvalidatedWhileInFlight) {
+  cass::ResultCache cache(settings);
+
+  // A write that finishes while a read is in flight keeps the read's result
+  // out of the cache
+  EXPECT_FALSE(read(&cache, bind(read1, 1)));
+  cache.invalidate(bind(write1, 1).get(), NULL);
+  finish_read(&cache, "table1");
+  EXPECT_EQ(0u, cache.stats().entries);
+  EXPECT_FALSE(read(&cache, bind(read1, 1)));
+}
+
+TEST_F(ResultCacheUnitTest, InvalidatedBySimpleStatement) {
+  cass::ResultCache cache(settings);
+
+  EXPECT_FALSE(read(&cache, bind(read1, 1)));
+  finish_read(&cache, "table1");
+
+  // Simple statements that return rows are reads
+  cass::QueryRequest select("SELECT v FROM ks.table2");
+  cass::Response::Ptr response(rows("table2"));
+  cache.invalidate(&select, response.get());
+  EXPECT_TRUE(read(&cache, bind(read1, 1)));
+
+  // Any others could have written to any table
+  cass::QueryRequest insert("INSERT INTO ks.table2 (k, v) VALUES (1, 1)");
+  cass::Response::Ptr void_response(new cass::ResultResponse());
+  cache.invalidate(&insert, void_response.get());
+  EXPECT_FALSE(read(&cache, bind(read1, 1)));
+}
+
+TEST_F(ResultCacheUnitTest, InvalidatedBySchemaChange) {
+  cass::ResultCache cache(settings);
+
+  EXPECT_FALSE(read(&cache, bind(read1, 1)));
+  finish_read(&cache, "table1");
+  EXPECT_FALSE(read(&cache, bind(read2, 1)));
+  finish_read(&cache, "table2");
+
+  cache.invalidate_table("ks", "table1");
+  EXPECT_FALSE(read(&cache, bind(read1, 1)));
+  EXPECT_TRUE(read(&cache, bind(read2, 1)));
+
+  cache.invalidate_keyspace("other");
+  EXPECT_TRUE(read(&cache, bind(read2, 1)));
+  cache.invalidate_keyspace("ks");
+  EXPECT_FALSE(read(&cache, bind(read2, 1)));
+}
+
+TEST_F(ResultCacheUnitTest, Evicted) {
+  settings.max_size_bytes = 16 * 1024;
+  cass::ResultCache cache(settings);
+
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_FALSE(read(&cache, bind(read1, i)));
+    finish_read(&cache, "table1");
+  }
+
+  cass::ResultCache::Stats stats(cache.stats());
+  EXPECT_GT(stats.evictions, 0u);
+  EXPECT_EQ(1000u, stats.entries + stats.evictions);
+  EXPECT_LE(stats.size_bytes, settings.max_size_bytes);
+
+  // The most recently used results are kept
+  EXPECT_TRUE(read(&cache, bind(read1, 999)));
+  EXPECT_FALSE(read(&cache, bind(read1, 0)));
+}
+
+TEST(ResultCacheOptionUnitTest, Option) {
+  CassCluster* cluster = cass_cluster_new();
+  EXPECT_EQ(CASS_OK, cass_cluster_set_result_cache(cluster, 1024 * 1024, 1000));
+  EXPECT_EQ(CASS_OK, cass_cluster_set_result_cache(cluster, 0, 0));
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS, cass_cluster_set_result_cache(cluster, 1024, 0));
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS, cass_cluster_set_result_cache(cluster, 0, 1000));
+  cass_cluster_free(cluster);
+}
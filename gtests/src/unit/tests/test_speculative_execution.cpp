@@ -0,0 +1,105 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "cassandra.h"
+#include "scoped_ptr.hpp"
+#include "speculative_execution.hpp"
+
+#include <uv.h>
+
+static const uint64_t INTERVAL_NS = 100LL * 1000LL * 1000LL; // 100 milliseconds
+
+// Records latencies for a full interval, then one more to complete it
+static void record_interval(cass::PercentileSpeculativeExecutionPolicy* policy,
+                            const cass::Address& address,
+                            int count) {
+  for (int i = 1; i <= count; ++i) {
+    policy->record_latency(address, i * 1000LL * 1000LL); // i milliseconds
+  }
+  uv_sleep(150);
+  policy->record_latency(address, 1000LL * 1000LL);
+}
+
+TEST(SpeculativeExecutionUnitTest, PercentileDelay)
+{
+  cass::PercentileSpeculativeExecutionPolicy::Ptr policy(
+        new cass::PercentileSpeculativeExecutionPolicy(99.0, 2, 1.0, INTERVAL_NS));
+  cass::Host::Ptr host1(new cass::Host(cass::Address("127.0.0.1", 9042), false));
+  cass::Host::Ptr host2(new cass::Host(cass::Address("127.0.0.2", 9042), false));
+
+  { // No samples
+    cass::ScopedPtr<cass::SpeculativeExecutionPlan> plan(policy->new_plan("", NULL));
+    EXPECT_EQ(-1, plan->next_execution(host1));
+  }
+
+  // Not enough samples
+  record_interval(policy.get(), host1->address(),
+                  cass::PercentileSpeculativeExecutionPolicy::MIN_RECORDED_VALUES / 2);
+  EXPECT_EQ(-1, policy->delay_ms(host1->address()));
+
+  // The delay is the 99th percentile of the host's previous interval
+  record_interval(policy.get(), host1->address(), 1000);
+  EXPECT_NEAR(990, policy->delay_ms(host1->address()), 1); // Within the histogram's precision
+  EXPECT_EQ(-1, policy->delay_ms(host2->address()));
+
+  {
+    cass::ScopedPtr<cass::SpeculativeExecutionPlan> plan(policy->new_plan("", NULL));
+    EXPECT_NEAR(990, plan->next_execution(host1), 1);
+    EXPECT_EQ(-1, plan->next_execution(host2));
+    EXPECT_EQ(-1, plan->next_execution(host1)); // Only two executions
+  }
+
+  // Adapts to new latencies
+  record_interval(policy.get(), host1->address(), 200);
+  EXPECT_NEAR(198, policy->delay_ms(host1->address()), 1);
+}
+
+TEST(SpeculativeExecutionUnitTest, PercentileBudget)
+{
+  cass::PercentileSpeculativeExecutionPolicy::Ptr policy(
+        new cass::PercentileSpeculativeExecutionPolicy(99.0, 1, 0.25));
+
+  // Every four requests allow for a single speculative execution
+  for (int i = 0; i < 3; ++i) {
+    cass::ScopedPtr<cass::SpeculativeExecutionPlan> plan(policy->new_plan("", NULL));
+    EXPECT_FALSE(plan->acquire_execution());
+  }
+  cass::ScopedPtr<cass::SpeculativeExecutionPlan> plan(policy->new_plan("", NULL));
+  EXPECT_TRUE(plan->acquire_execution());
+  EXPECT_FALSE(plan->acquire_execution());
+
+  // Unused budget is capped
+  for (int i = 0; i < 4 * cass::PercentileSpeculativeExecutionPolicy::MAX_BUDGET_BURST + 100; ++i) {
+    delete policy->new_plan("", NULL);
+  }
+  for (int i = 0; i < cass::PercentileSpeculativeExecutionPolicy::MAX_BUDGET_BURST; ++i) {
+    EXPECT_TRUE(policy->acquire_execution());
+  }
+  EXPECT_FALSE(policy->acquire_execution());
+}
+
+TEST(SpeculativeExecutionUnitTest, PercentileOptions)
+{
+  CassCluster* cluster = cass_cluster_new();
+  EXPECT_EQ(CASS_OK, cass_cluster_set_percentile_speculative_execution_policy(cluster, 99.0, 2, 0.05));
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS, cass_cluster_set_percentile_speculative_execution_policy(cluster, 0.0, 2, 0.05));
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS, cass_cluster_set_percentile_speculative_execution_policy(cluster, 100.0, 2, 0.05));
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS, cass_cluster_set_percentile_speculative_execution_policy(cluster, 99.0, -1, 0.05));
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS, cass_cluster_set_percentile_speculative_execution_policy(cluster, 99.0, 2, 1.5));
+  cass_cluster_free(cluster);
+}
@@ -0,0 +1,137 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "scoped_ptr.hpp"
+#include "ssl.hpp"
+#include "test_ssl_utils.hpp"
+
+#ifdef CASS_USE_KTLS
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+TEST(SslKernelOffloadUnitTest, Option) {
+  CassSsl* ssl = cass_ssl_new();
+#ifdef CASS_USE_KTLS
+  EXPECT_EQ(CASS_OK, cass_ssl_set_kernel_offload(ssl, cass_true));
+#else
+  EXPECT_EQ(CASS_ERROR_LIB_NOT_IMPLEMENTED, cass_ssl_set_kernel_offload(ssl, cass_true));
+#endif
+  EXPECT_EQ(CASS_OK, cass_ssl_set_kernel_offload(ssl, cass_false));
+  cass_ssl_free(ssl);
+}
+
+#ifdef CASS_USE_KTLS
+
+static void connect_sockets(int* client, int* server) {
+  struct sockaddr_in addr;
+  socklen_t addr_len = sizeof(addr);
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  int listener = socket(AF_INET, SOCK_STREAM, 0);
+  ASSERT_EQ(0, bind(listener, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)));
+  ASSERT_EQ(0, listen(listener, 1));
+  ASSERT_EQ(0, getsockname(listener, reinterpret_cast<struct sockaddr*>(&addr), &addr_len));
+
+  *client = socket(AF_INET, SOCK_STREAM, 0);
+  ASSERT_EQ(0, connect(*client, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)));
+  *server = accept(listener, NULL, NULL);
+  ASSERT_GE(*server, 0);
+  close(listener);
+}
+
+static void exchange(int max_version) {
+  cass::SslContextFactory::init();
+
+  cass::SslContext::Ptr context(cass::SslContextFactory::create());
+  context->set_verify_flags(CASS_SSL_VERIFY_NONE);
+  ASSERT_EQ(CASS_OK, context->set_kernel_offload(true));
+
+  cass::Host::ConstPtr host(new cass::Host(cass::Address("127.0.0.1", 9042), false));
+  cass::ScopedPtr<cass::SslSession> session(context->create_session(host));
+  TlsServer server(max_version);
+  cass::ScopedPtr<TlsServer::Connection> connection(server.accept());
+  ASSERT_TRUE(connection->handshake(session.get())) << session->error_message();
+
+  char buf[16 * 1024];
+  int client_fd = -1, server_fd = -1;
+  connect_sockets(&client_fd, &server_fd);
+
+  // Falls back to the userspace record layer if the kernel doesn't support
+  // kTLS (e.g. the "tls" module isn't available)
+  bool is_offloaded = session->enable_kernel_offload(client_fd);
+  EXPECT_EQ(is_offloaded, session->is_kernel_offload_tx());
+  if (max_version == TLS1_3_VERSION) {
+    EXPECT_FALSE(session->is_kernel_offload_rx());
+  }
+
+  // Client to server
+  if (session->is_kernel_offload_tx()) {
+    ASSERT_EQ(5, send(client_fd, "hello", 5, 0));
+  } else {
+    ASSERT_EQ(5, session->encrypt("hello", 5));
+    size_t size = session->outgoing().read(buf, sizeof(buf));
+    ASSERT_EQ(static_cast<ssize_t>(size), send(client_fd, buf, size, 0));
+  }
+
+  int rc = 0;
+  for (int i = 0; i < 10 && rc <= 0; ++i) {
+    ssize_t size = recv(server_fd, buf, sizeof(buf), 0);
+    ASSERT_GT(size, 0);
+    connection->receive(buf, size);
+    rc = connection->read(buf, sizeof(buf));
+  }
+  ASSERT_EQ(5, rc);
+  EXPECT_EQ(0, memcmp("hello", buf, 5));
+
+  // Server to client
+  ASSERT_EQ(5, connection->write("world", 5));
+  size_t size = connection->send(buf, sizeof(buf));
+  ASSERT_EQ(static_cast<ssize_t>(size), send(server_fd, buf, size, 0));
+
+  rc = 0;
+  for (int i = 0; i < 10 && rc <= 0; ++i) {
+    ssize_t size = recv(client_fd, buf, sizeof(buf), 0);
+    ASSERT_GT(size, 0);
+    if (session->is_kernel_offload_rx()) {
+      rc = size;
+    } else {
+      session->incoming().write(buf, size);
+      rc = session->decrypt(buf, sizeof(buf));
+    }
+  }
+  ASSERT_EQ(5, rc);
+  EXPECT_EQ(0, memcmp("world", buf, 5));
+
+  close(client_fd);
+  close(server_fd);
+}
+
+TEST(SslKernelOffloadUnitTest, Tls12) {
+  exchange(TLS1_2_VERSION);
+}
+
+TEST(SslKernelOffloadUnitTest, Tls13) {
+  exchange(TLS1_3_VERSION);
+}
+
+#endif
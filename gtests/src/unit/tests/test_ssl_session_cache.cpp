@@ -0,0 +1,73 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "scoped_ptr.hpp"
+#include "ssl.hpp"
+#include "test_ssl_utils.hpp"
+
+#ifdef HAVE_TEST_TLS_SERVER
+
+static void resume(int max_version) {
+  cass::SslContextFactory::init();
+
+  cass::SslContext::Ptr context(cass::SslContextFactory::create());
+  context->set_verify_flags(CASS_SSL_VERIFY_NONE);
+  TlsServer server(max_version);
+
+  cass::Host::ConstPtr host1(new cass::Host(cass::Address("127.0.0.1", 9042), false));
+  cass::Host::ConstPtr host2(new cass::Host(cass::Address("127.0.0.2", 9042), false));
+
+  { // The first connection to a host uses a full handshake
+    cass::ScopedPtr<cass::SslSession> session(context->create_session(host1));
+    cass::ScopedPtr<TlsServer::Connection> connection(server.accept());
+    ASSERT_TRUE(connection->handshake(session.get())) << session->error_message();
+    EXPECT_FALSE(session->is_resumed());
+  }
+
+  { // Reconnecting resumes the cached session
+    cass::ScopedPtr<cass::SslSession> session(context->create_session(host1));
+    cass::ScopedPtr<TlsServer::Connection> connection(server.accept());
+    ASSERT_TRUE(connection->handshake(session.get())) << session->error_message();
+    EXPECT_TRUE(session->is_resumed());
+  }
+
+  { // Sessions are cached by host
+    cass::ScopedPtr<cass::SslSession> session(context->create_session(host2));
+    cass::ScopedPtr<TlsServer::Connection> connection(server.accept());
+    ASSERT_TRUE(connection->handshake(session.get())) << session->error_message();
+    EXPECT_FALSE(session->is_resumed());
+  }
+
+  { // A different server can't resume the session and a full handshake is used
+    TlsServer other(max_version);
+    cass::ScopedPtr<cass::SslSession> session(context->create_session(host1));
+    cass::ScopedPtr<TlsServer::Connection> connection(other.accept());
+    ASSERT_TRUE(connection->handshake(session.get())) << session->error_message();
+    EXPECT_FALSE(session->is_resumed());
+  }
+}
+
+TEST(SslSessionCacheUnitTest, Tls12) {
+  resume(TLS1_2_VERSION);
+}
+
+TEST(SslSessionCacheUnitTest, Tls13) {
+  resume(TLS1_3_VERSION);
+}
+
+#endif
@@ -238,6 +238,32 @@ typedef struct CassBatch_ CassBatch;
  */
 typedef struct CassFuture_ CassFuture;
 
+/**
+ * A queue of completed futures. Futures are added to a completion queue
+ * and a consumer thread removes them in batches once they're set.
+ *
+ * @struct CassCompletionQueue
+ */
+typedef struct CassCompletionQueue_ CassCompletionQueue;
+
+/**
+ * A completed future removed from a completion queue.
+ *
+ * @struct CassCompletion
+ */
+typedef struct CassCompletion_ {
+  CassFuture* future; /**< The completed future. It must be freed using cass_future_free(). */
+  void* data; /**< The user defined data provided when the future was added */
+} CassCompletion;
+
+/**
+ * Iterates over the pages of a statement's result and prefetches the
+ * next page while the current page is processed.
+ *
+ * @struct CassPager
+ */
+typedef struct CassPager_ CassPager;
+
 /**
  * A statement that has been prepared cluster-side (It has been pre-parsed
  * and cached).
@@ -468,6 +494,94 @@ typedef struct CassMetrics_ {
 
 } CassMetrics;
 
+/**
+ * A snapshot of the session's SSL metrics.
+ *
+ * @struct CassSslMetrics
+ */
+typedef struct CassSslMetrics_ {
+  cass_uint64_t full_handshakes; /**< Handshakes that negotiated a new session */
+  cass_uint64_t resumed_handshakes; /**< Handshakes that resumed a previous session */
+} CassSslMetrics;
+
+/**
+ * A snapshot of the session's speculative execution metrics.
+ *
+ * @struct CassSpeculativeExecutionMetrics
+ */
+typedef struct CassSpeculativeExecutionMetrics_ {
+  cass_uint64_t executions; /**< Speculative executions sent */
+  cass_uint64_t dropped_executions; /**< Speculative executions not sent because the policy's budget was exhausted */
+  cass_uint64_t wasted_responses; /**< Responses received for executions that had already been cancelled (e.g. losing speculative executions) */
+  cass_uint64_t wasted_bytes; /**< Bytes of the wasted responses */
+} CassSpeculativeExecutionMetrics;
+
+/**
+ * A snapshot of the session's request latencies for a single request
+ * priority.
+ *
+ * @struct CassRequestPriorityMetrics
+ *
+ * @see cass_statement_set_priority()
+ */
+typedef struct CassRequestPriorityMetrics_ {
+  cass_uint64_t min; /**< Minimum in microseconds */
+  cass_uint64_t max; /**< Maximum in microseconds */
+  cass_uint64_t mean; /**< Mean in microseconds */
+  cass_uint64_t stddev; /**< Standard deviation in microseconds */
+  cass_uint64_t median; /**< Median in microseconds */
+  cass_uint64_t percentile_75th; /**< 75th percentile in microseconds */
+  cass_uint64_t percentile_95th; /**< 95th percentile in microseconds */
+  cass_uint64_t percentile_98th; /**< 98th percentile in microseconds */
+  cass_uint64_t percentile_99th; /**< 99the percentile in microseconds */
+  cass_uint64_t percentile_999th; /**< 99.9th percentile in microseconds */
+} CassRequestPriorityMetrics;
+
+/**
+ * A snapshot of the session's rate limiter metrics.
+ *
+ * @struct CassRateLimiterMetrics
+ */
+typedef struct CassRateLimiterMetrics_ {
+  cass_uint64_t delayed_requests; /**< Requests delayed by the session's rate limits */
+  cass_uint64_t delayed_time; /**< Total time requests were delayed in microseconds */
+  cass_uint64_t rejected_requests; /**< Requests rejected by the session's rate limits */
+  cass_uint64_t skipped_hosts; /**< Hosts skipped because they reached their rate limit */
+} CassRateLimiterMetrics;
+
+/**
+ * A snapshot of a host's adaptive concurrency limit.
+ *
+ * @struct CassHostConcurrencyMetrics
+ */
+typedef struct CassHostConcurrencyMetrics_ {
+  cass_uint32_t limit; /**< The current limit on requests in flight to the host (0 if disabled) */
+  cass_int64_t inflight_requests; /**< The requests in flight to the host */
+} CassHostConcurrencyMetrics;
+
+/**
+ * A snapshot of the session's result cache metrics.
+ *
+ * @struct CassResultCacheMetrics
+ */
+typedef struct CassResultCacheMetrics_ {
+  cass_uint64_t hits; /**< Reads served from the cache */
+  cass_uint64_t misses; /**< Reads not found in the cache (or expired) */
+  cass_uint64_t evictions; /**< Results evicted to stay within the memory limit */
+  cass_uint64_t entries; /**< The results currently in the cache */
+  cass_uint64_t size_bytes; /**< The memory used by the results in the cache */
+} CassResultCacheMetrics;
+
+/**
+ * A snapshot of the object pool's metrics.
+ *
+ * @struct CassObjectPoolMetrics
+ */
+typedef struct CassObjectPoolMetrics_ {
+  cass_uint64_t hits; /**< Allocations served by a thread's cached blocks */
+  cass_uint64_t misses; /**< Allocations that required a new block from the allocator */
+} CassObjectPoolMetrics;
+
 typedef enum CassConsistency_ {
   CASS_CONSISTENCY_UNKNOWN      = 0xFFFF,
   CASS_CONSISTENCY_ANY          = 0x0000,
@@ -527,6 +641,17 @@ typedef enum CassWriteType_ {
 #define CASS_WRITE_TYPE_MAP CASS_WRITE_TYPE_MAPPING /* Deprecated */
 /* @endcond */
 
+typedef enum CassRequestPriority_ {
+  CASS_REQUEST_PRIORITY_INTERACTIVE,
+  CASS_REQUEST_PRIORITY_NORMAL,
+  CASS_REQUEST_PRIORITY_BACKGROUND
+} CassRequestPriority;
+
+#define CASS_REQUEST_PRIORITY_MAPPING(XX) \
+  XX(CASS_REQUEST_PRIORITY_INTERACTIVE, "INTERACTIVE") \
+  XX(CASS_REQUEST_PRIORITY_NORMAL, "NORMAL") \
+  XX(CASS_REQUEST_PRIORITY_BACKGROUND, "BACKGROUND")
+
 typedef enum CassColumnType_ {
   CASS_COLUMN_TYPE_REGULAR,
   CASS_COLUMN_TYPE_PARTITION_KEY,
@@ -698,6 +823,7 @@ typedef enum  CassErrorSource_ {
   XX(CASS_ERROR_SOURCE_LIB, CASS_ERROR_LIB_NOT_ENOUGH_DATA, 31, "Not enough data") \
   XX(CASS_ERROR_SOURCE_LIB, CASS_ERROR_LIB_INVALID_STATE, 32, "Invalid state") \
   XX(CASS_ERROR_SOURCE_LIB, CASS_ERROR_LIB_NO_CUSTOM_PAYLOAD, 33, "No custom payload") \
+  XX(CASS_ERROR_SOURCE_LIB, CASS_ERROR_LIB_RATE_LIMITED, 34, "Request rejected by the rate limiter") \
   XX(CASS_ERROR_SOURCE_SERVER, CASS_ERROR_SERVER_SERVER_ERROR, 0x0000, "Server error") \
   XX(CASS_ERROR_SOURCE_SERVER, CASS_ERROR_SERVER_PROTOCOL_ERROR, 0x000A, "Protocol error") \
   XX(CASS_ERROR_SOURCE_SERVER, CASS_ERROR_SERVER_BAD_CREDENTIALS, 0x0100, "Bad credentials") \
@@ -783,6 +909,58 @@ typedef struct CassLogMessage_ {
 typedef void (*CassLogCallback)(const CassLogMessage* message,
                                 void* data);
 
+/**
+ * A custom malloc function. This function should allocate "size" bytes and
+ * return a pointer to that memory
+ *
+ * @param[in] size The size of the memory to allocate
+ *
+ * @see CassFreeFunction
+ * @see cass_alloc_set_functions()
+ */
+typedef void* (*CassMallocFunction)(size_t size);
+
+/**
+ * A custom realloc function. This function attempts to change the size
+ * of the memory pointed to by "ptr". If the memory cannot be resized then
+ * new memory should be allocated and contain the contents of the original
+ * memory at "ptr".
+ *
+ * @param[in] ptr A pointer to the original memory. If NULL it should behave the
+ * same as "CassMallocFunction"
+ * @param[in] size The size of the memory to allocate/resize.
+ *
+ * @see CassMallocFunction
+ * @see CassFreeFunction
+ * @see cass_alloc_set_functions()
+ */
+typedef void* (*CassReallocFunction)(void* ptr, size_t size);
+
+/**
+ * A custom free function. This function deallocates the memory pointed to by
+ * "ptr" that was previously allocated by a "CassMallocFunction" or
+ * "CassReallocFunction" function.
+ *
+ * @param[in] ptr A pointer to memory that should be deallocated. If NULL then
+ * this will perform no operation.
+ *
+ * @see CassMallocFunction
+ * @see CassReallocFunction
+ * @see cass_alloc_set_functions()
+ */
+typedef void (*CassFreeFunction)(void* ptr);
+
+/**
+ * A callback that's used to release memory owned by the application that
+ * was bound to a statement without being copied.
+ *
+ * @param[in] data user defined data provided when the memory was bound.
+ *
+ * @see cass_statement_bind_bytes_external()
+ * @see cass_statement_bind_string_external()
+ */
+typedef void (*CassReleaseCallback)(void* data);
+
 /**
  * An authenticator.
  *
@@ -1509,6 +1687,31 @@ cass_cluster_set_latency_aware_routing_settings(CassCluster* cluster,
                                                 cass_uint64_t update_rate_ms,
                                                 cass_uint64_t min_measured);
 
+/**
+ * Configures how latency-aware request routing scores hosts. The score of
+ * each host is compared to the best score using the exclusion threshold.
+ *
+ * <b>Defaults:</b> The average latency is used and in-flight requests are
+ * not considered.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] tail_percentile Score hosts by an estimate of this percentile
+ * of their latencies (e.g. 99.0) instead of their average latency. A value of
+ * 0 uses the average latency.
+ * @param[in] weight_inflight If true, a host's latency is multiplied by the
+ * number of requests waiting on that host (plus one) so that busy hosts are
+ * avoided before their latencies increase.
+ * @return CASS_OK if successful, otherwise an error occurred
+ *
+ * @see cass_cluster_set_latency_aware_routing_settings()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_latency_aware_routing_scoring(CassCluster* cluster,
+                                               cass_double_t tail_percentile,
+                                               cass_bool_t weight_inflight);
+
 /**
  * Sets/Appends whitelist hosts. The first call sets the whitelist hosts and
  * any subsequent calls appends additional hosts. Passing an empty string will
@@ -1841,6 +2044,37 @@ cass_cluster_set_constant_speculative_execution_policy(CassCluster* cluster,
                                                        cass_int64_t constant_delay_ms,
                                                        int max_speculative_executions);
 
+/**
+ * Enable speculative executions that adapt to the latencies of each host.
+ *
+ * A speculative execution is sent once the current host's response takes
+ * longer than the given percentile of that host's recent latencies. Hosts
+ * that haven't handled enough requests recently are not speculatively
+ * executed against.
+ *
+ * The extra load is limited by a budget shared by all requests: at most
+ * `max_hedge_ratio` speculative executions are sent per request on
+ * average (e.g. 0.05 allows for 5% more requests). Speculative executions
+ * that would exceed the budget are not sent.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] percentile The latency percentile used to delay speculative
+ * executions (e.g. 99.0). Must be greater than 0 and less than 100.
+ * @param[in] max_speculative_executions
+ * @param[in] max_hedge_ratio The maximum ratio of speculative executions
+ * to requests. Must be between 0 and 1.
+ * @return CASS_OK if successful, otherwise an error occurred
+ *
+ * @see cass_cluster_set_constant_speculative_execution_policy()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_percentile_speculative_execution_policy(CassCluster* cluster,
+                                                         cass_double_t percentile,
+                                                         int max_speculative_executions,
+                                                         cass_double_t max_hedge_ratio);
+
 /**
  * Disable speculative executions
  *
@@ -1911,6 +2145,269 @@ CASS_EXPORT CassError
 cass_cluster_set_no_compact(CassCluster* cluster,
                             cass_bool_t enabled);
 
+/**
+ * Enable external event loop mode. Instead of creating internal I/O threads
+ * the session's I/O, timers and future completions are processed on the
+ * application's thread whenever it runs the session's event loop using
+ * cass_session_event_loop_run(). The loop's file descriptor and timeout can
+ * be retrieved to integrate the session with an existing poll/epoll loop.
+ *
+ * <b>Note:</b> Futures must not be waited on from the thread that runs the
+ * loop because nothing else completes them; use callbacks or
+ * cass_future_ready() instead. The number of I/O threads is ignored and
+ * SIGPIPE is not blocked on the application's thread.
+ *
+ * <b>Default:</b> cass_false
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ * @return CASS_OK if successful, otherwise an error occurred
+ *
+ * @see cass_session_event_loop_fd()
+ * @see cass_session_event_loop_timeout()
+ * @see cass_session_event_loop_run()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_external_event_loop(CassCluster* cluster,
+                                     cass_bool_t enabled);
+
+/**
+ * Attach the session to an existing libuv loop owned by the application. This
+ * enables external event loop mode and the application runs the loop
+ * (e.g. using uv_run()) instead of the driver. The loop must outlive the
+ * session.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] loop A pointer to an initialized uv_loop_t
+ * @return CASS_OK if successful, otherwise an error occurred
+ *
+ * @see cass_cluster_set_external_event_loop()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_event_loop(CassCluster* cluster,
+                            void* loop);
+
+/**
+ * Enable session sharding. Each application thread is bound to a single I/O
+ * thread and the requests it executes are routed, written and completed
+ * (including future callbacks) on that I/O thread without passing through
+ * the session's thread. Each I/O thread uses its own connection pools and
+ * its own instance of the load balancing policy.
+ *
+ * This is intended for thread-per-core applications where the number of I/O
+ * threads matches the number of application threads. Threads are bound
+ * to I/O threads in a round-robin fashion on their first request unless
+ * cass_session_bind_thread() is used.
+ *
+ * <b>Important:</b> Token aware routing is enabled by default and sharding
+ * has no effect unless it's disabled using
+ * cass_cluster_set_token_aware_routing(). The token map is updated in place
+ * on the session's thread so it can't be shared with the I/O threads. When
+ * token aware routing is enabled (or an external event loop is used) the
+ * requests are routed through the session's thread and a warning is logged.
+ *
+ * <b>Default:</b> cass_false
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ * @return CASS_OK if successful, otherwise an error occurred
+ *
+ * @see cass_cluster_set_num_threads_io()
+ * @see cass_cluster_set_token_aware_routing()
+ * @see cass_session_bind_thread()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_session_sharding(CassCluster* cluster,
+                                  cass_bool_t enabled);
+
+/**
+ * Enables/Disables coalescing of identical reads. While an idempotent bound
+ * statement that returns rows is in flight, executing the same prepared
+ * statement with the same values (and the same consistency, page size and
+ * paging state) doesn't send another request. Its future is completed with
+ * the result (or error) of the request already in flight. This reduces the
+ * load on the cluster when many requests for the same hot keys are executed
+ * at once.
+ *
+ * <b>Note:</b> A coalesced request uses the settings (e.g. the timeout,
+ * retry policy and routing) of the request it's waiting for.
+ *
+ * <b>Default:</b> cass_false
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ * @return CASS_OK if successful, otherwise an error occurred
+ *
+ * @see cass_statement_set_is_idempotent()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_coalesce_reads(CassCluster* cluster,
+                                cass_bool_t enabled);
+
+/**
+ * Sets the size and TTL of a client-side cache of the rows returned by bound
+ * statements that return rows. Executing the same prepared statement with the
+ * same values (and the same consistency, page size and paging state) again
+ * before the TTL expires returns the cached result without sending a request.
+ * The least recently used results are evicted when the cache is full.
+ *
+ * Cached results are invalidated when the schema of their table changes and
+ * when a bound statement (or a batch of them) that writes to their table is
+ * executed through the same session. Simple statements that don't return
+ * rows invalidate the whole cache. Writes from other clients are only seen
+ * after the TTL expires.
+ *
+ * <b>Default:</b> 0 (disabled)
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] max_size_bytes The memory limit for the cached results. Use 0 to
+ * disable the cache.
+ * @param[in] ttl_ms How long results are cached for. Must be 0 if and only if
+ * max_size_bytes is 0.
+ * @return CASS_OK if successful, otherwise an error occurred
+ *
+ * @see cass_session_get_result_cache_metrics()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_result_cache(CassCluster* cluster,
+                              size_t max_size_bytes,
+                              cass_uint64_t ttl_ms);
+
+/**
+ * Sets a rate limit for the requests of a given priority executed by the
+ * session. The limit is a token bucket that allows bursts of up to "burst"
+ * requests. Requests over the limit are delayed, up to the maximum delay,
+ * then rejected with CASS_ERROR_LIB_RATE_LIMITED.
+ *
+ * <b>Default:</b> 0 requests per second (no limit)
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] priority
+ * @param[in] requests_per_second Use 0 to disable the limit.
+ * @param[in] burst The number of requests that can be executed at once
+ * (must be greater than 0).
+ * @return CASS_OK if successful, otherwise an error occurred
+ *
+ * @see cass_statement_set_priority()
+ * @see cass_cluster_set_rate_limit_max_delay()
+ * @see cass_session_get_rate_limiter_metrics()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_rate_limit(CassCluster* cluster,
+                            CassRequestPriority priority,
+                            cass_double_t requests_per_second,
+                            unsigned burst);
+
+/**
+ * Sets the longest a request can be delayed by a rate limit before it is
+ * rejected. A request is also rejected if the delay would take it past its
+ * deadline. The delay counts toward the request's timeout.
+ *
+ * <b>Default:</b> 1000 milliseconds
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] max_delay_ms Use 0 to reject requests over the limit instead
+ * of delaying them.
+ * @return CASS_OK if successful, otherwise an error occurred
+ *
+ * @see cass_cluster_set_rate_limit()
+ * @see cass_statement_set_deadline()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_rate_limit_max_delay(CassCluster* cluster,
+                                      cass_uint64_t max_delay_ms);
+
+/**
+ * Sets a rate limit for the requests sent to each host. A host that has
+ * reached its limit is skipped, like a busy host, and the request is sent to
+ * the next host in the query plan. If all the hosts are skipped then the
+ * request fails with CASS_ERROR_LIB_NO_HOSTS_AVAILABLE.
+ *
+ * <b>Default:</b> 0 requests per second (no limit)
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] requests_per_second Use 0 to disable the limit.
+ * @param[in] burst The number of requests that can be sent to a host at
+ * once (must be greater than 0).
+ * @return CASS_OK if successful, otherwise an error occurred
+ *
+ * @see cass_session_get_rate_limiter_metrics()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_host_rate_limit(CassCluster* cluster,
+                                 cass_double_t requests_per_second,
+                                 unsigned burst);
+
+/**
+ * Enables an adaptive limit on the number of requests in flight to each
+ * host. The limit grows while a host's latency is stable and shrinks as its
+ * latency rises or when requests to it time out (or it reports that it's
+ * overloaded). A request for a host that has reached its limit waits for a
+ * request to that host to complete, like when all its connections are busy.
+ *
+ * <b>Default:</b> 0 (disabled)
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] initial_limit The starting limit for each host. Use 0 to
+ * disable the limit.
+ * @param[in] min_limit The lowest the limit can go (must be greater than 0)
+ * @param[in] max_limit The highest the limit can go
+ * @return CASS_OK if successful, otherwise an error occurred
+ *
+ * @see cass_session_get_host_concurrency_metrics()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_adaptive_concurrency_limit(CassCluster* cluster,
+                                            unsigned initial_limit,
+                                            unsigned min_limit,
+                                            unsigned max_limit);
+
+/**
+ * Enables a circuit breaker for each host. A host's circuit opens when the
+ * ratio of its requests that time out or fail with a host error (overloaded
+ * or server error) within a second reaches the given ratio. Query plans skip
+ * the host while its circuit is open, so requests fail over to the next host
+ * without waiting for more timeouts. After the open time a single probe
+ * request is sent to the host: the circuit closes if it succeeds and opens
+ * again if it fails.
+ *
+ * <b>Default:</b> 0.0 (disabled)
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] failure_ratio A ratio between 0.0 and 1.0. Use 0.0 to disable
+ * the circuit breaker.
+ * @param[in] min_requests The number of requests needed within a second
+ * before the circuit can open (must be greater than 0).
+ * @param[in] open_time_ms How long the circuit stays open before it's probed
+ * (must be greater than 0).
+ * @return CASS_OK if successful, otherwise an error occurred
+ */
+CASS_EXPORT CassError
+cass_cluster_set_circuit_breaker(CassCluster* cluster,
+                                 cass_double_t failure_ratio,
+                                 unsigned min_requests,
+                                 cass_uint64_t open_time_ms);
+
 /***********************************************************************************
  *
  * Session
@@ -2048,8 +2545,8 @@ cass_session_prepare_n(CassSession* session,
  * Create a prepared statement from an existing statement.
  *
  * <b>Note:</b> Bound statements will inherit the keyspace, consistency,
- * serial consistency, request timeout and retry policy of the existing
- * statement.
+ * serial consistency, request timeout, deadline, retry policy and priority
+ * of the existing statement.
  *
  * @public @memberof CassSession
  *
@@ -2123,6 +2620,169 @@ CASS_EXPORT void
 cass_session_get_metrics(const CassSession* session,
                          CassMetrics* output);
 
+/**
+ * Gets a copy of this session's SSL metrics. Sessions negotiated with a
+ * host are cached and resumed when reconnecting to that host which avoids
+ * the cost of a full handshake (e.g. when many connections are
+ * re-established after a node restarts).
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output
+ */
+CASS_EXPORT void
+cass_session_get_ssl_metrics(const CassSession* session,
+                             CassSslMetrics* output);
+
+/**
+ * Gets a copy of this session's speculative execution metrics. The
+ * responses of cancelled executions are skipped without being decoded but
+ * they still use network bandwidth and stream IDs until they arrive.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output
+ *
+ * @see cass_cluster_set_percentile_speculative_execution_policy()
+ */
+CASS_EXPORT void
+cass_session_get_speculative_execution_metrics(const CassSession* session,
+                                               CassSpeculativeExecutionMetrics* output);
+
+/**
+ * Gets a copy of this session's request latencies for the requests of the
+ * given priority.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] priority
+ * @param[out] output
+ *
+ * @see cass_statement_set_priority()
+ */
+CASS_EXPORT void
+cass_session_get_request_priority_metrics(const CassSession* session,
+                                          CassRequestPriority priority,
+                                          CassRequestPriorityMetrics* output);
+
+/**
+ * Gets a copy of this session's rate limiter metrics.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output
+ *
+ * @see cass_cluster_set_rate_limit()
+ * @see cass_cluster_set_host_rate_limit()
+ */
+CASS_EXPORT void
+cass_session_get_rate_limiter_metrics(const CassSession* session,
+                                      CassRateLimiterMetrics* output);
+
+/**
+ * Gets a copy of a host's adaptive concurrency limit.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] host The host's IP address
+ * @param[out] output
+ * @return CASS_OK if successful, otherwise an error occurred (e.g.
+ * CASS_ERROR_LIB_HOST_RESOLUTION if the session doesn't know the host)
+ *
+ * @see cass_cluster_set_adaptive_concurrency_limit()
+ */
+CASS_EXPORT CassError
+cass_session_get_host_concurrency_metrics(const CassSession* session,
+                                          const char* host,
+                                          CassHostConcurrencyMetrics* output);
+
+/**
+ * Gets a snapshot of the session's result cache metrics. All of the
+ * metrics are zero if the cache is disabled.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output
+ *
+ * @see cass_cluster_set_result_cache()
+ */
+CASS_EXPORT void
+cass_session_get_result_cache_metrics(const CassSession* session,
+                                      CassResultCacheMetrics* output);
+
+/**
+ * Gets the file descriptor of the session's event loop. It becomes readable
+ * when the loop has pending I/O and can be added to an application's own
+ * poll/epoll set.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @return The file descriptor or -1 if the session isn't using an external
+ * event loop (or it's not supported on the platform).
+ *
+ * @see cass_cluster_set_external_event_loop()
+ */
+CASS_EXPORT int
+cass_session_event_loop_fd(CassSession* session);
+
+/**
+ * Gets the poll timeout (in milliseconds) for the session's event loop. This
+ * is the time until the next timer is due.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @return The timeout in milliseconds, 0 if the loop should be run without
+ * blocking, or -1 for no timeout.
+ *
+ * @see cass_cluster_set_external_event_loop()
+ */
+CASS_EXPORT int
+cass_session_event_loop_timeout(CassSession* session);
+
+/**
+ * Runs a single iteration of the session's event loop on the calling thread.
+ * This processes pending I/O, expired timers and completes futures (running
+ * their callbacks).
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] wait If cass_true then block until there is at least one event
+ * to process, otherwise only process events that are already pending.
+ * @return CASS_OK if successful, otherwise an error occurred
+ *
+ * @see cass_cluster_set_external_event_loop()
+ */
+CASS_EXPORT CassError
+cass_session_event_loop_run(CassSession* session,
+                            cass_bool_t wait);
+
+/**
+ * Binds the calling thread to one of the session's I/O threads. All requests
+ * executed by the calling thread are handled by that I/O thread. This only
+ * has an effect when session sharding is enabled.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] shard The index of the I/O thread (wrapped using the number of
+ * I/O threads).
+ * @return CASS_OK if successful, otherwise an error occurred
+ *
+ * @see cass_cluster_set_session_sharding()
+ */
+CASS_EXPORT CassError
+cass_session_bind_thread(CassSession* session,
+                         unsigned shard);
+
 /***********************************************************************************
  *
  * Schema Metadata
@@ -3553,6 +4213,30 @@ CASS_EXPORT void
 cass_ssl_set_verify_flags(CassSsl* ssl,
                           int flags);
 
+/**
+ * Enables kernel TLS (kTLS) offload. After the handshake has completed and
+ * the peer has been verified the session's keys are installed on the socket
+ * and encryption (and, for TLS 1.2, decryption) is done by the kernel using
+ * plain socket writes and reads. Connections fall back to encrypting in the
+ * driver if the kernel or the negotiated cipher doesn't support kTLS.
+ *
+ * <b>Note:</b> Only available on Linux when built with OpenSSL 3.0 or later.
+ * Decryption remains in the driver for TLS 1.3 and TLS key updates are not
+ * supported once the keys have been handed to the kernel.
+ *
+ * <b>Default:</b> cass_false (disabled).
+ *
+ * @public @memberof CassSsl
+ *
+ * @param[in] ssl
+ * @param[in] enabled
+ * @return CASS_OK if successful, otherwise an error occurred
+ * (CASS_ERROR_LIB_NOT_IMPLEMENTED if kTLS isn't supported by this build)
+ */
+CASS_EXPORT CassError
+cass_ssl_set_kernel_offload(CassSsl* ssl,
+                            cass_bool_t enabled);
+
 /**
  * Set client-side certificate chain. This is used to authenticate
  * the client on the server-side. This should contain the entire
@@ -3819,6 +4503,69 @@ CASS_EXPORT cass_bool_t
 cass_future_wait_timed(CassFuture* future,
                        cass_duration_t timeout_us);
 
+/**
+ * Wait for any of the futures to be set with either a result or error.
+ *
+ * <b>Important:</b> Do not wait in a future callback. Waiting in a future
+ * callback will cause a deadlock.
+ *
+ * @public @memberof CassFuture
+ *
+ * @param[in] futures
+ * @param[in] count The number of futures
+ * @return The index of a future that's set (or count if count is 0)
+ */
+CASS_EXPORT size_t
+cass_future_wait_any(CassFuture** futures,
+                     size_t count);
+
+/**
+ * Wait for any of the futures to be set or timeout.
+ *
+ * @public @memberof CassFuture
+ *
+ * @param[in] futures
+ * @param[in] count The number of futures
+ * @param[in] timeout_us wait time in microseconds
+ * @param[out] index The index of a future that's set
+ * @return false if returned due to timeout
+ */
+CASS_EXPORT cass_bool_t
+cass_future_wait_any_timed(CassFuture** futures,
+                           size_t count,
+                           cass_duration_t timeout_us,
+                           size_t* index);
+
+/**
+ * Wait for all of the futures to be set with either a result or error.
+ *
+ * <b>Important:</b> Do not wait in a future callback. Waiting in a future
+ * callback will cause a deadlock.
+ *
+ * @public @memberof CassFuture
+ *
+ * @param[in] futures
+ * @param[in] count The number of futures
+ */
+CASS_EXPORT void
+cass_future_wait_all(CassFuture** futures,
+                     size_t count);
+
+/**
+ * Wait for all of the futures to be set or timeout.
+ *
+ * @public @memberof CassFuture
+ *
+ * @param[in] futures
+ * @param[in] count The number of futures
+ * @param[in] timeout_us wait time in microseconds
+ * @return false if returned due to timeout
+ */
+CASS_EXPORT cass_bool_t
+cass_future_wait_all_timed(CassFuture** futures,
+                           size_t count,
+                           cass_duration_t timeout_us);
+
 /**
  * Gets the result of a successful future. If the future is not ready this method will
  * wait for the future to be set.
@@ -3934,6 +4681,208 @@ cass_future_custom_payload_item(CassFuture* future,
                                 const cass_byte_t** value,
                                 size_t* value_size);
 
+/***********************************************************************************
+ *
+ * Completion Queue
+ *
+ ***********************************************************************************/
+
+/**
+ * Creates a new completion queue. Completion queues can be used to
+ * process the results of many requests in batches from a single thread
+ * instead of waiting on each future or running a callback for each
+ * future on the driver's I/O threads.
+ *
+ * @public @memberof CassCompletionQueue
+ *
+ * @return Returns a completion queue that must be freed.
+ *
+ * @see cass_completion_queue_free()
+ */
+CASS_EXPORT CassCompletionQueue*
+cass_completion_queue_new();
+
+/**
+ * Frees a completion queue instance. Futures still attached to the queue
+ * keep it alive until they're set. Completions that were never removed
+ * from the queue are freed.
+ *
+ * @public @memberof CassCompletionQueue
+ *
+ * @param[in] queue
+ */
+CASS_EXPORT void
+cass_completion_queue_free(CassCompletionQueue* queue);
+
+/**
+ * Adds a future to a completion queue. The future is added to the queue
+ * once it's set (immediately if it's already set). The queue takes its
+ * own reference to the future so the future can be freed after it's
+ * added.
+ *
+ * A future can either be added to a completion queue or have a callback.
+ *
+ * @public @memberof CassCompletionQueue
+ *
+ * @param[in] queue
+ * @param[in] future
+ * @param[in] data User defined data returned with the completion
+ * @return CASS_OK if successful, otherwise an error occurred (e.g.
+ * CASS_ERROR_LIB_CALLBACK_ALREADY_SET if the future already has a callback
+ * or a completion queue)
+ *
+ * @see cass_future_set_callback()
+ */
+CASS_EXPORT CassError
+cass_completion_queue_add(CassCompletionQueue* queue,
+                          CassFuture* future,
+                          void* data);
+
+/**
+ * Removes up to count completed futures from the queue. If the queue is
+ * empty this waits until a future is completed or the timeout expires.
+ * The futures of the removed completions must be freed.
+ *
+ * @public @memberof CassCompletionQueue
+ *
+ * @param[in] queue
+ * @param[out] completions An array with room for at least count completions
+ * @param[in] count
+ * @param[in] timeout_us The time to wait for the first completion in
+ * microseconds. Use 0 to return immediately.
+ * @return The number of completions removed (0 if the timeout expired)
+ */
+CASS_EXPORT size_t
+cass_completion_queue_next_n(CassCompletionQueue* queue,
+                             CassCompletion* completions,
+                             size_t count,
+                             cass_duration_t timeout_us);
+
+/***********************************************************************************
+ *
+ * Pager
+ *
+ ***********************************************************************************/
+
+/**
+ * Creates a new pager for a statement. A pager fetches the pages of the
+ * statement's result automatically: the request for the next page is sent
+ * as soon as the previous page arrives, so the round trip for a page
+ * overlaps the processing of the pages before it.
+ *
+ * Only one page can be requested at a time because each request needs the
+ * previous page's paging state. Prefetching stops when the prefetch depth
+ * is reached or the pages not yet taken use more than the memory cap.
+ *
+ * The statement is copied so it can be freed or reused after this call.
+ * The session must outlive the pager.
+ *
+ * <b>Example:</b>
+ *
+ * @code{.c}
+ * CassPager* pager = cass_pager_new(session, statement);
+ * cass_pager_set_prefetch_depth(pager, 2);
+ *
+ * while (cass_pager_has_more_pages(pager)) {
+ *   CassFuture* future = cass_pager_next_page(pager);
+ *   const CassResult* result = cass_future_get_result(future);
+ *   if (result != NULL) {
+ *     // Process the page
+ *     cass_result_free(result);
+ *   }
+ *   cass_future_free(future);
+ * }
+ *
+ * cass_pager_free(pager);
+ * @endcode
+ *
+ * @public @memberof CassPager
+ *
+ * @param[in] session
+ * @param[in] statement
+ * @return Returns a pager that must be freed.
+ *
+ * @see cass_pager_free()
+ */
+CASS_EXPORT CassPager*
+cass_pager_new(CassSession* session,
+               const CassStatement* statement);
+
+/**
+ * Frees a pager instance. Prefetched pages that haven't been taken are
+ * dropped and no new pages are requested. Futures still waiting for a page
+ * that wasn't requested yet are set with the error
+ * CASS_ERROR_LIB_NO_PAGING_STATE.
+ *
+ * @public @memberof CassPager
+ *
+ * @param[in] pager
+ */
+CASS_EXPORT void
+cass_pager_free(CassPager* pager);
+
+/**
+ * Sets the number of pages that are buffered ahead of the application.
+ * Another page is requested while fewer pages are buffered. Use 0 to only
+ * request a page when cass_pager_next_page() is called (the same as manual
+ * paging).
+ *
+ * <b>Default:</b> 1
+ *
+ * @public @memberof CassPager
+ *
+ * @param[in] pager
+ * @param[in] prefetch_depth
+ */
+CASS_EXPORT void
+cass_pager_set_prefetch_depth(CassPager* pager,
+                              unsigned prefetch_depth);
+
+/**
+ * Sets the maximum number of bytes used by the pages that were prefetched
+ * but not taken yet. No more pages are prefetched once it's reached. A page
+ * is always requested when the application asks for one. Use 0 for no cap.
+ *
+ * <b>Default:</b> 64 MB
+ *
+ * @public @memberof CassPager
+ *
+ * @param[in] pager
+ * @param[in] max_buffered_bytes
+ */
+CASS_EXPORT void
+cass_pager_set_max_buffered_bytes(CassPager* pager,
+                                  size_t max_buffered_bytes);
+
+/**
+ * Determines if there are more pages. The result is only final once the
+ * page returned by the last call to cass_pager_next_page() has been set.
+ * Paging stops after a page fails.
+ *
+ * @public @memberof CassPager
+ *
+ * @param[in] pager
+ * @return cass_true if there are more pages, otherwise cass_false.
+ */
+CASS_EXPORT cass_bool_t
+cass_pager_has_more_pages(CassPager* pager);
+
+/**
+ * Gets a future for the next page. The future is set with the page's
+ * result or error. If there are no more pages, the future is set with the
+ * error CASS_ERROR_LIB_NO_PAGING_STATE. This can be called again before the
+ * previous page's future is set; the futures are set in page order.
+ *
+ * @public @memberof CassPager
+ *
+ * @param[in] pager
+ * @return A future that must be freed.
+ *
+ * @see cass_future_get_result()
+ */
+CASS_EXPORT CassFuture*
+cass_pager_next_page(CassPager* pager);
+
 /***********************************************************************************
  *
  * Statement
@@ -3970,22 +4919,85 @@ cass_statement_new(const char* query,
  * @see cass_statement_new()
  */
 CASS_EXPORT CassStatement*
-cass_statement_new_n(const char* query,
-                     size_t query_length,
-                     size_t parameter_count);
+cass_statement_new_n(const char* query,
+                     size_t query_length,
+                     size_t parameter_count);
+
+/**
+ * Clear and/or resize the statement's parameters.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] count
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_statement_reset_parameters(CassStatement* statement,
+                                 size_t count);
+
+/**
+ * Creates a copy of a statement with the same settings and bound values.
+ * This is much cheaper than creating and binding a new statement because
+ * the query (or prepared ID) is shared and, with contiguous values, the
+ * encoded values are shared until either statement is modified.
+ *
+ * A statement can be used as a template that's rebound for every row while
+ * previous rows are still being executed by executing a clone of the
+ * template:
+ *
+ * @code{.c}
+ * CassStatement* prototype = cass_prepared_bind(prepared);
+ * cass_statement_set_contiguous_values(prototype, cass_true);
+ *
+ * for (...) {
+ *   cass_statement_bind_int32(prototype, 0, value);
+ *   ...
+ *   CassStatement* statement = cass_statement_clone(prototype);
+ *   CassFuture* future = cass_session_execute(session, statement);
+ *   cass_statement_free(statement);
+ *   ...
+ * }
+ * @endcode
+ *
+ * Rebinding the template only copies its encoded values if they're still
+ * used by a clone that's being executed.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @return Returns a statement that must be freed.
+ *
+ * @see cass_statement_free()
+ * @see cass_statement_set_contiguous_values()
+ */
+CASS_EXPORT CassStatement*
+cass_statement_clone(const CassStatement* statement);
 
 /**
- * Clear and/or resize the statement's parameters.
+ * Sets whether the statement's values are encoded into a single contiguous
+ * buffer as they're bound. Each value is otherwise kept as a separate
+ * buffer until the statement is executed. This avoids allocating a buffer
+ * for each value of statements with many values (e.g. wide rows) and the
+ * values are written to the request as a single buffer. A value that's
+ * rebound with a value of the same size (e.g. a fixed size type) is
+ * overwritten in place. Values that are already bound are kept when the
+ * setting is changed.
+ *
+ * <b>Note:</b> Collections are encoded when they're bound so items that are
+ * appended to a collection after it's bound are not included.
+ *
+ * <b>Default:</b> cass_false
  *
  * @public @memberof CassStatement
  *
  * @param[in] statement
- * @param[in] count
+ * @param[in] enabled
  * @return CASS_OK if successful, otherwise an error occurred.
  */
 CASS_EXPORT CassError
-cass_statement_reset_parameters(CassStatement* statement,
-                                 size_t count);
+cass_statement_set_contiguous_values(CassStatement* statement,
+                                     cass_bool_t enabled);
 
 /**
  * Frees a statement instance. Statements can be immediately freed after
@@ -4177,6 +5189,33 @@ CASS_EXPORT CassError
 cass_statement_set_request_timeout(CassStatement* statement,
                                    cass_uint64_t timeout_ms);
 
+/**
+ * Sets the statement's deadline. Unlike the request timeout, which only
+ * starts once the request is sent to a node, the deadline is fixed when the
+ * statement is executed and includes the time spent waiting in the driver's
+ * queues and for a connection. A request that is past its deadline is failed
+ * with CASS_ERROR_LIB_REQUEST_TIMED_OUT without being sent so that an
+ * overloaded client sheds stale requests instead of adding to the overload.
+ * It also limits the request timeout of a request that has been sent.
+ *
+ * <b>Note:</b> Requests that are dropped before being sent are counted as
+ * pending request timeouts in CassMetrics.
+ *
+ * <b>Default:</b> CASS_UINT64_MAX (disabled)
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] deadline_ms Deadline in milliseconds from the call to
+ * cass_session_execute(). Use CASS_UINT64_MAX to disable.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_set_request_timeout()
+ */
+CASS_EXPORT CassError
+cass_statement_set_deadline(CassStatement* statement,
+                            cass_uint64_t deadline_ms);
+
 /**
  * Sets whether the statement is idempotent. Idempotent statements are able to be
  * automatically retried after timeouts/errors and can be speculatively executed.
@@ -4193,6 +5232,26 @@ CASS_EXPORT CassError
 cass_statement_set_is_idempotent(CassStatement* statement,
                                  cass_bool_t is_idempotent);
 
+/**
+ * Sets the statement's priority. Requests with a higher priority are started
+ * before, wait for a connection ahead of and are written to the socket
+ * ahead of requests with a lower priority. This keeps bulk, background work
+ * from delaying interactive requests that share the same connections.
+ *
+ * <b>Default:</b> CASS_REQUEST_PRIORITY_NORMAL
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] priority
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_session_get_request_priority_metrics()
+ */
+CASS_EXPORT CassError
+cass_statement_set_priority(CassStatement* statement,
+                            CassRequestPriority priority);
+
 /**
  * Sets the statement's retry policy.
  *
@@ -4782,6 +5841,54 @@ cass_statement_bind_string_by_name_n(CassStatement* statement,
                                      const char* value,
                                      size_t value_length);
 
+/**
+ * Binds an "ascii", "text" or "varchar" to a query or bound statement at
+ * the specified index without copying the value.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] index
+ * @param[in] value
+ * @param[in] value_length
+ * @param[in] release_callback
+ * @param[in] release_data
+ * @return same as cass_statement_bind_bytes_external()
+ *
+ * @see cass_statement_bind_bytes_external()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_string_external(CassStatement* statement,
+                                    size_t index,
+                                    const char* value,
+                                    size_t value_length,
+                                    CassReleaseCallback release_callback,
+                                    void* release_data);
+
+/**
+ * Same as cass_statement_bind_string_external(), but binds the value to all
+ * the values with the specified name.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] name
+ * @param[in] value
+ * @param[in] value_length
+ * @param[in] release_callback
+ * @param[in] release_data
+ * @return same as cass_statement_bind_bytes_external()
+ *
+ * @see cass_statement_bind_bytes_external()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_string_by_name_external(CassStatement* statement,
+                                            const char* name,
+                                            const char* value,
+                                            size_t value_length,
+                                            CassReleaseCallback release_callback,
+                                            void* release_data);
+
 /**
  * Binds a "blob", "varint" or "custom" to a query or bound statement at the specified index.
  *
@@ -4844,6 +5951,64 @@ cass_statement_bind_bytes_by_name_n(CassStatement* statement,
                                     const cass_byte_t* value,
                                     size_t value_size);
 
+/**
+ * Binds a "blob", "varint" or "custom" to a query or bound statement at the
+ * specified index without copying the value. The memory must remain valid
+ * and unmodified until the release callback is called.
+ *
+ * The release callback is called exactly once when the driver no longer
+ * references the memory: after the statement (and any clones) have been
+ * freed or the value has been rebound, and every request that used the
+ * statement has been written to the socket or has failed. The callback is
+ * also called if an error is returned and it's called before this function
+ * returns for small values (16 bytes or less) because those are copied.
+ * The callback can be called on any thread, including the driver's I/O
+ * threads, so it must not block.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] index
+ * @param[in] value
+ * @param[in] value_size
+ * @param[in] release_callback A callback that releases the memory (can be NULL).
+ * @param[in] release_data An opaque data object passed to the callback.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_bind_bytes()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_bytes_external(CassStatement* statement,
+                                   size_t index,
+                                   const cass_byte_t* value,
+                                   size_t value_size,
+                                   CassReleaseCallback release_callback,
+                                   void* release_data);
+
+/**
+ * Same as cass_statement_bind_bytes_external(), but binds the value to all
+ * the values with the specified name.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] name
+ * @param[in] value
+ * @param[in] value_size
+ * @param[in] release_callback
+ * @param[in] release_data
+ * @return same as cass_statement_bind_bytes_external()
+ *
+ * @see cass_statement_bind_bytes_external()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_bytes_by_name_external(CassStatement* statement,
+                                           const char* name,
+                                           const cass_byte_t* value,
+                                           size_t value_size,
+                                           CassReleaseCallback release_callback,
+                                           void* release_data);
+
 /**
  * Binds a "custom" to a query or bound statement at the specified index.
  *
@@ -5572,6 +6737,24 @@ CASS_EXPORT CassError
 cass_batch_set_request_timeout(CassBatch* batch,
                                cass_uint64_t timeout_ms);
 
+/**
+ * Sets the batch's deadline.
+ *
+ * <b>Default:</b> CASS_UINT64_MAX (disabled)
+ *
+ * @public @memberof CassBatch
+ *
+ * @param[in] batch
+ * @param[in] deadline_ms Deadline in milliseconds from the call to
+ * cass_session_execute_batch(). Use CASS_UINT64_MAX to disable.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_set_deadline()
+ */
+CASS_EXPORT CassError
+cass_batch_set_deadline(CassBatch* batch,
+                        cass_uint64_t deadline_ms);
+
 /**
  * Sets whether the statements in a batch are idempotent. Idempotent batches
  * are able to be automatically retried after timeouts/errors and can be
@@ -5589,6 +6772,23 @@ CASS_EXPORT CassError
 cass_batch_set_is_idempotent(CassBatch* batch,
                              cass_bool_t is_idempotent);
 
+/**
+ * Sets the batch's priority.
+ *
+ * <b>Default:</b> CASS_REQUEST_PRIORITY_NORMAL
+ *
+ * @public @memberof CassBatch
+ *
+ * @param[in] batch
+ * @param[in] priority
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_set_priority()
+ */
+CASS_EXPORT CassError
+cass_batch_set_priority(CassBatch* batch,
+                        CassRequestPriority priority);
+
 /**
  * Sets the batch's retry policy.
  *
@@ -6430,6 +7630,93 @@ CASS_EXPORT CassError
 cass_collection_append_user_type(CassCollection* collection,
                                  const CassUserType* value);
 
+/**
+ * Appends an array of "int" values to the collection. The values are
+ * converted and encoded in a single pass, which is much faster than
+ * appending them one at a time.
+ *
+ * @public @memberof CassCollection
+ *
+ * @param[in] collection
+ * @param[in] values
+ * @param[in] count The number of values in the array.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_collection_append_int32()
+ */
+CASS_EXPORT CassError
+cass_collection_append_int32_array(CassCollection* collection,
+                                   const cass_int32_t* values,
+                                   size_t count);
+
+/**
+ * Appends an array of "bigint", "counter", "timestamp" or "time" values to the collection.
+ *
+ * @public @memberof CassCollection
+ *
+ * @param[in] collection
+ * @param[in] values
+ * @param[in] count
+ * @return same as cass_collection_append_int32_array()
+ *
+ * @see cass_collection_append_int32_array()
+ */
+CASS_EXPORT CassError
+cass_collection_append_int64_array(CassCollection* collection,
+                                   const cass_int64_t* values,
+                                   size_t count);
+
+/**
+ * Appends an array of "float" values to the collection.
+ *
+ * @public @memberof CassCollection
+ *
+ * @param[in] collection
+ * @param[in] values
+ * @param[in] count
+ * @return same as cass_collection_append_int32_array()
+ *
+ * @see cass_collection_append_int32_array()
+ */
+CASS_EXPORT CassError
+cass_collection_append_float_array(CassCollection* collection,
+                                   const cass_float_t* values,
+                                   size_t count);
+
+/**
+ * Appends an array of "double" values to the collection.
+ *
+ * @public @memberof CassCollection
+ *
+ * @param[in] collection
+ * @param[in] values
+ * @param[in] count
+ * @return same as cass_collection_append_int32_array()
+ *
+ * @see cass_collection_append_int32_array()
+ */
+CASS_EXPORT CassError
+cass_collection_append_double_array(CassCollection* collection,
+                                    const cass_double_t* values,
+                                    size_t count);
+
+/**
+ * Appends an array of "uuid" or "timeuuid" values to the collection.
+ *
+ * @public @memberof CassCollection
+ *
+ * @param[in] collection
+ * @param[in] values
+ * @param[in] count
+ * @return same as cass_collection_append_int32_array()
+ *
+ * @see cass_collection_append_int32_array()
+ */
+CASS_EXPORT CassError
+cass_collection_append_uuid_array(CassCollection* collection,
+                                  const CassUuid* values,
+                                  size_t count);
+
 /***********************************************************************************
  *
  * Tuple
@@ -6873,6 +8160,116 @@ cass_tuple_set_user_type(CassTuple* tuple,
                          size_t index,
                          const CassUserType* value);
 
+/**
+ * Sets consecutive "int" values in a tuple starting at the specified
+ * index. Nothing is set if an error occurs.
+ *
+ * @cassandra{2.1+}
+ *
+ * @public @memberof CassTuple
+ *
+ * @param[in] tuple
+ * @param[in] index The index of the first value.
+ * @param[in] values
+ * @param[in] count The number of values in the array.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_tuple_set_int32()
+ */
+CASS_EXPORT CassError
+cass_tuple_set_int32_array(CassTuple* tuple,
+                           size_t index,
+                           const cass_int32_t* values,
+                           size_t count);
+
+/**
+ * Sets consecutive "bigint", "counter", "timestamp" or "time" values in a tuple starting at the specified
+ * index.
+ *
+ * @cassandra{2.1+}
+ *
+ * @public @memberof CassTuple
+ *
+ * @param[in] tuple
+ * @param[in] index
+ * @param[in] values
+ * @param[in] count
+ * @return same as cass_tuple_set_int32_array()
+ *
+ * @see cass_tuple_set_int32_array()
+ */
+CASS_EXPORT CassError
+cass_tuple_set_int64_array(CassTuple* tuple,
+                           size_t index,
+                           const cass_int64_t* values,
+                           size_t count);
+
+/**
+ * Sets consecutive "float" values in a tuple starting at the specified
+ * index.
+ *
+ * @cassandra{2.1+}
+ *
+ * @public @memberof CassTuple
+ *
+ * @param[in] tuple
+ * @param[in] index
+ * @param[in] values
+ * @param[in] count
+ * @return same as cass_tuple_set_int32_array()
+ *
+ * @see cass_tuple_set_int32_array()
+ */
+CASS_EXPORT CassError
+cass_tuple_set_float_array(CassTuple* tuple,
+                           size_t index,
+                           const cass_float_t* values,
+                           size_t count);
+
+/**
+ * Sets consecutive "double" values in a tuple starting at the specified
+ * index.
+ *
+ * @cassandra{2.1+}
+ *
+ * @public @memberof CassTuple
+ *
+ * @param[in] tuple
+ * @param[in] index
+ * @param[in] values
+ * @param[in] count
+ * @return same as cass_tuple_set_int32_array()
+ *
+ * @see cass_tuple_set_int32_array()
+ */
+CASS_EXPORT CassError
+cass_tuple_set_double_array(CassTuple* tuple,
+                            size_t index,
+                            const cass_double_t* values,
+                            size_t count);
+
+/**
+ * Sets consecutive "uuid" or "timeuuid" values in a tuple starting at the specified
+ * index.
+ *
+ * @cassandra{2.1+}
+ *
+ * @public @memberof CassTuple
+ *
+ * @param[in] tuple
+ * @param[in] index
+ * @param[in] values
+ * @param[in] count
+ * @return same as cass_tuple_set_int32_array()
+ *
+ * @see cass_tuple_set_int32_array()
+ */
+CASS_EXPORT CassError
+cass_tuple_set_uuid_array(CassTuple* tuple,
+                          size_t index,
+                          const CassUuid* values,
+                          size_t count);
+
 /***********************************************************************************
  *
  * User defined type
@@ -10071,6 +11468,70 @@ CASS_DEPRECATED(cass_log_set_queue_size(size_t queue_size));
 CASS_EXPORT const char*
 cass_log_level_string(CassLogLevel log_level);
 
+/***********************************************************************************
+ *
+ * Allocator
+ *
+ ***********************************************************************************/
+
+/**
+ * Use a custom memory allocator for the driver's internal allocations
+ * (e.g. requests, responses, buffers, metadata and internal hash maps).
+ * Where supported (libuv 1.6.0 and later), libuv's allocations are
+ * also routed through these functions.
+ *
+ * <b>Note:</b> This *MUST* be called before any other driver function
+ * (and before libuv is used by the application) because memory must be
+ * freed by the same allocator that allocated it. Only the driver's own
+ * allocations are affected; the driver never replaces the global
+ * operator new or malloc(). libuv's allocator is process-wide so any
+ * libuv allocations made by the application also use these functions.
+ *
+ * Installing custom functions also enables cass_alloc_get_allocated_bytes(),
+ * which adds a small size header to each allocation. To track the default
+ * allocator pass the C standard library's functions.
+ *
+ * <b>Default:</b> The C standard library's malloc(), realloc() and free()
+ * (untracked).
+ *
+ * @param[in] malloc_func A malloc function. Passing NULL for any of the
+ * functions restores the defaults.
+ * @param[in] realloc_func A realloc function
+ * @param[in] free_func A free function
+ *
+ * @see cass_alloc_get_allocated_bytes()
+ */
+CASS_EXPORT void
+cass_alloc_set_functions(CassMallocFunction malloc_func,
+                         CassReallocFunction realloc_func,
+                         CassFreeFunction free_func);
+
+/**
+ * Gets the number of bytes currently allocated by the driver using its
+ * allocator. This does not include the allocator's own overhead or
+ * libuv's allocations. Allocations are only tracked when custom functions
+ * are installed using cass_alloc_set_functions().
+ *
+ * @return The number of bytes allocated or 0 if allocations aren't
+ * tracked.
+ *
+ * @see cass_alloc_set_functions()
+ */
+CASS_EXPORT cass_int64_t
+cass_alloc_get_allocated_bytes();
+
+/**
+ * Gets a snapshot of the object pool's metrics. Per-request objects
+ * (e.g. request handlers, futures and query plans) are recycled through
+ * per-thread pools; a miss calls the driver's allocator.
+ *
+ * @param[out] output
+ *
+ * @see cass_alloc_set_functions()
+ */
+CASS_EXPORT void
+cass_alloc_get_object_pool_metrics(CassObjectPoolMetrics* output);
+
 /***********************************************************************************
  *
  * Inet
@@ -0,0 +1,323 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASSANDRA_COROUTINE_H_INCLUDED__
+#define __CASSANDRA_COROUTINE_H_INCLUDED__
+
+/**
+ * A header-only C++20 coroutine layer over the driver's futures.
+ *
+ * Awaiting an operation attaches a future callback that resumes the
+ * coroutine. No memory is allocated for the await (the awaitable lives in
+ * the coroutine's frame) and, by default, the coroutine is resumed directly
+ * on the driver's I/O thread that completed the request. An executor can be
+ * provided to resume the coroutine somewhere else (e.g. a thread pool).
+ *
+ * <b>Important:</b> Coroutines resumed on an I/O thread must not block
+ * (e.g. wait on a future) or they'll stall the requests handled by that
+ * thread. Use an executor for long running work.
+ *
+ * @code
+ * cass::coro::Task query(CassSession* session, const CassPrepared* prepared) {
+ *   cass::coro::Statement statement(cass_prepared_bind(prepared));
+ *   cass::coro::Result result = co_await cass::coro::execute(session, statement.get());
+ *   if (result.error_code() != CASS_OK) { ... }
+ * }
+ * @endcode
+ */
+
+#include "cassandra.h"
+
+#if !defined(__cplusplus) || __cplusplus < 202002L
+#error "cassandra_coroutine.h requires C++20"
+#endif
+
+#include <coroutine>
+#include <exception>
+#include <string>
+#include <utility>
+
+namespace cass {
+namespace coro {
+
+/**
+ * Resumes the coroutine on the thread that completed the future.
+ */
+struct InlineExecutor {
+  void operator()(std::coroutine_handle<> handle) const { handle.resume(); }
+};
+
+/**
+ * An owned statement.
+ */
+class Statement {
+public:
+  explicit Statement(CassStatement* statement = nullptr)
+    : statement_(statement) { }
+
+  Statement(Statement&& other) noexcept
+    : statement_(std::exchange(other.statement_, nullptr)) { }
+
+  Statement& operator=(Statement&& other) noexcept {
+    std::swap(statement_, other.statement_);
+    return *this;
+  }
+
+  ~Statement() {
+    if (statement_ != nullptr) cass_statement_free(statement_);
+  }
+
+  CassStatement* get() const { return statement_; }
+
+private:
+  CassStatement* statement_;
+};
+
+/**
+ * The outcome of an awaited operation: an error code and message, the
+ * operation's value (a result or prepared statement) or both.
+ */
+template <class T, void (*Free)(const T*)>
+class Outcome {
+public:
+  Outcome()
+    : error_code_(CASS_OK)
+    , value_(nullptr) { }
+
+  Outcome(CassError error_code, std::string error_message, const T* value)
+    : error_code_(error_code)
+    , error_message_(std::move(error_message))
+    , value_(value) { }
+
+  Outcome(Outcome&& other) noexcept
+    : error_code_(other.error_code_)
+    , error_message_(std::move(other.error_message_))
+    , value_(std::exchange(other.value_, nullptr)) { }
+
+  Outcome& operator=(Outcome&& other) noexcept {
+    error_code_ = other.error_code_;
+    error_message_ = std::move(other.error_message_);
+    std::swap(value_, other.value_);
+    return *this;
+  }
+
+  ~Outcome() {
+    if (value_ != nullptr) Free(value_);
+  }
+
+  CassError error_code() const { return error_code_; }
+  const std::string& error_message() const { return error_message_; }
+  const T* get() const { return value_; }
+  explicit operator bool() const { return error_code_ == CASS_OK; }
+
+private:
+  CassError error_code_;
+  std::string error_message_;
+  const T* value_;
+};
+
+typedef Outcome<CassResult, cass_result_free> Result;
+typedef Outcome<CassPrepared, cass_prepared_free> Prepared;
+
+namespace internal {
+
+inline std::string error_message(CassFuture* future) {
+  const char* message;
+  size_t message_length;
+  cass_future_error_message(future, &message, &message_length);
+  return std::string(message, message_length);
+}
+
+struct GetResult {
+  static Result get(CassFuture* future) {
+    return Result(cass_future_error_code(future), error_message(future),
+                  cass_future_get_result(future));
+  }
+};
+
+struct GetPrepared {
+  static Prepared get(CassFuture* future) {
+    return Prepared(cass_future_error_code(future), error_message(future),
+                    cass_future_get_prepared(future));
+  }
+};
+
+} // namespace internal
+
+/**
+ * An awaitable that owns a driver future. Awaiting it suspends the
+ * coroutine until the future is set and returns its outcome.
+ */
+template <class Get, class Executor = InlineExecutor>
+class FutureAwaitable {
+public:
+  FutureAwaitable(CassFuture* future, Executor executor = Executor())
+    : future_(future)
+    , executor_(std::move(executor)) { }
+
+  FutureAwaitable(FutureAwaitable&& other) noexcept
+    : future_(std::exchange(other.future_, nullptr))
+    , executor_(std::move(other.executor_)) { }
+
+  FutureAwaitable(const FutureAwaitable&) = delete;
+  FutureAwaitable& operator=(const FutureAwaitable&) = delete;
+
+  ~FutureAwaitable() {
+    if (future_ != nullptr) cass_future_free(future_);
+  }
+
+  bool await_ready() const { return cass_future_ready(future_) == cass_true; }
+
+  bool await_suspend(std::coroutine_handle<> handle) {
+    handle_ = handle;
+    // The callback runs immediately if the future was set after
+    // await_ready(). Nothing in the awaitable can be used after this call
+    // because the coroutine might have already been resumed.
+    return cass_future_set_callback(future_, on_ready, this) == CASS_OK;
+  }
+
+  decltype(Get::get(nullptr)) await_resume() {
+    return Get::get(future_);
+  }
+
+private:
+  static void on_ready(CassFuture*, void* data) {
+    FutureAwaitable* awaitable = static_cast<FutureAwaitable*>(data);
+    awaitable->executor_(awaitable->handle_);
+  }
+
+private:
+  CassFuture* future_;
+  Executor executor_;
+  std::coroutine_handle<> handle_;
+};
+
+/**
+ * Executes a statement. Awaiting the operation returns a Result.
+ */
+template <class Executor = InlineExecutor>
+FutureAwaitable<internal::GetResult, Executor>
+execute(CassSession* session, const CassStatement* statement,
+        Executor executor = Executor()) {
+  return FutureAwaitable<internal::GetResult, Executor>(
+        cass_session_execute(session, statement), std::move(executor));
+}
+
+/**
+ * Executes a batch. Awaiting the operation returns a Result.
+ */
+template <class Executor = InlineExecutor>
+FutureAwaitable<internal::GetResult, Executor>
+execute_batch(CassSession* session, const CassBatch* batch,
+              Executor executor = Executor()) {
+  return FutureAwaitable<internal::GetResult, Executor>(
+        cass_session_execute_batch(session, batch), std::move(executor));
+}
+
+/**
+ * Prepares a query. Awaiting the operation returns a Prepared.
+ */
+template <class Executor = InlineExecutor>
+FutureAwaitable<internal::GetPrepared, Executor>
+prepare(CassSession* session, const char* query,
+        Executor executor = Executor()) {
+  return FutureAwaitable<internal::GetPrepared, Executor>(
+        cass_session_prepare(session, query), std::move(executor));
+}
+
+/**
+ * Fetches the pages of a statement's result one at a time.
+ *
+ * @code
+ * cass::coro::Pager pager(session, statement.get());
+ * while (pager.has_more_pages()) {
+ *   cass::coro::Result page = co_await pager.next_page();
+ *   if (!page) break;
+ *   ...
+ * }
+ * @endcode
+ */
+template <class Executor = InlineExecutor>
+class Pager {
+public:
+  Pager(CassSession* session, CassStatement* statement,
+        Executor executor = Executor())
+    : session_(session)
+    , statement_(statement)
+    , executor_(std::move(executor))
+    , has_more_pages_(true) { }
+
+  bool has_more_pages() const { return has_more_pages_; }
+
+  class Awaitable {
+  public:
+    Awaitable(Pager* pager)
+      : pager_(pager)
+      , awaitable_(cass_session_execute(pager->session_, pager->statement_),
+                   pager->executor_) { }
+
+    bool await_ready() const { return awaitable_.await_ready(); }
+
+    bool await_suspend(std::coroutine_handle<> handle) {
+      return awaitable_.await_suspend(handle);
+    }
+
+    Result await_resume() {
+      Result result(awaitable_.await_resume());
+      pager_->has_more_pages_ =
+          result && cass_result_has_more_pages(result.get()) == cass_true;
+      if (pager_->has_more_pages_) {
+        cass_statement_set_paging_state(pager_->statement_, result.get());
+      }
+      return result;
+    }
+
+  private:
+    Pager* pager_;
+    FutureAwaitable<internal::GetResult, Executor> awaitable_;
+  };
+
+  /**
+   * Executes the statement for the next page. Awaiting the operation
+   * returns a Result.
+   */
+  Awaitable next_page() { return Awaitable(this); }
+
+private:
+  CassSession* session_;
+  CassStatement* statement_;
+  Executor executor_;
+  bool has_more_pages_;
+};
+
+/**
+ * A minimal fire-and-forget coroutine type. The coroutine starts
+ * immediately and its frame is freed when it finishes.
+ */
+struct Task {
+  struct promise_type {
+    Task get_return_object() { return Task(); }
+    std::suspend_never initial_suspend() noexcept { return std::suspend_never(); }
+    std::suspend_never final_suspend() noexcept { return std::suspend_never(); }
+    void return_void() { }
+    void unhandled_exception() { std::terminate(); }
+  };
+};
+
+} // namespace coro
+} // namespace cass
+
+#endif
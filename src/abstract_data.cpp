@@ -24,31 +24,57 @@
 
 namespace cass {
 
+static size_t encode_external(const Buffer& external, BufferVec* bufs) {
+  Buffer length(sizeof(int32_t));
+  length.encode_int32(0, static_cast<int32_t>(external.size()));
+  bufs->push_back(length);
+  if (external.size() > 0) {
+    bufs->push_back(external);
+  }
+  return sizeof(int32_t) + external.size();
+}
+
 CassError AbstractData::set(size_t index, CassNull value) {
   CASS_CHECK_INDEX_AND_TYPE(index, value);
-  elements_[index] = Element(value);
+  if (encoded_) {
+    encoded_->set(index, cass::encode_with_length(value));
+  } else {
+    elements_[index] = Element(value);
+  }
   return CASS_OK;
 }
 
 CassError AbstractData::set(size_t index, const Collection* value) {
   CASS_CHECK_INDEX_AND_TYPE(index, value);
   if (value->type() == CASS_COLLECTION_TYPE_MAP &&
-      value->items().size() % 2 != 0) {
+      value->item_count() % 2 != 0) {
     return CASS_ERROR_LIB_INVALID_ITEM_COUNT;
   }
-  elements_[index] = value;
+  if (encoded_) {
+    encoded_->set_collection(index, value);
+  } else {
+    elements_[index] = value;
+  }
   return CASS_OK;
 }
 
 CassError AbstractData::set(size_t index, const Tuple* value) {
   CASS_CHECK_INDEX_AND_TYPE(index, value);
-  elements_[index] = value->encode_with_length();
+  if (encoded_) {
+    encoded_->set(index, value->encode_with_length());
+  } else {
+    elements_[index] = value->encode_with_length();
+  }
   return CASS_OK;
 }
 
 CassError AbstractData::set(size_t index, const UserTypeValue* value) {
   CASS_CHECK_INDEX_AND_TYPE(index, value);
-  elements_[index] = value->encode_with_length();
+  if (encoded_) {
+    encoded_->set(index, value->encode_with_length());
+  } else {
+    elements_[index] = value->encode_with_length();
+  }
   return CASS_OK;
 }
 
@@ -68,12 +94,90 @@ Buffer AbstractData::encode_with_length() const {
   return buf;
 }
 
+bool AbstractData::is_unset(size_t index) const {
+  return encoded_ ? encoded_->is_unset(index) : elements_[index].is_unset();
+}
+
+bool AbstractData::is_null(size_t index) const {
+  return encoded_ ? encoded_->is_null(index) : elements_[index].is_null();
+}
+
+Buffer AbstractData::get_buffer(size_t index, int version) const {
+  if (encoded_) {
+    const Collection* collection = encoded_->collection(index);
+    if (collection != NULL && version < 3) {
+      return collection->encode_with_length(version);
+    }
+    return encoded_->get(index);
+  }
+  return elements_[index].get_buffer(version);
+}
+
+size_t AbstractData::get_buffers(size_t index, int version, BufferVec* bufs) const {
+  if (encoded_) {
+    const Buffer* external = encoded_->external(index);
+    if (external != NULL) {
+      return encode_external(*external, bufs);
+    }
+    bufs->push_back(get_buffer(index, version));
+    return bufs->back().size();
+  }
+  return elements_[index].get_buffers(version, bufs);
+}
+
+size_t AbstractData::get_size(size_t index, int version) const {
+  if (encoded_) {
+    const Collection* collection = encoded_->collection(index);
+    if (collection != NULL && version < 3) {
+      return collection->get_size_with_length(version);
+    }
+    return encoded_->get_size(index);
+  }
+  return elements_[index].get_size(version);
+}
+
+void AbstractData::set_contiguous(bool contiguous) {
+  if (contiguous == is_contiguous()) return;
+
+  if (contiguous) {
+    ScopedPtr<EncodedValues> encoded(new EncodedValues(elements_.size()));
+    for (size_t i = 0; i < elements_.size(); ++i) {
+      const Element& element = elements_[i];
+      if (element.is_unset()) continue;
+      if (element.collection() != NULL) {
+        encoded->set_collection(i, element.collection());
+      } else if (element.external() != NULL) {
+        encoded->set_external(i, *element.external());
+      } else {
+        encoded->set(i, element.get_buffer(CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION));
+      }
+    }
+    elements_.clear();
+    encoded_.reset(encoded.release());
+  } else {
+    ElementVec elements(encoded_->count());
+    for (size_t i = 0; i < elements.size(); ++i) {
+      if (encoded_->is_unset(i)) continue;
+      if (encoded_->is_null(i)) {
+        elements[i] = Element(CassNull());
+      } else if (encoded_->collection(i) != NULL) {
+        elements[i] = Element(encoded_->collection(i));
+      } else if (encoded_->external(i) != NULL) {
+        elements[i] = Element::external(*encoded_->external(i));
+      } else {
+        elements[i] = Element(encoded_->get(i));
+      }
+    }
+    elements_.swap(elements);
+    encoded_.reset();
+  }
+}
+
 size_t AbstractData::get_buffers_size() const {
   size_t size = 0;
-  for (ElementVec::const_iterator i = elements_.begin(),
-       end = elements_.end(); i != end; ++i) {
-    if (!i->is_unset()) {
-      size += i->get_size(CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION);
+  for (size_t i = 0, count = elements_count(); i < count; ++i) {
+    if (!is_unset(i)) {
+      size += get_size(i, CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION);
     } else {
       size += sizeof(int32_t); // null
     }
@@ -82,6 +186,18 @@ size_t AbstractData::get_buffers_size() const {
 }
 
 void AbstractData::encode_buffers(size_t pos, Buffer* buf) const {
+  if (encoded_) {
+    for (size_t i = 0, count = encoded_->count(); i < count; ++i) {
+      if (!encoded_->is_unset(i)) {
+        Buffer value(encoded_->get(i));
+        pos = buf->copy(pos, value.data(), value.size());
+      } else {
+        pos = buf->encode_int32(pos, -1); // null
+      }
+    }
+    return;
+  }
+
   for (ElementVec::const_iterator i = elements_.begin(),
        end = elements_.end(); i != end; ++i) {
     if (!i->is_unset()) {
@@ -95,6 +211,8 @@ void AbstractData::encode_buffers(size_t pos, Buffer* buf) const {
 size_t AbstractData::Element::get_size(int version) const {
   if (type_ == COLLECTION) {
     return collection_->get_size_with_length(version);
+  } else if (type_ == EXTERNAL) {
+    return sizeof(int32_t) + buf_.size();
   } else {
     assert(type_ == BUFFER || type_ == NUL);
     return buf_.size();
@@ -105,6 +223,9 @@ size_t AbstractData::Element::copy_buffer(int version, size_t pos, Buffer* buf)
   if (type_ == COLLECTION) {
     Buffer encoded(collection_->encode_with_length(version));
     return buf->copy(pos, encoded.data(), encoded.size());
+  } else if (type_ == EXTERNAL) {
+    pos = buf->encode_int32(pos, static_cast<int32_t>(buf_.size()));
+    return buf->copy(pos, buf_.data(), buf_.size());
   } else {
     assert(type_ == BUFFER || type_ == NUL);
     return buf->copy(pos, buf_.data(), buf_.size());
@@ -114,10 +235,22 @@ size_t AbstractData::Element::copy_buffer(int version, size_t pos, Buffer* buf)
 Buffer AbstractData::Element::get_buffer(int version) const {
   if (type_ == COLLECTION) {
     return collection_->encode_with_length(version);
+  } else if (type_ == EXTERNAL) {
+    Buffer buf(sizeof(int32_t) + buf_.size());
+    copy_buffer(version, 0, &buf);
+    return buf;
   } else {
     assert(type_ == BUFFER || type_ == NUL);
     return buf_;
   }
 }
 
+size_t AbstractData::Element::get_buffers(int version, BufferVec* bufs) const {
+  if (type_ == EXTERNAL) {
+    return encode_external(buf_, bufs);
+  }
+  bufs->push_back(get_buffer(version));
+  return bufs->back().size();
+}
+
 } // namespace cass
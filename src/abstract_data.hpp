@@ -21,8 +21,10 @@
 #include "collection.hpp"
 #include "data_type.hpp"
 #include "encode.hpp"
+#include "encoded_values.hpp"
 #include "hash_table.hpp"
 #include "request.hpp"
+#include "scoped_ptr.hpp"
 #include "string_ref.hpp"
 #include "types.hpp"
 
@@ -44,7 +46,8 @@ public:
       UNSET,
       NUL,
       BUFFER,
-      COLLECTION
+      COLLECTION,
+      EXTERNAL
     };
 
     Element()
@@ -62,6 +65,15 @@ public:
       : type_(COLLECTION)
       , collection_(collection) { }
 
+    // Memory owned by the application that's encoded as [bytes] without
+    // being copied
+    static Element external(const Buffer& value) {
+      Element element;
+      element.type_ = EXTERNAL;
+      element.buf_ = value;
+      return element;
+    }
+
     bool is_unset() const {
       return type_ == UNSET || (type_ == BUFFER && buf_.size() == 0);
     }
@@ -70,9 +82,18 @@ public:
       return type_ == NUL;
     }
 
+    const Collection* collection() const {
+      return type_ == COLLECTION ? collection_.get() : NULL;
+    }
+
+    const Buffer* external() const {
+      return type_ == EXTERNAL ? &buf_ : NULL;
+    }
+
     size_t get_size(int version) const;
     size_t copy_buffer(int version, size_t pos, Buffer* buf) const;
     Buffer get_buffer(int version) const;
+    size_t get_buffers(int version, BufferVec* bufs) const;
 
   private:
     Type type_;
@@ -88,18 +109,45 @@ public:
 
   virtual ~AbstractData() { }
 
-  const ElementVec& elements() const { return elements_; }
+  size_t elements_count() const {
+    return encoded_ ? encoded_->count() : elements_.size();
+  }
+
+  bool is_unset(size_t index) const;
+  bool is_null(size_t index) const;
+
+  // The value's [bytes] encoded for the protocol version
+  Buffer get_buffer(size_t index, int version) const;
+  size_t get_size(size_t index, int version) const;
+
+  // Appends the value's [bytes] to "bufs" without copying external values
+  size_t get_buffers(size_t index, int version, BufferVec* bufs) const;
+
+  // In contiguous mode values are encoded into a single buffer as they're
+  // bound instead of being kept as separate buffers.
+  bool is_contiguous() const { return encoded_; }
+  void set_contiguous(bool contiguous);
+
+  const EncodedValues* encoded_values() const { return encoded_.get(); }
 
   void reset(size_t count) {
-    elements_.clear();
-    elements_.resize(count);
+    if (encoded_) {
+      encoded_->reset(count);
+    } else {
+      elements_.clear();
+      elements_.resize(count);
+    }
   }
 
-#define SET_TYPE(Type)                                  \
-  CassError set(size_t index, const Type value) {       \
-    CASS_CHECK_INDEX_AND_TYPE(index, value);            \
-    elements_[index] = cass::encode_with_length(value); \
-    return CASS_OK;                                     \
+#define SET_TYPE(Type)                                    \
+  CassError set(size_t index, const Type value) {         \
+    CASS_CHECK_INDEX_AND_TYPE(index, value);              \
+    if (encoded_) {                                       \
+      set_encoded(index, value);                          \
+    } else {                                              \
+      elements_[index] = cass::encode_with_length(value); \
+    }                                                     \
+    return CASS_OK;                                       \
   }
 
   SET_TYPE(cass_int8_t)
@@ -125,6 +173,36 @@ public:
   CassError set(size_t index, const Tuple* value);
   CassError set(size_t index, const UserTypeValue* value);
 
+  // Binds memory owned by the application without copying it. The type of
+  // "value" is used to validate the value's type.
+  template <class T>
+  CassError set_external(size_t index, const T value, const Buffer& external) {
+    CASS_CHECK_INDEX_AND_TYPE(index, value);
+    if (encoded_) {
+      encoded_->set_external(index, external);
+    } else {
+      elements_[index] = Element::external(external);
+    }
+    return CASS_OK;
+  }
+
+  template <class T>
+  CassError set_external(StringRef name, const T value, const Buffer& external) {
+    IndexVec indices;
+
+    if (get_indices(name, &indices) == 0) {
+      return CASS_ERROR_LIB_NAME_DOES_NOT_EXIST;
+    }
+
+    for (IndexVec::const_iterator it = indices.begin(),
+         end = indices.end(); it != end; ++it) {
+      CassError rc = set_external(*it, value, external);
+      if (rc != CASS_OK) return rc;
+    }
+
+    return CASS_OK;
+  }
+
   template<class T>
   CassError set(StringRef name, const T value) {
     IndexVec indices;
@@ -147,6 +225,13 @@ public:
   Buffer encode_with_length() const;
 
 protected:
+  // Copies the values of another object. Contiguous values share the
+  // encoded buffer until either object is modified.
+  void copy_values(const AbstractData& other) {
+    elements_ = other.elements_;
+    encoded_.reset(other.encoded_ ? new EncodedValues(*other.encoded_) : NULL);
+  }
+
   virtual size_t get_indices(StringRef name,
                              IndexVec* indices) = 0;
   virtual const DataType::ConstPtr& get_type(size_t index) const = 0;
@@ -154,7 +239,7 @@ protected:
 private:
   template <class T>
   CassError check(size_t index, const T value) {
-    if (index >= elements_.size()) {
+    if (index >= elements_count()) {
       return CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS;
     }
     IsValidDataType<T> is_valid_type;
@@ -165,11 +250,30 @@ private:
     return CASS_OK;
   }
 
+  // Fixed size values are small enough to be encoded without allocating
+  template <class T>
+  void set_encoded(size_t index, const T value) {
+    encoded_->set(index, cass::encode_with_length(value));
+  }
+
+  void set_encoded(size_t index, CassString value) {
+    encoded_->set_bytes(index, value.data, value.length);
+  }
+
+  void set_encoded(size_t index, CassBytes value) {
+    encoded_->set_bytes(index, reinterpret_cast<const char*>(value.data), value.size);
+  }
+
+  void set_encoded(size_t index, CassCustom value) {
+    encoded_->set_bytes(index, reinterpret_cast<const char*>(value.data), value.size);
+  }
+
   size_t get_buffers_size() const;
   void encode_buffers(size_t pos, Buffer* buf) const;
 
 private:
   ElementVec elements_;
+  ScopedPtr<EncodedValues> encoded_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(AbstractData);
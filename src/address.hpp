@@ -17,10 +17,9 @@
 #ifndef __CASS_ADDRESS_HPP_INCLUDED__
 #define __CASS_ADDRESS_HPP_INCLUDED__
 
+#include "dense_hash_set.hpp"
 #include "hash.hpp"
 
-#include <sparsehash/dense_hash_set>
-
 #include <ostream>
 #include <string.h>
 #include <string>
@@ -105,7 +104,7 @@ struct AddressHash {
 };
 
 typedef std::vector<Address> AddressVec;
-typedef sparsehash::dense_hash_set<Address, AddressHash> AddressSet;
+typedef DenseHashSet<Address, AddressHash> AddressSet;
 
 inline bool operator<(const Address& a, const Address& b) {
   return a.compare(b) < 0;
@@ -71,12 +71,28 @@ CassError cass_batch_set_request_timeout(CassBatch *batch,
   return CASS_OK;
 }
 
+CassError cass_batch_set_deadline(CassBatch* batch,
+                                  cass_uint64_t deadline_ms) {
+  batch->set_deadline_ms(deadline_ms);
+  return CASS_OK;
+}
+
 CassError cass_batch_set_is_idempotent(CassBatch* batch,
                                        cass_bool_t is_idempotent) {
   batch->set_is_idempotent(is_idempotent == cass_true);
   return CASS_OK;
 }
 
+CassError cass_batch_set_priority(CassBatch* batch,
+                                  CassRequestPriority priority) {
+  if (priority < CASS_REQUEST_PRIORITY_INTERACTIVE ||
+      priority > CASS_REQUEST_PRIORITY_BACKGROUND) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  batch->set_priority(priority);
+  return CASS_OK;
+}
+
 CassError cass_batch_set_retry_policy(CassBatch* batch,
                                       CassRetryPolicy* retry_policy) {
   batch->set_retry_policy(retry_policy);
@@ -53,6 +53,28 @@ public:
     }
   }
 
+  // Shares the first "size" bytes of a reference counted buffer. The bytes
+  // are copied if they fit in the fixed buffer.
+  Buffer(RefBuffer* buffer, size_t size)
+    : size_(size) {
+    if (size > FIXED_BUFFER_SIZE) {
+      buffer->inc_ref();
+      data_.buffer = buffer;
+    } else if (size > 0) {
+      memcpy(data_.fixed, buffer->data(), size);
+    }
+  }
+
+  // References memory owned by the application without copying it. The
+  // release callback is called once the memory is no longer referenced
+  // (immediately if the memory is small enough to be copied).
+  static Buffer external(const char* data, size_t size,
+                         RefBuffer::ReleaseCallback release_callback,
+                         void* release_data) {
+    RefBuffer::Ptr buffer(RefBuffer::create_external(data, release_callback, release_data));
+    return Buffer(buffer.get(), size);
+  }
+
   Buffer(const Buffer& buf)
     : size_(0) {
     copy(buf);
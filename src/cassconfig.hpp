@@ -0,0 +1,13 @@
+#ifndef __CASSANDRA_CONFIG_HPP_INCLUDED__
+#define __CASSANDRA_CONFIG_HPP_INCLUDED__
+
+#define HAVE_OPENSSL
+#define HAVE_STD_ATOMIC
+/* #undef HAVE_BOOST_ATOMIC */
+/* #undef HAVE_NOSIGPIPE */
+#define HAVE_SIGTIMEDWAIT
+/* #undef HAVE_ARC4RANDOM */
+#define HAVE_GETRANDOM
+#define HAVE_KTLS
+
+#endif
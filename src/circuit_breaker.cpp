@@ -0,0 +1,121 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "circuit_breaker.hpp"
+
+#define WINDOW_FAILURE (static_cast<uint64_t>(1) << 32)
+#define WINDOW_SUCCESS static_cast<uint64_t>(1)
+
+namespace cass {
+
+CircuitBreaker::CircuitBreaker(const Settings& settings)
+  : settings_(settings)
+  , state_(CLOSED)
+  , opened_at_ns_(0)
+  , probe_started_ns_(0)
+  , window_(0)
+  , window_start_ns_(0) { }
+
+bool CircuitBreaker::allow_request(uint64_t now_ns) {
+  int state = state_.load(MEMORY_ORDER_ACQUIRE);
+  if (state == CLOSED) {
+    return true;
+  }
+
+  if (state == OPEN) {
+    if (now_ns < opened_at_ns_.load(MEMORY_ORDER_RELAXED) + settings_.open_time_ns) {
+      return false;
+    }
+    if (!state_.compare_exchange_strong(state, HALF_OPEN, MEMORY_ORDER_ACQ_REL) &&
+        state == CLOSED) {
+      return true; // Another probe already closed the circuit
+    }
+  }
+
+  // A probe that never completed (e.g. the host was skipped for some other
+  // reason) is replaced after the open time
+  uint64_t probe_started_ns = probe_started_ns_.load(MEMORY_ORDER_RELAXED);
+  if (probe_started_ns != 0 && now_ns < probe_started_ns + settings_.open_time_ns) {
+    return false;
+  }
+  return probe_started_ns_.compare_exchange_strong(probe_started_ns, now_ns,
+                                                   MEMORY_ORDER_RELAXED);
+}
+
+bool CircuitBreaker::on_success(uint64_t now_ns, uint64_t request_started_ns) {
+  int state = state_.load(MEMORY_ORDER_ACQUIRE);
+  if (state == HALF_OPEN) {
+    if (!claim_probe(request_started_ns)) return false;
+    // Nothing is added to the window while the circuit isn't closed so it
+    // can be reset before closing without losing counts
+    window_.store(0, MEMORY_ORDER_RELAXED);
+    window_start_ns_.store(now_ns, MEMORY_ORDER_RELAXED);
+    state_.store(CLOSED, MEMORY_ORDER_RELEASE);
+    return true;
+  } else if (state == CLOSED) {
+    add_to_window(now_ns, WINDOW_SUCCESS);
+  }
+  // Late responses from before the circuit opened are ignored
+  return false;
+}
+
+bool CircuitBreaker::on_failure(uint64_t now_ns, uint64_t request_started_ns) {
+  int state = state_.load(MEMORY_ORDER_ACQUIRE);
+  if (state == HALF_OPEN) {
+    if (!claim_probe(request_started_ns)) return false;
+    opened_at_ns_.store(now_ns, MEMORY_ORDER_RELAXED);
+    state_.store(OPEN, MEMORY_ORDER_RELEASE);
+    return true;
+  } else if (state == CLOSED) {
+    uint64_t window = add_to_window(now_ns, WINDOW_FAILURE);
+    uint64_t failures = window >> 32;
+    uint64_t requests = failures + (window & 0xFFFFFFFF);
+    if (requests >= settings_.min_requests &&
+        static_cast<double>(failures) >= settings_.failure_ratio * requests) {
+      opened_at_ns_.store(now_ns, MEMORY_ORDER_RELAXED);
+      if (state_.compare_exchange_strong(state, OPEN, MEMORY_ORDER_ACQ_REL)) {
+        // Requests sent while the circuit was closed are never the probe
+        probe_started_ns_.store(0, MEMORY_ORDER_RELAXED);
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// The outcome of the probe (a request sent after the current probe was let
+// through) is only used once. Only the thread that takes the probe changes
+// the state of a half-open circuit.
+bool CircuitBreaker::claim_probe(uint64_t request_started_ns) {
+  uint64_t probe_started_ns = probe_started_ns_.load(MEMORY_ORDER_RELAXED);
+  if (probe_started_ns == 0 || request_started_ns < probe_started_ns) {
+    return false;
+  }
+  return probe_started_ns_.compare_exchange_strong(probe_started_ns, 0,
+                                                   MEMORY_ORDER_RELAXED);
+}
+
+uint64_t CircuitBreaker::add_to_window(uint64_t now_ns, uint64_t value) {
+  uint64_t window_start_ns = window_start_ns_.load(MEMORY_ORDER_RELAXED);
+  if (now_ns >= window_start_ns + settings_.window_ns &&
+      window_start_ns_.compare_exchange_strong(window_start_ns, now_ns,
+                                               MEMORY_ORDER_RELAXED)) {
+    window_.store(0, MEMORY_ORDER_RELAXED);
+  }
+  return window_.fetch_add(value, MEMORY_ORDER_RELAXED) + value;
+}
+
+} // namespace cass
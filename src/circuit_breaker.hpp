@@ -0,0 +1,91 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_CIRCUIT_BREAKER_HPP_INCLUDED__
+#define __CASS_CIRCUIT_BREAKER_HPP_INCLUDED__
+
+#include "atomic.hpp"
+#include "macros.hpp"
+
+#include <stdint.h>
+
+namespace cass {
+
+// Stops requests from being sent to a host that's up but failing or timing
+// out. The circuit opens when the ratio of failed requests in a window
+// reaches a threshold and query plans skip the host while it's open. After
+// the open time a single probe request is let through (half-open) and its
+// outcome either closes the circuit or opens it again. The state is shared
+// by all the IO threads and query plans so it's kept in atomics.
+class CircuitBreaker {
+public:
+  enum State {
+    CLOSED,
+    OPEN,
+    HALF_OPEN
+  };
+
+  struct Settings {
+    Settings()
+      : failure_ratio(0.0)
+      , min_requests(20)
+      , open_time_ns(1000LL * 1000LL * 1000LL)
+      , window_ns(1000LL * 1000LL * 1000LL) { }
+
+    bool is_enabled() const { return failure_ratio > 0.0; }
+
+    double failure_ratio;
+    unsigned min_requests;
+    uint64_t open_time_ns;
+    uint64_t window_ns;
+  };
+
+  CircuitBreaker(const Settings& settings);
+
+  // Returns false if requests shouldn't be sent to the host. A half-open
+  // circuit only lets one probe through at a time.
+  bool allow_request(uint64_t now_ns);
+
+  // These return true if the request changed the state of the circuit.
+  // "request_started_ns" is when the request was sent; while half-open only
+  // the probe's outcome (sent after it was let through) is used.
+  bool on_success(uint64_t now_ns, uint64_t request_started_ns);
+  bool on_failure(uint64_t now_ns, uint64_t request_started_ns);
+
+  State state() const { return static_cast<State>(state_.load(MEMORY_ORDER_ACQUIRE)); }
+
+private:
+  bool claim_probe(uint64_t request_started_ns);
+  uint64_t add_to_window(uint64_t now_ns, uint64_t value);
+
+private:
+  const Settings settings_;
+
+  Atomic<int> state_;
+  Atomic<uint64_t> opened_at_ns_;
+  // When the current probe was let through (0 if there isn't one)
+  Atomic<uint64_t> probe_started_ns_;
+  // The window's failures (high 32 bits) and successes (low 32 bits)
+  Atomic<uint64_t> window_;
+  Atomic<uint64_t> window_start_ns_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(CircuitBreaker);
+};
+
+} // namespace cass
+
+#endif
@@ -302,7 +302,7 @@ void cass_cluster_set_latency_aware_routing_settings(CassCluster* cluster,
                                                      cass_uint64_t retry_period_ms,
                                                      cass_uint64_t update_rate_ms,
                                                      cass_uint64_t min_measured) {
-  cass::LatencyAwarePolicy::Settings settings;
+  cass::LatencyAwarePolicy::Settings settings(cluster->config().latency_aware_routing_settings());
   settings.exclusion_threshold = exclusion_threshold;
   settings.scale_ns = scale_ms * 1000 * 1000;
   settings.retry_period_ns = retry_period_ms * 1000 * 1000;
@@ -311,6 +311,19 @@ void cass_cluster_set_latency_aware_routing_settings(CassCluster* cluster,
   cluster->config().set_latency_aware_routing_settings(settings);
 }
 
+CassError cass_cluster_set_latency_aware_routing_scoring(CassCluster* cluster,
+                                                        cass_double_t tail_percentile,
+                                                        cass_bool_t weight_inflight) {
+  if (tail_percentile < 0.0 || tail_percentile >= 100.0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cass::LatencyAwarePolicy::Settings settings(cluster->config().latency_aware_routing_settings());
+  settings.tail_percentile = tail_percentile;
+  settings.weight_inflight = weight_inflight == cass_true;
+  cluster->config().set_latency_aware_routing_settings(settings);
+  return CASS_OK;
+}
+
 void cass_cluster_set_whitelist_filtering(CassCluster* cluster,
                                           const char* hosts) {
   cass_cluster_set_whitelist_filtering_n(cluster,
@@ -457,6 +470,22 @@ CassError cass_cluster_set_constant_speculative_execution_policy(CassCluster* cl
   return CASS_OK;
 }
 
+CassError cass_cluster_set_percentile_speculative_execution_policy(CassCluster* cluster,
+                                                                   cass_double_t percentile,
+                                                                   int max_speculative_executions,
+                                                                   cass_double_t max_hedge_ratio) {
+  if (percentile <= 0.0 || percentile >= 100.0 ||
+      max_speculative_executions < 0 ||
+      max_hedge_ratio < 0.0 || max_hedge_ratio > 1.0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_speculative_execution_policy(
+        new cass::PercentileSpeculativeExecutionPolicy(percentile,
+                                                       max_speculative_executions,
+                                                       max_hedge_ratio));
+  return CASS_OK;
+}
+
 CassError cass_cluster_set_no_speculative_execution_policy(CassCluster* cluster) {
   cluster->config().set_speculative_execution_policy(
         new cass::NoSpeculativeExecutionPolicy());
@@ -481,6 +510,118 @@ CassError cass_cluster_set_no_compact(CassCluster* cluster,
   return CASS_OK;
 }
 
+CassError cass_cluster_set_external_event_loop(CassCluster* cluster,
+                                               cass_bool_t enabled) {
+  cluster->config().set_external_event_loop(enabled == cass_true);
+  if (enabled == cass_false) {
+    cluster->config().set_event_loop(NULL);
+  }
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_event_loop(CassCluster* cluster,
+                                      void* loop) {
+  if (loop == NULL) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_event_loop(static_cast<uv_loop_t*>(loop));
+  cluster->config().set_external_event_loop(true);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_session_sharding(CassCluster* cluster,
+                                             cass_bool_t enabled) {
+  cluster->config().set_session_sharding(enabled == cass_true);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_coalesce_reads(CassCluster* cluster,
+                                          cass_bool_t enabled) {
+  cluster->config().set_coalesce_reads(enabled == cass_true);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_result_cache(CassCluster* cluster,
+                                        size_t max_size_bytes,
+                                        cass_uint64_t ttl_ms) {
+  if ((max_size_bytes == 0) != (ttl_ms == 0)) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cass::ResultCache::Settings settings;
+  settings.max_size_bytes = max_size_bytes;
+  settings.ttl_ns = ttl_ms * 1000 * 1000;
+  cluster->config().set_result_cache_settings(settings);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_rate_limit(CassCluster* cluster,
+                                      CassRequestPriority priority,
+                                      cass_double_t requests_per_second,
+                                      unsigned burst) {
+  if (priority < CASS_REQUEST_PRIORITY_INTERACTIVE ||
+      priority > CASS_REQUEST_PRIORITY_BACKGROUND ||
+      requests_per_second < 0.0 || burst == 0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cass::RateLimiter::Settings settings;
+  settings.requests_per_second = requests_per_second;
+  settings.burst = burst;
+  cluster->config().set_rate_limit_settings(priority, settings);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_rate_limit_max_delay(CassCluster* cluster,
+                                                cass_uint64_t max_delay_ms) {
+  cluster->config().set_rate_limit_max_delay_ms(max_delay_ms);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_host_rate_limit(CassCluster* cluster,
+                                           cass_double_t requests_per_second,
+                                           unsigned burst) {
+  if (requests_per_second < 0.0 || burst == 0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cass::RateLimiter::Settings settings;
+  settings.requests_per_second = requests_per_second;
+  settings.burst = burst;
+  cluster->config().set_host_rate_limit_settings(settings);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_adaptive_concurrency_limit(CassCluster* cluster,
+                                                      unsigned initial_limit,
+                                                      unsigned min_limit,
+                                                      unsigned max_limit) {
+  if (initial_limit > 0 &&
+      (min_limit == 0 || min_limit > max_limit ||
+       initial_limit < min_limit || initial_limit > max_limit)) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cass::ConcurrencyLimiter::Settings settings;
+  settings.initial_limit = initial_limit;
+  settings.min_limit = min_limit;
+  settings.max_limit = max_limit;
+  cluster->config().set_concurrency_limit_settings(settings);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_circuit_breaker(CassCluster* cluster,
+                                           cass_double_t failure_ratio,
+                                           unsigned min_requests,
+                                           cass_uint64_t open_time_ms) {
+  if (failure_ratio < 0.0 || failure_ratio > 1.0 ||
+      (failure_ratio > 0.0 && (min_requests == 0 || open_time_ms == 0))) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cass::CircuitBreaker::Settings settings;
+  settings.failure_ratio = failure_ratio;
+  settings.min_requests = min_requests;
+  settings.open_time_ns = open_time_ms * 1000 * 1000;
+  cluster->config().set_circuit_breaker_settings(settings);
+  return CASS_OK;
+}
+
 
 void cass_cluster_free(CassCluster* cluster) {
   delete cluster->from();
@@ -19,6 +19,7 @@
 #include "constants.hpp"
 #include "external.hpp"
 #include "macros.hpp"
+#include "serialization.hpp"
 #include "tuple.hpp"
 #include "user_type_value.hpp"
 
@@ -84,6 +85,20 @@ CASS_COLLECTION_APPEND(duration,
 
 #undef CASS_COLLECTION_APPEND
 
+#define CASS_COLLECTION_APPEND_ARRAY(Name, Type)                                    \
+ CassError cass_collection_append_##Name##_array(CassCollection* collection,        \
+                                                 const Type* values, size_t count) { \
+   return collection->append(values, count);                                        \
+ }
+
+CASS_COLLECTION_APPEND_ARRAY(int32, cass_int32_t)
+CASS_COLLECTION_APPEND_ARRAY(int64, cass_int64_t)
+CASS_COLLECTION_APPEND_ARRAY(float, cass_float_t)
+CASS_COLLECTION_APPEND_ARRAY(double, cass_double_t)
+CASS_COLLECTION_APPEND_ARRAY(uuid, CassUuid)
+
+#undef CASS_COLLECTION_APPEND_ARRAY
+
 CassError cass_collection_append_string(CassCollection* collection,
                                         const char* value) {
   return collection->append(cass::CassString(value, SAFE_STRLEN(value)));
@@ -114,6 +129,54 @@ CassError cass_collection_append_custom_n(CassCollection* collection,
 
 } // extern "C"
 
+namespace {
+
+// The values are encoded with a fixed stride so the compiler can turn these
+// loops into vectorized byte swaps.
+
+inline void encode_value(char* output, cass_int32_t value) { cass::encode_int32(output, value); }
+inline void encode_value(char* output, cass_int64_t value) { cass::encode_int64(output, value); }
+inline void encode_value(char* output, cass_float_t value) { cass::encode_float(output, value); }
+inline void encode_value(char* output, cass_double_t value) { cass::encode_double(output, value); }
+inline void encode_value(char* output, CassUuid value) { cass::encode_uuid(output, value); }
+
+template <class T>
+void encode_array(const T* values, size_t count, char* output) {
+  const size_t stride = sizeof(int32_t) + sizeof(T);
+  for (size_t i = 0; i < count; ++i) {
+    cass::encode_int32(output + i * stride, sizeof(T));
+  }
+  for (size_t i = 0; i < count; ++i) {
+    encode_value(output + i * stride + sizeof(int32_t), values[i]);
+  }
+}
+
+char* encode_buffers_int32(cass::BufferVec::const_iterator i,
+                           cass::BufferVec::const_iterator end,
+                           char* buf) {
+  for (; i != end; ++i) {
+    cass::encode_int32(buf, i->size());
+    buf += sizeof(int32_t);
+    memcpy(buf, i->data(), i->size());
+    buf += i->size();
+  }
+  return buf;
+}
+
+char* encode_buffers_uint16(cass::BufferVec::const_iterator i,
+                            cass::BufferVec::const_iterator end,
+                            char* buf) {
+  for (; i != end; ++i) {
+    cass::encode_uint16(buf, i->size());
+    buf += sizeof(uint16_t);
+    memcpy(buf, i->data(), i->size());
+    buf += i->size();
+  }
+  return buf;
+}
+
+} // namespace
+
 namespace cass {
 
 CassError Collection::append(CassNull value) {
@@ -140,6 +203,48 @@ CassError Collection::append(const UserTypeValue* value) {
   return CASS_OK;
 }
 
+CassError Collection::append(const cass_int32_t* values, size_t count) {
+  return append_array(values, count);
+}
+
+CassError Collection::append(const cass_int64_t* values, size_t count) {
+  return append_array(values, count);
+}
+
+CassError Collection::append(const cass_float_t* values, size_t count) {
+  return append_array(values, count);
+}
+
+CassError Collection::append(const cass_double_t* values, size_t count) {
+  return append_array(values, count);
+}
+
+CassError Collection::append(const CassUuid* values, size_t count) {
+  return append_array(values, count);
+}
+
+template <class T>
+CassError Collection::append_array(const T* values, size_t count) {
+  if (count == 0) return CASS_OK;
+
+  CASS_COLLECTION_CHECK_TYPE(values[0]);
+  if (count > 1 && type() == CASS_COLLECTION_TYPE_MAP) {
+    CassError rc = check(item_count() + 1, values[1]);
+    if (rc != CASS_OK) return rc;
+  }
+
+  Array array;
+  array.index = items_.size();
+  array.count = count;
+  array.value_size = sizeof(T);
+  array.data = Buffer(count * (sizeof(int32_t) + sizeof(T)));
+  encode_array(values, count, array.data.data());
+
+  arrays_.push_back(array);
+  array_item_count_ += count;
+  return CASS_OK;
+}
+
 size_t Collection::get_items_size(int version) const {
   if (version >= 3) {
     return get_items_size(sizeof(int32_t));
@@ -205,27 +310,44 @@ size_t Collection::get_items_size(size_t num_bytes_for_size) const {
     size += num_bytes_for_size;
     size += i->size();
   }
+  for (ArrayVec::const_iterator i = arrays_.begin(),
+       end = arrays_.end(); i != end; ++i) {
+    size += i->count * (num_bytes_for_size + i->value_size);
+  }
   return size;
 }
 
 void Collection::encode_items_int32(char* buf) const {
-  for (BufferVec::const_iterator i = items_.begin(),
-       end = items_.end(); i != end; ++i) {
-    encode_int32(buf, i->size());
-    buf += sizeof(int32_t);
-    memcpy(buf, i->data(), i->size());
-    buf += i->size();
+  BufferVec::const_iterator item = items_.begin();
+  for (ArrayVec::const_iterator i = arrays_.begin(),
+       end = arrays_.end(); i != end; ++i) {
+    BufferVec::const_iterator next = items_.begin() + i->index;
+    buf = encode_buffers_int32(item, next, buf);
+    item = next;
+    // Arrays are already framed using int32 lengths
+    memcpy(buf, i->data.data(), i->data.size());
+    buf += i->data.size();
   }
+  encode_buffers_int32(item, items_.end(), buf);
 }
 
 void Collection::encode_items_uint16(char* buf) const {
-  for (BufferVec::const_iterator i = items_.begin(),
-       end = items_.end(); i != end; ++i) {
-    encode_uint16(buf, i->size());
-    buf += sizeof(uint16_t);
-    memcpy(buf, i->data(), i->size());
-    buf += i->size();
+  BufferVec::const_iterator item = items_.begin();
+  for (ArrayVec::const_iterator i = arrays_.begin(),
+       end = arrays_.end(); i != end; ++i) {
+    BufferVec::const_iterator next = items_.begin() + i->index;
+    buf = encode_buffers_uint16(item, next, buf);
+    item = next;
+    const char* value = i->data.data() + sizeof(int32_t);
+    for (size_t j = 0; j < i->count; ++j) {
+      encode_uint16(buf, i->value_size);
+      buf += sizeof(uint16_t);
+      memcpy(buf, value, i->value_size);
+      buf += i->value_size;
+      value += sizeof(int32_t) + i->value_size;
+    }
   }
+  encode_buffers_uint16(item, items_.end(), buf);
 }
 
 }  // namespace cass
@@ -25,6 +25,8 @@
 #include "ref_counted.hpp"
 #include "types.hpp"
 
+#include <vector>
+
 #define CASS_COLLECTION_CHECK_TYPE(Value) do { \
   CassError rc = check(Value);                 \
   if (rc != CASS_OK) return rc;                \
@@ -38,13 +40,15 @@ class Collection : public RefCounted<Collection> {
 public:
   Collection(CassCollectionType type,
              size_t item_count)
-    : data_type_(new CollectionType(static_cast<CassValueType>(type), false)) {
+    : data_type_(new CollectionType(static_cast<CassValueType>(type), false))
+    , array_item_count_(0) {
     items_.reserve(item_count);
   }
 
   Collection(const CollectionType::ConstPtr& data_type,
              size_t item_count)
-    : data_type_(data_type) {
+    : data_type_(data_type)
+    , array_item_count_(0) {
     items_.reserve(item_count);
   }
 
@@ -55,6 +59,8 @@ public:
   const CollectionType::ConstPtr& data_type() const { return data_type_; }
   const BufferVec& items() const { return items_; }
 
+  size_t item_count() const { return items_.size() + array_item_count_; }
+
 #define APPEND_TYPE(Type)                  \
   CassError append(const Type value) {     \
     CASS_COLLECTION_CHECK_TYPE(value);     \
@@ -85,6 +91,14 @@ public:
   CassError append(const Tuple* value);
   CassError append(const UserTypeValue* value);
 
+  // Appends an array of values that are converted to big-endian in a single
+  // pass and stored already framed (int32 length + value) in one buffer.
+  CassError append(const cass_int32_t* values, size_t count);
+  CassError append(const cass_int64_t* values, size_t count);
+  CassError append(const cass_float_t* values, size_t count);
+  CassError append(const cass_double_t* values, size_t count);
+  CassError append(const CassUuid* values, size_t count);
+
   size_t get_items_size(int version) const;
   void encode_items(int version, char* buf) const;
 
@@ -95,13 +109,19 @@ public:
 
   void clear() {
     items_.clear();
+    arrays_.clear();
+    array_item_count_ = 0;
   }
 
 private:
   template <class T>
   CassError check(const T value) {
+    return check(item_count(), value);
+  }
+
+  template <class T>
+  CassError check(size_t index, const T value) {
     IsValidDataType<T> is_valid_type;
-    size_t index = items_.size();
 
     switch(type()) {
       case CASS_COLLECTION_TYPE_MAP:
@@ -123,17 +143,33 @@ private:
   }
 
   int32_t get_count() const {
-    return ((type() == CASS_COLLECTION_TYPE_MAP) ? items_.size() / 2 : items_.size());
+    return ((type() == CASS_COLLECTION_TYPE_MAP) ? item_count() / 2 : item_count());
   }
 
+  template <class T>
+  CassError append_array(const T* values, size_t count);
+
   size_t get_items_size(size_t num_bytes_for_size) const;
 
   void encode_items_int32(char* buf) const;
   void encode_items_uint16(char* buf) const;
 
 private:
+  // A run of values appended as an array. It's placed before the item at
+  // "index" in "items_".
+  struct Array {
+    size_t index;
+    size_t count;
+    size_t value_size;
+    Buffer data;
+  };
+
+  typedef std::vector<Array> ArrayVec;
+
   CollectionType::ConstPtr data_type_;
   BufferVec items_;
+  ArrayVec arrays_;
+  size_t array_item_count_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(Collection);
@@ -0,0 +1,119 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "completion_queue.hpp"
+
+#include "future.hpp"
+#include "scoped_lock.hpp"
+
+#include <algorithm>
+
+extern "C" {
+
+CassCompletionQueue* cass_completion_queue_new() {
+  cass::CompletionQueue* queue = new cass::CompletionQueue();
+  queue->inc_ref();
+  return CassCompletionQueue::to(queue);
+}
+
+void cass_completion_queue_free(CassCompletionQueue* queue) {
+  queue->dec_ref();
+}
+
+CassError cass_completion_queue_add(CassCompletionQueue* queue,
+                                    CassFuture* future,
+                                    void* data) {
+  if (!future->set_completion_queue(queue, data)) {
+    return CASS_ERROR_LIB_CALLBACK_ALREADY_SET;
+  }
+  return CASS_OK;
+}
+
+size_t cass_completion_queue_next_n(CassCompletionQueue* queue,
+                                    CassCompletion* completions,
+                                    size_t count,
+                                    cass_duration_t timeout_us) {
+  return queue->next_n(completions, count, timeout_us);
+}
+
+} // extern "C"
+
+namespace cass {
+
+CompletionQueue::CompletionQueue()
+  : waiters_(0) {
+  uv_mutex_init(&mutex_);
+  uv_cond_init(&cond_);
+}
+
+CompletionQueue::~CompletionQueue() {
+  // Release the completions that were never consumed
+  for (std::deque<CassCompletion>::iterator it = completions_.begin(),
+       end = completions_.end(); it != end; ++it) {
+    it->future->dec_ref();
+  }
+  uv_mutex_destroy(&mutex_);
+  uv_cond_destroy(&cond_);
+}
+
+void CompletionQueue::push(Future* future, void* data) {
+  CassCompletion completion;
+  future->inc_ref();
+  completion.future = CassFuture::to(future);
+  completion.data = data;
+
+  ScopedMutex lock(&mutex_);
+  completions_.push_back(completion);
+  if (waiters_ > 0) {
+    uv_cond_signal(&cond_);
+  }
+}
+
+size_t CompletionQueue::next_n(CassCompletion* completions, size_t count,
+                               uint64_t timeout_us) {
+  if (count == 0) return 0;
+
+  ScopedMutex lock(&mutex_);
+  if (completions_.empty() && timeout_us > 0) {
+    uint64_t deadline_ns = uv_hrtime() + timeout_us * 1000;
+    waiters_++;
+    while (completions_.empty()) {
+      uint64_t now_ns = uv_hrtime();
+      if (now_ns >= deadline_ns ||
+          uv_cond_timedwait(&cond_, lock.get(), deadline_ns - now_ns) != 0) {
+        break;
+      }
+    }
+    waiters_--;
+  }
+
+  size_t n = std::min(count, completions_.size());
+  std::copy(completions_.begin(), completions_.begin() + n, completions);
+  completions_.erase(completions_.begin(), completions_.begin() + n);
+
+  // Other consumers can take what's left
+  if (waiters_ > 0 && !completions_.empty()) {
+    uv_cond_signal(&cond_);
+  }
+  return n;
+}
+
+size_t CompletionQueue::size() {
+  ScopedMutex lock(&mutex_);
+  return completions_.size();
+}
+
+} // namespace cass
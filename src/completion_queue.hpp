@@ -0,0 +1,67 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_COMPLETION_QUEUE_HPP_INCLUDED__
+#define __CASS_COMPLETION_QUEUE_HPP_INCLUDED__
+
+#include "cassandra.h"
+#include "external.hpp"
+#include "macros.hpp"
+#include "ref_counted.hpp"
+
+#include <deque>
+#include <uv.h>
+
+namespace cass {
+
+class Future;
+
+// A queue of completed futures. Futures attached to the queue are added to
+// it when they're set (instead of running a callback) and a consumer thread
+// removes them in batches. Only the queue's condition variable is signaled
+// and only when a consumer is waiting.
+class CompletionQueue : public RefCounted<CompletionQueue> {
+public:
+  typedef SharedRefPtr<CompletionQueue> Ptr;
+
+  CompletionQueue();
+  ~CompletionQueue();
+
+  // Called by the future when it's set. The queue takes a reference to the
+  // future that's given to the consumer.
+  void push(Future* future, void* data);
+
+  // Removes up to "count" completions waiting up to "timeout_us" for the
+  // first one. A timeout of 0 doesn't wait. Returns the number removed.
+  size_t next_n(CassCompletion* completions, size_t count, uint64_t timeout_us);
+
+  size_t size();
+
+private:
+  uv_mutex_t mutex_;
+  uv_cond_t cond_;
+  std::deque<CassCompletion> completions_;
+  int waiters_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(CompletionQueue);
+};
+
+} // namespace cass
+
+EXTERNAL_TYPE(cass::CompletionQueue, CassCompletionQueue)
+
+#endif
@@ -0,0 +1,162 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "concurrency_limiter.hpp"
+
+#include "cassandra.h"
+#include "scoped_lock.hpp"
+
+#include <algorithm>
+#include <math.h>
+
+// The weight of a window's latency in the long term latency
+#define LONG_LATENCY_WEIGHT 0.05
+
+// How much higher than the long term latency a window's latency can be
+// before the limit starts to shrink
+#define LATENCY_TOLERANCE 1.5
+
+// How much of the new limit is used for each update
+#define SMOOTHING 0.2
+
+// The multiplicative decrease applied when requests are dropped
+#define BACKOFF_RATIO 0.9
+
+namespace cass {
+
+ConcurrencyLimiter::ConcurrencyLimiter(const Settings& settings)
+  : settings_(settings)
+  , pending_drops_(0)
+  , window_start_ns_(0)
+  , is_updating_(false)
+  , limit_(settings.initial_limit)
+  , waiter_count_(0)
+  , estimated_limit_(settings.initial_limit)
+  , long_latency_us_(-1.0) {
+  uv_mutex_init(&waiters_mutex_);
+}
+
+ConcurrencyLimiter::~ConcurrencyLimiter() {
+  uv_mutex_destroy(&waiters_mutex_);
+}
+
+bool ConcurrencyLimiter::add_waiter(const LoopWaker::Ptr& waker,
+                                    const Atomic<int64_t>& inflight) {
+  {
+    ScopedMutex l(&waiters_mutex_);
+    if (std::find(waiters_.begin(), waiters_.end(), waker) == waiters_.end()) {
+      waiters_.push_back(waker);
+      waiter_count_.store(waiters_.size(), MEMORY_ORDER_RELAXED);
+    }
+  }
+  // Pairs with the fence in notify_waiters(): either the waiter is seen by
+  // the thread that drops the host below its limit or the drop is seen here
+  atomic_thread_fence(MEMORY_ORDER_SEQ_CST);
+  return is_at_limit(inflight.load(MEMORY_ORDER_RELAXED));
+}
+
+void ConcurrencyLimiter::notify_waiters(const Atomic<int64_t>& inflight) {
+  atomic_thread_fence(MEMORY_ORDER_SEQ_CST);
+  if (waiter_count_.load(MEMORY_ORDER_RELAXED) == 0 ||
+      is_at_limit(inflight.load(MEMORY_ORDER_RELAXED))) {
+    return;
+  }
+  wake_waiters();
+}
+
+void ConcurrencyLimiter::wake_waiters() {
+  std::vector<LoopWaker::Ptr> waiters;
+  {
+    ScopedMutex l(&waiters_mutex_);
+    waiters.swap(waiters_);
+    waiter_count_.store(0, MEMORY_ORDER_RELAXED);
+  }
+  for (std::vector<LoopWaker::Ptr>::iterator it = waiters.begin(),
+       end = waiters.end(); it != end; ++it) {
+    (*it)->wake();
+  }
+}
+
+void ConcurrencyLimiter::on_sample(uint64_t now_ns, uint64_t latency_ns, int64_t inflight) {
+  uint64_t latency_us = std::max(latency_ns / 1000, static_cast<uint64_t>(1));
+  pending_.add(latency_us); // Dropped if the window is full
+  maybe_update(now_ns, inflight);
+}
+
+void ConcurrencyLimiter::on_drop(uint64_t now_ns, int64_t inflight) {
+  pending_drops_.fetch_add(1, MEMORY_ORDER_RELAXED);
+  maybe_update(now_ns, inflight);
+}
+
+void ConcurrencyLimiter::maybe_update(uint64_t now_ns, int64_t inflight) {
+  uint64_t window_start_ns = window_start_ns_.load(MEMORY_ORDER_RELAXED);
+  if (now_ns < window_start_ns + settings_.window_ns) {
+    return;
+  }
+  if (!window_start_ns_.compare_exchange_strong(window_start_ns, now_ns,
+                                                MEMORY_ORDER_RELAXED)) {
+    return; // Another thread is starting the next window
+  }
+  if (is_updating_.exchange(true, MEMORY_ORDER_ACQUIRE)) {
+    return; // The previous update is still running; merge later
+  }
+  update(inflight);
+  is_updating_.store(false, MEMORY_ORDER_RELEASE);
+}
+
+void ConcurrencyLimiter::update(int64_t inflight) {
+  uint64_t count, sum;
+  pending_.take(&count, &sum);
+  uint64_t drops = pending_drops_.exchange(0, MEMORY_ORDER_RELAXED);
+
+  double limit = estimated_limit_;
+  if (drops > 0) {
+    limit *= BACKOFF_RATIO;
+  } else if (count > 0) {
+    double latency_us = static_cast<double>(sum) / count;
+    if (long_latency_us_ < 0.0) {
+      long_latency_us_ = latency_us;
+    } else {
+      long_latency_us_ = (1.0 - LONG_LATENCY_WEIGHT) * long_latency_us_ +
+                         LONG_LATENCY_WEIGHT * latency_us;
+      // Recover faster when a lasting increase in load has ended
+      if (long_latency_us_ > 2.0 * latency_us) {
+        long_latency_us_ *= 0.95;
+      }
+    }
+
+    // Only probe for a higher limit when the host is using the current one
+    if (static_cast<double>(inflight) * 2.0 >= limit) {
+      double gradient = std::max(0.5, std::min(1.0, LATENCY_TOLERANCE *
+                                                    long_latency_us_ / latency_us));
+      double new_limit = limit * gradient + sqrt(limit);
+      limit = (1.0 - SMOOTHING) * limit + SMOOTHING * new_limit;
+    }
+  }
+
+  limit = std::max(static_cast<double>(settings_.min_limit),
+                   std::min(static_cast<double>(settings_.max_limit), limit));
+  estimated_limit_ = limit;
+  unsigned previous_limit = limit_.exchange(static_cast<unsigned>(limit), MEMORY_ORDER_RELAXED);
+
+  // Requests waiting for the host can be sent once the limit grows
+  if (static_cast<unsigned>(limit) > previous_limit && !is_at_limit(inflight) &&
+      waiter_count_.load(MEMORY_ORDER_RELAXED) > 0) {
+    wake_waiters();
+  }
+}
+
+} // namespace cass
@@ -0,0 +1,117 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_CONCURRENCY_LIMITER_HPP_INCLUDED__
+#define __CASS_CONCURRENCY_LIMITER_HPP_INCLUDED__
+
+#include "atomic.hpp"
+#include "loop_waker.hpp"
+#include "macros.hpp"
+#include "packed_sum.hpp"
+
+#include <stdint.h>
+#include <uv.h>
+#include <vector>
+
+namespace cass {
+
+// An adaptive limit on the number of requests in flight to a host (in the
+// style of TCP Vegas and gradient concurrency limiters). The limit grows
+// while the host's latency stays close to its long term latency and shrinks
+// as the latency rises above it. It's cut multiplicatively when requests to
+// the host time out. Samples are added by all the IO threads and merged once
+// per window by whichever thread wins the update, so the current limit can
+// be read without locking.
+//
+// The limit is shared by all the IO workers that have a pool for the host.
+// Requests that are held back because the host is at its limit wait in their
+// pool, so the loops of those IO workers are woken once the number of
+// requests in flight drops below the limit (possibly because of requests
+// that finished on another IO worker).
+class ConcurrencyLimiter {
+public:
+  struct Settings {
+    Settings()
+      : initial_limit(0)
+      , min_limit(1)
+      , max_limit(1024)
+      , window_ns(100LL * 1000LL * 1000LL) { }
+
+    bool is_enabled() const { return initial_limit > 0; }
+
+    unsigned initial_limit;
+    unsigned min_limit;
+    unsigned max_limit;
+    uint64_t window_ns;
+  };
+
+  ConcurrencyLimiter(const Settings& settings);
+  ~ConcurrencyLimiter();
+
+  // Adds the latency of a request. "inflight" is the number of requests in
+  // flight to the host and it's used to only grow the limit when the host
+  // is actually using it.
+  void on_sample(uint64_t now_ns, uint64_t latency_ns, int64_t inflight);
+
+  // Adds a request that timed out or was rejected because the host was
+  // overloaded
+  void on_drop(uint64_t now_ns, int64_t inflight);
+
+  unsigned limit() const { return limit_.load(MEMORY_ORDER_RELAXED); }
+
+  bool is_at_limit(int64_t inflight) const {
+    return inflight >= static_cast<int64_t>(limit());
+  }
+
+  // Adds a loop to wake once the host drops below its limit. It returns
+  // false if the host dropped below its limit while the waiter was being
+  // added (the caller doesn't need to wait).
+  bool add_waiter(const LoopWaker::Ptr& waker, const Atomic<int64_t>& inflight);
+
+  // Called after requests finish. It wakes all the waiting loops if the
+  // host is below its limit.
+  void notify_waiters(const Atomic<int64_t>& inflight);
+
+private:
+  void maybe_update(uint64_t now_ns, int64_t inflight);
+  void update(int64_t inflight);
+  void wake_waiters();
+
+private:
+  const Settings settings_;
+
+  // The count and sum (in microseconds) of the window's latencies
+  PackedSum pending_;
+  Atomic<uint64_t> pending_drops_;
+  Atomic<uint64_t> window_start_ns_;
+  Atomic<bool> is_updating_;
+  Atomic<unsigned> limit_;
+
+  uv_mutex_t waiters_mutex_;
+  std::vector<LoopWaker::Ptr> waiters_;
+  Atomic<size_t> waiter_count_;
+
+  // Only used by the thread doing an update
+  double estimated_limit_;
+  double long_latency_us_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ConcurrencyLimiter);
+};
+
+} // namespace cass
+
+#endif
@@ -19,10 +19,14 @@
 
 #include "auth.hpp"
 #include "cassandra.h"
+#include "circuit_breaker.hpp"
+#include "concurrency_limiter.hpp"
 #include "constants.hpp"
 #include "dc_aware_policy.hpp"
 #include "host_targeting_policy.hpp"
 #include "latency_aware_policy.hpp"
+#include "rate_limiter.hpp"
+#include "result_cache.hpp"
 #include "retry_policy.hpp"
 #include "ssl.hpp"
 #include "timestamp_generator.hpp"
@@ -36,6 +40,7 @@
 
 #include <list>
 #include <string>
+#include <uv.h>
 
 namespace cass {
 
@@ -84,7 +89,12 @@ public:
       , use_randomized_contact_points_(true)
       , prepare_on_all_hosts_(true)
       , prepare_on_up_or_add_host_(true)
-      , no_compact_(false) { }
+      , no_compact_(false)
+      , external_event_loop_(false)
+      , event_loop_(NULL)
+      , session_sharding_(false)
+      , coalesce_reads_(false)
+      , rate_limit_max_delay_ms_(1000) { }
 
   Config new_instance() const {
     Config config = *this;
@@ -320,6 +330,10 @@ public:
 
   void set_host_targeting(bool is_host_targeting) { host_targeting_ = is_host_targeting; }
 
+  const LatencyAwarePolicy::Settings& latency_aware_routing_settings() const {
+    return latency_aware_routing_settings_;
+  }
+
   void set_latency_aware_routing_settings(const LatencyAwarePolicy::Settings& settings) {
     latency_aware_routing_settings_ = settings;
   }
@@ -419,6 +433,77 @@ public:
     no_compact_ = enabled;
   }
 
+  bool external_event_loop() const { return external_event_loop_; }
+
+  void set_external_event_loop(bool enabled) {
+    external_event_loop_ = enabled;
+  }
+
+  uv_loop_t* event_loop() const { return event_loop_; }
+
+  void set_event_loop(uv_loop_t* loop) {
+    event_loop_ = loop;
+  }
+
+  bool session_sharding() const { return session_sharding_; }
+
+  void set_session_sharding(bool enabled) {
+    session_sharding_ = enabled;
+  }
+
+  bool coalesce_reads() const { return coalesce_reads_; }
+
+  void set_coalesce_reads(bool enabled) {
+    coalesce_reads_ = enabled;
+  }
+
+  const RateLimiter::Settings& rate_limit_settings(CassRequestPriority priority) const {
+    return rate_limit_settings_[priority];
+  }
+
+  void set_rate_limit_settings(CassRequestPriority priority,
+                               const RateLimiter::Settings& settings) {
+    rate_limit_settings_[priority] = settings;
+  }
+
+  uint64_t rate_limit_max_delay_ms() const { return rate_limit_max_delay_ms_; }
+
+  void set_rate_limit_max_delay_ms(uint64_t max_delay_ms) {
+    rate_limit_max_delay_ms_ = max_delay_ms;
+  }
+
+  const RateLimiter::Settings& host_rate_limit_settings() const {
+    return host_rate_limit_settings_;
+  }
+
+  void set_host_rate_limit_settings(const RateLimiter::Settings& settings) {
+    host_rate_limit_settings_ = settings;
+  }
+
+  const ConcurrencyLimiter::Settings& concurrency_limit_settings() const {
+    return concurrency_limit_settings_;
+  }
+
+  void set_concurrency_limit_settings(const ConcurrencyLimiter::Settings& settings) {
+    concurrency_limit_settings_ = settings;
+  }
+
+  const CircuitBreaker::Settings& circuit_breaker_settings() const {
+    return circuit_breaker_settings_;
+  }
+
+  void set_circuit_breaker_settings(const CircuitBreaker::Settings& settings) {
+    circuit_breaker_settings_ = settings;
+  }
+
+  const ResultCache::Settings& result_cache_settings() const {
+    return result_cache_settings_;
+  }
+
+  void set_result_cache_settings(const ResultCache::Settings& settings) {
+    result_cache_settings_ = settings;
+  }
+
 private:
   int port_;
   int protocol_version_;
@@ -469,6 +554,16 @@ private:
   bool prepare_on_all_hosts_;
   bool prepare_on_up_or_add_host_;
   bool no_compact_;
+  bool external_event_loop_;
+  uv_loop_t* event_loop_;
+  bool session_sharding_;
+  bool coalesce_reads_;
+  RateLimiter::Settings rate_limit_settings_[CASS_REQUEST_PRIORITY_COUNT];
+  uint64_t rate_limit_max_delay_ms_;
+  RateLimiter::Settings host_rate_limit_settings_;
+  ConcurrencyLimiter::Settings concurrency_limit_settings_;
+  CircuitBreaker::Settings circuit_breaker_settings_;
+  ResultCache::Settings result_cache_settings_;
 };
 
 } // namespace cass
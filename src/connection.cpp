@@ -34,17 +34,19 @@
 #include "error_response.hpp"
 #include "event_response.hpp"
 #include "logger.hpp"
+#include "memory.hpp"
 
 #ifdef HAVE_NOSIGPIPE
 #include <sys/socket.h>
 #include <sys/types.h>
 #endif
 
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
 
-#define SSL_READ_SIZE 8192
-#define SSL_WRITE_SIZE 8192
+#define SSL_READ_SIZE 16384 // The maximum size of a TLS record's payload
+#define SSL_WRITE_SIZE 16384
 #define SSL_ENCRYPTED_BUFS_COUNT 16
 
 #define MAX_BUFFER_REUSE_NO 8
@@ -226,7 +228,7 @@ Connection::Connection(uv_loop_t* loop,
     , keyspace_(keyspace)
     , protocol_version_(protocol_version)
     , listener_(listener)
-    , response_(new ResponseMessage())
+    , response_(new ResponseMessage(this))
     , stream_manager_(protocol_version)
     , ssl_session_(NULL)
     , heartbeat_outstanding_(false) {
@@ -252,9 +254,11 @@ Connection::Connection(uv_loop_t* loop,
 
 Connection::~Connection()
 {
+  host_->dec_inflight_requests(stream_manager_.pending_streams());
+
   while (!buffer_reuse_list_.empty()) {
     uv_buf_t buf = buffer_reuse_list_.top();
-    delete[] buf.base;
+    Memory::free(buf.base);
     buffer_reuse_list_.pop();
   }
 }
@@ -281,16 +285,26 @@ int32_t Connection::internal_write(const RequestCallback::Ptr& callback, bool fl
     return Request::REQUEST_ERROR_CANCELLED;
   }
 
+  // This is the last chance to avoid sending a request that the
+  // application has already given up on
+  if (callback->is_expired()) {
+    metrics_->pending_request_timeouts.inc();
+    callback->on_error(CASS_ERROR_LIB_REQUEST_TIMED_OUT,
+                       "Request deadline exceeded before it was written");
+    return Request::REQUEST_ERROR_DEADLINE_EXCEEDED;
+  }
+
   int stream = stream_manager_.acquire(callback.get());
   if (stream < 0) {
     return Request::REQUEST_ERROR_NO_AVAILABLE_STREAM_IDS;
   }
+  host_->inc_inflight_requests();
 
   callback->inc_ref(); // Connection reference
   callback->start(this, stream);
 
   if (pending_writes_.is_empty() || pending_writes_.back()->is_flushed()) {
-    if (ssl_session_) {
+    if (ssl_session_ && !ssl_session_->is_kernel_offload_tx()) {
       pending_writes_.add_to_back(new PendingWriteSsl(this));
     } else {
       pending_writes_.add_to_back(new PendingWrite(this));
@@ -302,6 +316,7 @@ int32_t Connection::internal_write(const RequestCallback::Ptr& callback, bool fl
   int32_t request_size = pending_write->write(callback.get());
   if (request_size < 0) {
     stream_manager_.release(stream);
+    host_->dec_inflight_requests();
 
     switch (request_size) {
       case Request::REQUEST_ERROR_BATCH_WITH_NAMED_VALUES:
@@ -440,77 +455,108 @@ void Connection::consume(char* input, size_t size) {
     }
 
     if (response_->is_body_ready()) {
-      ScopedPtr<ResponseMessage> response(response_.release());
-      response_.reset(new ResponseMessage());
-
-      LOG_TRACE("Consumed message type %s with stream %d, input %u, remaining %u on host %s",
-                opcode_to_string(response->opcode()).c_str(),
-                static_cast<int>(response->stream()),
-                static_cast<unsigned int>(size),
-                static_cast<unsigned int>(remaining),
-                host_->address_string().c_str());
-
-      if (response->stream() < 0) {
-        if (response->opcode() == CQL_OPCODE_EVENT) {
-          listener_->on_event(static_cast<EventResponse*>(response->response_body().get()));
-        } else {
-          notify_error("Invalid response opcode for event stream: " +
-                       opcode_to_string(response->opcode()));
-          continue;
-        }
-      } else {
-        RequestCallback* temp = NULL;
-
-        if (stream_manager_.get_pending_and_release(response->stream(), temp)) {
-          RequestCallback::Ptr callback(temp);
-
-          switch (callback->state()) {
-            case RequestCallback::REQUEST_STATE_READING:
-              pending_reads_.remove(callback.get());
-              callback->set_state(RequestCallback::REQUEST_STATE_FINISHED);
-              maybe_set_keyspace(response.get());
-              callback->on_set(response.get());
-              callback->dec_ref();
-              break;
-
-            case RequestCallback::REQUEST_STATE_WRITING:
-              // There are cases when the read callback will happen
-              // before the write callback. If this happens we have
-              // to allow the write callback to finish the request.
-              callback->set_state(RequestCallback::REQUEST_STATE_READ_BEFORE_WRITE);
-              // Save the response for the write callback
-              callback->set_read_before_write_response(response.release()); // Transfer ownership
-              break;
-
-            case RequestCallback::REQUEST_STATE_CANCELLED_READING:
-              pending_reads_.remove(callback.get());
-              callback->set_state(RequestCallback::REQUEST_STATE_CANCELLED);
-              callback->on_cancel();
-              callback->dec_ref();
-              break;
-
-            case RequestCallback::REQUEST_STATE_CANCELLED_WRITING:
-              // There are cases when the read callback will happen
-              // before the write callback. If this happens we have
-              // to allow the write callback to finish the request.
-              callback->set_state(RequestCallback::REQUEST_STATE_CANCELLED_READ_BEFORE_WRITE);
-              break;
-
-            default:
-              assert(false && "Invalid request state after receiving response");
-              break;
-          }
-        } else {
-          notify_error("Invalid stream ID");
-          continue;
-        }
-      }
+      process_response();
     }
     remaining -= consumed;
     buffer += consumed;
   }
 }
 
+void Connection::consume_body(size_t size) {
+  // A successful read means the connection is still responsive
+  restart_terminate_timer();
+
+  if (response_->commit_body(size) <= 0) {
+    notify_error("Error consuming message");
+    return;
+  }
+
+  if (response_->is_body_ready()) {
+    process_response();
+  }
+}
+
+void Connection::process_response() {
+  ScopedPtr<ResponseMessage> response(response_.release());
+  response_.reset(new ResponseMessage(this));
+
+  LOG_TRACE("Consumed message type %s with stream %d on host %s",
+            opcode_to_string(response->opcode()).c_str(),
+            static_cast<int>(response->stream()),
+            host_->address_string().c_str());
+
+  if (response->stream() < 0) {
+    if (response->opcode() == CQL_OPCODE_EVENT) {
+      listener_->on_event(static_cast<EventResponse*>(response->response_body().get()));
+    } else {
+      notify_error("Invalid response opcode for event stream: " +
+                   opcode_to_string(response->opcode()));
+    }
+  } else {
+    RequestCallback* temp = NULL;
+
+    if (stream_manager_.get_pending_and_release(response->stream(), temp)) {
+      RequestCallback::Ptr callback(temp);
+      host_->dec_inflight_requests();
+
+      switch (callback->state()) {
+        case RequestCallback::REQUEST_STATE_READING:
+          pending_reads_.remove(callback.get());
+          callback->set_state(RequestCallback::REQUEST_STATE_FINISHED);
+          maybe_set_keyspace(response.get());
+          callback->on_set(response.get());
+          callback->dec_ref();
+          break;
+
+        case RequestCallback::REQUEST_STATE_WRITING:
+          // There are cases when the read callback will happen
+          // before the write callback. If this happens we have
+          // to allow the write callback to finish the request.
+          callback->set_state(RequestCallback::REQUEST_STATE_READ_BEFORE_WRITE);
+          // Save the response for the write callback
+          callback->set_read_before_write_response(response.release()); // Transfer ownership
+          break;
+
+        case RequestCallback::REQUEST_STATE_CANCELLED_READING:
+          pending_reads_.remove(callback.get());
+          callback->set_state(RequestCallback::REQUEST_STATE_CANCELLED);
+          callback->on_cancel();
+          callback->dec_ref();
+          record_wasted_response(response.get());
+          break;
+
+        case RequestCallback::REQUEST_STATE_CANCELLED_WRITING:
+          // There are cases when the read callback will happen
+          // before the write callback. If this happens we have
+          // to allow the write callback to finish the request.
+          callback->set_state(RequestCallback::REQUEST_STATE_CANCELLED_READ_BEFORE_WRITE);
+          record_wasted_response(response.get());
+          break;
+
+        default:
+          assert(false && "Invalid request state after receiving response");
+          break;
+      }
+    } else {
+      notify_error("Invalid stream ID");
+    }
+  }
+}
+
+void Connection::record_wasted_response(ResponseMessage* response) {
+  metrics_->wasted_responses.inc();
+  metrics_->wasted_response_bytes.add(response->frame_size());
+}
+
+bool Connection::is_body_discarded(int16_t stream) const {
+  RequestCallback* callback = NULL;
+  if (!stream_manager_.get_pending(stream, callback)) {
+    return false;
+  }
+  return callback->state() == RequestCallback::REQUEST_STATE_CANCELLED_READING ||
+         callback->state() == RequestCallback::REQUEST_STATE_CANCELLED_WRITING;
+}
+
 void Connection::maybe_set_keyspace(ResponseMessage* response) {
   if (response->opcode() == CQL_OPCODE_RESULT) {
     ResultResponse* result =
@@ -610,9 +656,9 @@ uv_buf_t Connection::internal_alloc_buffer(size_t suggested_size) {
       buffer_reuse_list_.pop();
       return ret;
     }
-    return uv_buf_init(new char[BUFFER_REUSE_SIZE], BUFFER_REUSE_SIZE);
+    return uv_buf_init(static_cast<char*>(Memory::malloc(BUFFER_REUSE_SIZE)), BUFFER_REUSE_SIZE);
   }
-  return uv_buf_init(new char[suggested_size], suggested_size);
+  return uv_buf_init(static_cast<char*>(Memory::malloc(suggested_size)), suggested_size);
 }
 
 void Connection::internal_reuse_buffer(uv_buf_t buf) {
@@ -620,7 +666,7 @@ void Connection::internal_reuse_buffer(uv_buf_t buf) {
     buffer_reuse_list_.push(buf);
     return;
   }
-  delete[] buf.base;
+  Memory::free(buf.base);
 }
 
 #if UV_VERSION_MAJOR == 0
@@ -716,9 +762,20 @@ void Connection::on_read_ssl(uv_stream_t* client, ssize_t nread, const uv_buf_t*
   if (ssl_session->is_handshake_done()) {
     char buf[SSL_READ_SIZE];
     int rc =  0;
-    while ((rc = ssl_session->decrypt(buf, sizeof(buf))) > 0) {
-      connection->consume(buf, rc);
-    }
+    do {
+      // The remainder of a partially received response body is decrypted
+      // directly into the response's buffer. Only frame headers and small
+      // frames go through the intermediate buffer.
+      size_t body_remaining = connection->response_->body_remaining();
+      if (body_remaining > 0) {
+        rc = ssl_session->decrypt(connection->response_->body_buffer_pos(),
+                                  body_remaining);
+        if (rc > 0) connection->consume_body(rc);
+      } else {
+        rc = ssl_session->decrypt(buf, sizeof(buf));
+        if (rc > 0) connection->consume(buf, rc);
+      }
+    } while (rc > 0 && !connection->is_closing());
     if (rc <= 0 && ssl_session->has_error()) {
       connection->notify_error("Unable to decrypt data: " + ssl_session->error_message(),
                                CONNECTION_ERROR_SSL_DECRYPT);
@@ -854,10 +911,40 @@ void Connection::ssl_handshake() {
                    CONNECTION_ERROR_SSL_VERIFY);
       return;
     }
+    if (ssl_session_->is_resumed()) {
+      metrics_->ssl_resumed_handshakes.inc();
+    } else {
+      metrics_->ssl_full_handshakes.inc();
+    }
+    ssl_kernel_offload();
     on_connected();
   }
 }
 
+void Connection::ssl_kernel_offload() {
+#if UV_VERSION_MAJOR >= 1 && !defined(_WIN32)
+  uv_stream_t* stream = reinterpret_cast<uv_stream_t*>(&socket_);
+
+  // The kernel can only take over the record layer once all the data encrypted
+  // in userspace has been written to the socket.
+  if (stream->write_queue_size > 0) return;
+
+  uv_os_fd_t fd;
+  if (uv_fileno(reinterpret_cast<uv_handle_t*>(&socket_), &fd) != 0) return;
+
+  if (ssl_session_->enable_kernel_offload(fd)) {
+    LOG_DEBUG("Kernel TLS enabled on connection(%p) to host %s (receive %s)",
+              static_cast<void*>(this),
+              host_->address_string().c_str(),
+              ssl_session_->is_kernel_offload_rx() ? "enabled" : "disabled");
+    if (ssl_session_->is_kernel_offload_rx()) {
+      uv_read_stop(stream);
+      uv_read_start(stream, Connection::alloc_buffer, Connection::on_read);
+    }
+  }
+#endif
+}
+
 void Connection::send_credentials(const std::string& class_name) {
   ScopedPtr<V1Authenticator> v1_auth(config_.auth_provider()->new_authenticator_v1(host_, class_name));
   if (v1_auth) {
@@ -941,10 +1028,11 @@ Connection::PendingWriteBase::~PendingWriteBase() {
 }
 
 int32_t Connection::PendingWriteBase::write(RequestCallback* callback) {
-  size_t last_buffer_size = buffers_.size();
-  int32_t request_size = callback->encode(connection_->protocol_version_, 0x00, &buffers_);
+  BufferVec& buffers = buffers_[callback->priority()];
+  size_t last_buffer_size = buffers.size();
+  int32_t request_size = callback->encode(connection_->protocol_version_, 0x00, &buffers);
   if (request_size < 0) {
-    buffers_.resize(last_buffer_size); // rollback
+    buffers.resize(last_buffer_size); // rollback
     return request_size;
   }
 
@@ -954,6 +1042,21 @@ int32_t Connection::PendingWriteBase::write(RequestCallback* callback) {
   return request_size;
 }
 
+bool Connection::PendingWriteBase::has_buffers() const {
+  for (int i = 0; i < CASS_REQUEST_PRIORITY_COUNT; ++i) {
+    if (!buffers_[i].empty()) return true;
+  }
+  return false;
+}
+
+size_t Connection::PendingWriteBase::buffer_count() const {
+  size_t count = 0;
+  for (int i = 0; i < CASS_REQUEST_PRIORITY_COUNT; ++i) {
+    count += buffers_[i].size();
+  }
+  return count;
+}
+
 void Connection::PendingWriteBase::on_write(uv_write_t* req, int status) {
   PendingWrite* pending_write = static_cast<PendingWrite*>(req->data);
 
@@ -978,6 +1081,7 @@ void Connection::PendingWriteBase::on_write(uv_write_t* req, int status) {
           }
 
           connection->stream_manager_.release(callback->stream());
+          connection->host_->dec_inflight_requests();
           callback->set_state(RequestCallback::REQUEST_STATE_FINISHED);
           callback->on_error(CASS_ERROR_LIB_WRITE_ERROR,
                              "Unable to write to socket");
@@ -1021,14 +1125,16 @@ void Connection::PendingWriteBase::on_write(uv_write_t* req, int status) {
 }
 
 void Connection::PendingWrite::flush() {
-  if (!is_flushed_ && !buffers_.empty()) {
+  if (!is_flushed_ && has_buffers()) {
     UvBufVec bufs;
 
-    bufs.reserve(buffers_.size());
+    bufs.reserve(buffer_count());
 
-    for (BufferVec::const_iterator it = buffers_.begin(),
-         end = buffers_.end(); it != end; ++it) {
-      bufs.push_back(uv_buf_init(const_cast<char*>(it->data()), it->size()));
+    for (int i = 0; i < CASS_REQUEST_PRIORITY_COUNT; ++i) {
+      for (BufferVec::const_iterator it = buffers_[i].begin(),
+           end = buffers_[i].end(); it != end; ++it) {
+        bufs.push_back(uv_buf_init(const_cast<char*>(it->data()), it->size()));
+      }
     }
 
     is_flushed_ = true;
@@ -1041,57 +1147,65 @@ void Connection::PendingWriteSsl::encrypt() {
   char buf[SSL_WRITE_SIZE];
 
   size_t copied = 0;
-  size_t offset = 0;
   size_t total = 0;
 
   SslSession* ssl_session = connection_->ssl_session_.get();
 
-  BufferVec::const_iterator it = buffers_.begin(),
-      end = buffers_.end();
-
-  LOG_TRACE("Copying %u bufs", static_cast<unsigned int>(buffers_.size()));
-
-  bool is_done = (it == end);
+  LOG_TRACE("Encrypting %u bufs", static_cast<unsigned int>(buffer_count()));
+
+  // Small buffers are coalesced so that they're sent using full size TLS
+  // records. Buffers that fill a record on their own (e.g. large values) are
+  // encrypted in place instead of being copied.
+  for (int i = 0; i < CASS_REQUEST_PRIORITY_COUNT; ++i) {
+    for (BufferVec::const_iterator it = buffers_[i].begin(),
+         end = buffers_[i].end(); it != end; ++it) {
+      assert(it->size() > 0);
+      const char* data = it->data();
+      size_t size = it->size();
+
+      while (size > 0) {
+        if (copied == 0 && size >= SSL_WRITE_SIZE) {
+          if (!encrypt(ssl_session, data, size)) return;
+          total += size;
+          break;
+        }
 
-  while (!is_done) {
-    assert(it->size() > 0);
-    size_t size = it->size();
+        size_t to_copy = std::min(size, static_cast<size_t>(SSL_WRITE_SIZE) - copied);
+        memcpy(buf + copied, data, to_copy);
+        copied += to_copy;
+        data += to_copy;
+        size -= to_copy;
 
-    size_t to_copy = size - offset;
-    size_t available = SSL_WRITE_SIZE - copied;
-    if (available < to_copy) {
-      to_copy = available;
+        if (copied == SSL_WRITE_SIZE) {
+          if (!encrypt(ssl_session, buf, copied)) return;
+          total += copied;
+          copied = 0;
+        }
+      }
     }
+  }
 
-    memcpy(buf + copied, it->data() + offset, to_copy);
-
-    copied += to_copy;
-    offset += to_copy;
-    total += to_copy;
-
-    if (offset == size) {
-      ++it;
-      offset = 0;
-    }
+  if (copied > 0) {
+    if (!encrypt(ssl_session, buf, copied)) return;
+    total += copied;
+  }
 
-    is_done = (it == end);
+  LOG_TRACE("Encrypted %u bytes", static_cast<unsigned int>(total));
+}
 
-    if (is_done || copied == SSL_WRITE_SIZE) {
-      int rc = ssl_session->encrypt(buf, copied);
-      if (rc <= 0 && ssl_session->has_error()) {
-        connection_->notify_error("Unable to encrypt data: " + ssl_session->error_message(),
-                                  CONNECTION_ERROR_SSL_ENCRYPT);
-        return;
-      }
-      copied = 0;
-    }
+bool Connection::PendingWriteSsl::encrypt(SslSession* ssl_session,
+                                          const char* data, size_t size) {
+  int rc = ssl_session->encrypt(data, size);
+  if (rc <= 0 && ssl_session->has_error()) {
+    connection_->notify_error("Unable to encrypt data: " + ssl_session->error_message(),
+                              CONNECTION_ERROR_SSL_ENCRYPT);
+    return false;
   }
-
-  LOG_TRACE("Copied %u bytes for encryption", static_cast<unsigned int>(total));
+  return true;
 }
 
 void Connection::PendingWriteSsl::flush() {
-  if (!is_flushed_ && !buffers_.empty()) {
+  if (!is_flushed_ && has_buffers()) {
     SslSession* ssl_session = connection_->ssl_session_.get();
 
     rb::RingBuffer::Position prev_pos = ssl_session->outgoing().write_position();
@@ -47,7 +47,7 @@ class Connector;
 class EventResponse;
 class Request;
 
-class Connection {
+class Connection : private ResponseMessage::BodyFilter {
 public:
   enum ConnectionState {
     CONNECTION_STATE_NEW,
@@ -218,11 +218,16 @@ private:
   protected:
     static void on_write(uv_write_t* req, int status);
 
+    bool has_buffers() const;
+    size_t buffer_count() const;
+
     Connection* connection_;
     uv_write_t req_;
     bool is_flushed_;
     size_t size_;
-    BufferVec buffers_;
+    // Requests are coalesced by priority so that higher priority requests are
+    // written ahead of lower priority requests that were queued before them.
+    BufferVec buffers_[CASS_REQUEST_PRIORITY_COUNT];
     List<RequestCallback> callbacks_;
   };
 
@@ -243,6 +248,9 @@ private:
     void encrypt();
     virtual void flush();
 
+  private:
+    bool encrypt(SslSession* ssl_session, const char* data, size_t size);
+
   private:
     size_t encrypted_size_;
     static void on_write(uv_write_t* req, int status);
@@ -263,7 +271,13 @@ private:
   void internal_close(ConnectionState close_state);
   void set_state(ConnectionState state);
   void consume(char* input, size_t size);
+  void consume_body(size_t size);
+  void process_response();
   void maybe_set_keyspace(ResponseMessage* response);
+  void record_wasted_response(ResponseMessage* response);
+
+  // Responses for cancelled requests are skipped without being decoded
+  virtual bool is_body_discarded(int16_t stream) const;
 
   static void on_connect(Connector* connecter);
   static void on_connect_timeout(Timer* timer);
@@ -297,6 +311,7 @@ private:
   void notify_error(const std::string& message, ConnectionError code = CONNECTION_ERROR_GENERIC);
 
   void ssl_handshake();
+  void ssl_kernel_offload();
 
   void send_credentials(const std::string& class_name);
   void send_initial_auth_response(const std::string& class_name);
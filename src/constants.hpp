@@ -108,6 +108,8 @@
 #define CASS_DEFAULT_SERIAL_CONSISTENCY CASS_CONSISTENCY_ANY
 #define CASS_DEFAULT_REQUEST_TIMEOUT_MS 12000u
 
+#define CASS_REQUEST_PRIORITY_COUNT (CASS_REQUEST_PRIORITY_BACKGROUND + 1)
+
 #define CASS_DEFAULT_METADATA_REFRESH_FREQUENCY_SECS 60u
 
 #define CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION 4
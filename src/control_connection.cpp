@@ -160,7 +160,7 @@ void ControlConnection::connect(Session* session) {
     protocol_version_ = CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION;
   }
 
-  if (use_schema_ || token_aware_routing_) {
+  if (use_schema_ || token_aware_routing_ || session_->result_cache() != NULL) {
     set_event_types(CASS_EVENT_TOPOLOGY_CHANGE | CASS_EVENT_STATUS_CHANGE |
                     CASS_EVENT_SCHEMA_CHANGE);
   } else {
@@ -350,6 +350,15 @@ void ControlConnection::on_event(EventResponse* response) {
     }
 
     case CASS_EVENT_SCHEMA_CHANGE:
+      if (session_->result_cache() != NULL) {
+        if (response->schema_change_target() == EventResponse::TABLE) {
+          session_->result_cache()->invalidate_table(response->keyspace().to_string(),
+                                                     response->target().to_string());
+        } else {
+          session_->result_cache()->invalidate_keyspace(response->keyspace().to_string());
+        }
+      }
+
       // Only handle keyspace events when using token-aware routing
       if (!use_schema_ &&
           response->schema_change_target() != EventResponse::KEYSPACE) {
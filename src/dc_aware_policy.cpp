@@ -164,7 +164,7 @@ Host::Ptr DCAwarePolicy::DCAwareQueryPlan::compute_next() {
   while (local_remaining_ > 0) {
     --local_remaining_;
     const Host::Ptr& host(get_next_host(hosts_, index_++));
-    if (host->is_up()) {
+    if (host->is_up() && host->allow_request()) {
       return host;
     }
   }
@@ -184,7 +184,7 @@ Host::Ptr DCAwarePolicy::DCAwareQueryPlan::compute_next() {
       const Host::Ptr& host(get_next_host_bounded(hosts_,
                                                   index_++,
                                                   policy_->used_hosts_per_remote_dc_));
-      if (host->is_up()) {
+      if (host->is_up() && host->allow_request()) {
         return host;
       }
     }
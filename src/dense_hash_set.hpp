@@ -0,0 +1,41 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_DENSE_HASH_SET_HPP_INCLUDED__
+#define __CASS_DENSE_HASH_SET_HPP_INCLUDED__
+
+#include "memory.hpp"
+
+#include <sparsehash/dense_hash_set>
+
+namespace cass {
+
+// A dense hash set that uses the driver's allocator
+template <class V,
+          class HashFcn = SPARSEHASH_HASH<V>,
+          class EqualKey = std::equal_to<V> >
+class DenseHashSet
+    : public sparsehash::dense_hash_set<V, HashFcn, EqualKey, Allocator<V> > {
+public:
+  typedef sparsehash::dense_hash_set<V, HashFcn, EqualKey, Allocator<V> > HashSet;
+
+  explicit DenseHashSet(size_t expected_max_items_in_table = 0)
+    : HashSet(expected_max_items_in_table) { }
+};
+
+} // namespace cass
+
+#endif
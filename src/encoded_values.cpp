@@ -0,0 +1,172 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "encoded_values.hpp"
+
+#include "constants.hpp"
+#include "serialization.hpp"
+
+#include <algorithm>
+#include <assert.h>
+#include <string.h>
+
+// The initial capacity reserved for each value
+#define INITIAL_VALUE_CAPACITY 16
+
+namespace cass {
+
+EncodedValues::EncodedValues(size_t count)
+  : capacity_(0)
+  , size_(0)
+  , collection_count_(0)
+  , external_count_(0) {
+  reset(count);
+}
+
+void EncodedValues::reset(size_t count) {
+  slots_.clear();
+  slots_.resize(count);
+  collection_count_ = 0;
+  external_count_ = 0;
+
+  size_ = 0; // Nothing needs to be preserved
+  reserve_buffer(count * INITIAL_VALUE_CAPACITY);
+
+  char* pos = buffer_ ? buffer_->data() : NULL;
+  for (SlotVec::iterator i = slots_.begin(), end = slots_.end(); i != end; ++i) {
+    i->offset = size_;
+    i->size = sizeof(int32_t);
+    encode_int32(pos + size_, -2); // [bytes] "unset"
+    size_ += sizeof(int32_t);
+  }
+}
+
+bool EncodedValues::is_unset(size_t index) const {
+  const Slot& slot = slots_[index];
+  if (slot.size != sizeof(int32_t)) return false;
+  int32_t size;
+  decode_int32(const_cast<char*>(data() + slot.offset), size);
+  return size == -2;
+}
+
+bool EncodedValues::is_null(size_t index) const {
+  const Slot& slot = slots_[index];
+  if (slot.size != sizeof(int32_t)) return false;
+  int32_t size;
+  decode_int32(const_cast<char*>(data() + slot.offset), size);
+  return size == -1;
+}
+
+void EncodedValues::set_bytes(size_t index, const char* data, size_t size) {
+  set_collection_ref(index, NULL);
+  clear_external(index);
+  char* pos = reserve(index, sizeof(int32_t) + size);
+  encode_int32(pos, static_cast<int32_t>(size));
+  if (size > 0) {
+    memcpy(pos + sizeof(int32_t), data, size);
+  }
+}
+
+void EncodedValues::set_collection(size_t index, const Collection* collection) {
+  Buffer encoded(collection->encode_with_length(CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION));
+  memcpy(reserve(index, encoded.size()), encoded.data(), encoded.size());
+  set_collection_ref(index, collection);
+  clear_external(index);
+}
+
+void EncodedValues::set_external(size_t index, const Buffer& external) {
+  set_collection_ref(index, NULL);
+  encode_int32(reserve(index, sizeof(int32_t)), static_cast<int32_t>(external.size()));
+  Slot& slot = slots_[index];
+  if (!slot.is_external) ++external_count_;
+  slot.is_external = true;
+  slot.external = external;
+}
+
+Buffer EncodedValues::get(size_t index) const {
+  const Slot& slot = slots_[index];
+  if (slot.is_external) {
+    Buffer buf(slot.size + slot.external.size());
+    size_t pos = buf.copy(0, data() + slot.offset, slot.size);
+    buf.copy(pos, slot.external.data(), slot.external.size());
+    return buf;
+  }
+  return Buffer(data() + slot.offset, slot.size);
+}
+
+Buffer EncodedValues::encode() const {
+  assert(external_count_ == 0);
+  if (size_ == 0) return Buffer();
+  return Buffer(buffer_.get(), size_);
+}
+
+void EncodedValues::set_encoded(size_t index, const char* data, size_t size) {
+  set_collection_ref(index, NULL);
+  clear_external(index);
+  memcpy(reserve(index, size), data, size);
+}
+
+char* EncodedValues::reserve(size_t index, size_t size) {
+  Slot& slot = slots_[index];
+  size_t new_size = size_ - slot.size + size;
+
+  reserve_buffer(new_size);
+  char* data = buffer_->data();
+
+  if (size != slot.size) {
+    // Move the values that follow to make room for the new size
+    size_t tail = slot.offset + slot.size;
+    memmove(data + slot.offset + size, data + tail, size_ - tail);
+    for (SlotVec::iterator i = slots_.begin() + index + 1,
+         end = slots_.end(); i != end; ++i) {
+      i->offset = i->offset - slot.size + size;
+    }
+    slot.size = size;
+    size_ = new_size;
+  }
+
+  return data + slot.offset;
+}
+
+void EncodedValues::reserve_buffer(size_t size) {
+  bool is_shared = buffer_ && buffer_->ref_count() > 1;
+  if (!is_shared && size <= capacity_) return;
+
+  size_t capacity = std::max(size, is_shared ? capacity_ : 2 * capacity_);
+  RefBuffer* buffer = RefBuffer::create(capacity);
+  if (size_ > 0) {
+    memcpy(buffer->data(), buffer_->data(), size_);
+  }
+  buffer_.reset(buffer);
+  capacity_ = capacity;
+}
+
+void EncodedValues::set_collection_ref(size_t index, const Collection* collection) {
+  Slot& slot = slots_[index];
+  if (slot.collection) --collection_count_;
+  slot.collection.reset(collection);
+  if (collection != NULL) ++collection_count_;
+}
+
+void EncodedValues::clear_external(size_t index) {
+  Slot& slot = slots_[index];
+  if (!slot.is_external) return;
+  --external_count_;
+  slot.is_external = false;
+  slot.external = Buffer();
+}
+
+} // namespace cass
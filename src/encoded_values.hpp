@@ -0,0 +1,126 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_ENCODED_VALUES_HPP_INCLUDED__
+#define __CASS_ENCODED_VALUES_HPP_INCLUDED__
+
+#include "buffer.hpp"
+#include "collection.hpp"
+#include "ref_counted.hpp"
+
+#include <vector>
+
+namespace cass {
+
+// Bound values encoded back-to-back as [bytes] in a single contiguous
+// buffer, so that all of the values can be written to a request as one
+// buffer without copying. A value that's rebound with the same encoded size
+// is overwritten in place; otherwise, the values that follow it are moved.
+// The buffer is copied before it's modified if it's still referenced by a
+// request that was previously encoded or by a copy (copy-on-write), so
+// copies are cheap.
+class EncodedValues {
+public:
+  explicit EncodedValues(size_t count);
+
+  size_t count() const { return slots_.size(); }
+
+  // The size of all of the encoded values
+  size_t size() const { return size_; }
+
+  // Resets all of the values to "unset"
+  void reset(size_t count);
+
+  bool is_unset(size_t index) const;
+  bool is_null(size_t index) const;
+
+  const Collection* collection(size_t index) const {
+    return slots_[index].collection.get();
+  }
+
+  bool has_collections() const { return collection_count_ > 0; }
+
+  // External values are memory owned by the application. Only their
+  // [bytes] length is kept in the contiguous buffer.
+  const Buffer* external(size_t index) const {
+    const Slot& slot = slots_[index];
+    return slot.is_external ? &slot.external : NULL;
+  }
+
+  bool has_externals() const { return external_count_ > 0; }
+
+  // Sets a value that's already encoded as [bytes]
+  void set(size_t index, const Buffer& value) {
+    set_encoded(index, value.data(), value.size());
+  }
+
+  // Sets a value by encoding "data" as [bytes]
+  void set_bytes(size_t index, const char* data, size_t size);
+
+  // Collections are encoded using the highest supported protocol version.
+  // The collection is kept so it can be re-encoded for older versions.
+  void set_collection(size_t index, const Collection* collection);
+
+  void set_external(size_t index, const Buffer& external);
+
+  // A copy of the value's [bytes]
+  Buffer get(size_t index) const;
+
+  size_t get_size(size_t index) const {
+    const Slot& slot = slots_[index];
+    return slot.size + slot.external.size();
+  }
+
+  // All of the values as a single buffer that shares the contiguous buffer.
+  // This can't be used when there are external values.
+  Buffer encode() const;
+
+private:
+  struct Slot {
+    Slot()
+      : offset(0)
+      , size(0)
+      , is_external(false) { }
+
+    size_t offset;
+    size_t size;
+    SharedRefPtr<const Collection> collection;
+    bool is_external;
+    Buffer external;
+  };
+
+  typedef std::vector<Slot> SlotVec;
+
+  void set_encoded(size_t index, const char* data, size_t size);
+  char* reserve(size_t index, size_t size);
+  void reserve_buffer(size_t size);
+  void set_collection_ref(size_t index, const Collection* collection);
+  void clear_external(size_t index);
+
+  const char* data() const { return buffer_->data(); }
+
+private:
+  RefBuffer::Ptr buffer_;
+  size_t capacity_;
+  size_t size_;
+  SlotVec slots_;
+  size_t collection_count_;
+  size_t external_count_;
+};
+
+} // namespace cass
+
+#endif
@@ -29,8 +29,10 @@ namespace cass {
 template <class E>
 class EventThread : public LoopThread {
 public:
-  int init(size_t queue_size) {
-    int rc = LoopThread::init();
+  int init(size_t queue_size,
+           bool is_external = false,
+           uv_loop_t* external_loop = NULL) {
+    int rc = LoopThread::init(is_external, external_loop);
     if (rc != 0) return rc;
     event_queue_.reset(new AsyncQueue<MPMCQueue<E> >(queue_size));
     return event_queue_->init(loop(), this, on_event_internal);
@@ -26,6 +26,46 @@ ExecuteRequest::ExecuteRequest(const Prepared* prepared)
   : Statement(prepared)
   , prepared_(prepared) { }
 
+template <class T>
+static void append_value(T value, std::string* key) {
+  key->append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+bool ExecuteRequest::get_result_key(std::string* key) const {
+  const ResultMetadata::Ptr& result_metadata(prepared_->result()->result_metadata());
+  if (!result_metadata || result_metadata->column_count() == 0 || custom_payload()) {
+    return false;
+  }
+
+  key->clear();
+  append_value(static_cast<uint32_t>(prepared_->id().size()), key);
+  key->append(prepared_->id());
+  append_value(static_cast<int32_t>(consistency()), key);
+  append_value(static_cast<int32_t>(serial_consistency()), key);
+  append_value(page_size(), key);
+  append_value(static_cast<uint32_t>(paging_state().size()), key);
+  key->append(paging_state());
+
+  // Values are already encoded with their lengths. Collections are encoded
+  // using a fixed protocol version because the key only needs to be unique.
+  const EncodedValues* encoded = encoded_values();
+  if (encoded != NULL && !encoded->has_externals()) {
+    // Unset values are already encoded as -2
+    Buffer buf(encoded->encode());
+    key->append(buf.data(), buf.size());
+    return true;
+  }
+  for (size_t i = 0; i < elements_count(); ++i) {
+    if (is_unset(i)) {
+      append_value(static_cast<int32_t>(-2), key);
+    } else {
+      Buffer buf(get_buffer(i, CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION));
+      key->append(buf.data(), buf.size());
+    }
+  }
+  return true;
+}
+
 int ExecuteRequest::encode(int version, RequestCallback* callback, BufferVec* bufs) const {
   if (version == 1) {
     return encode_v1(callback, bufs);
@@ -42,7 +82,7 @@ int ExecuteRequest::encode(int version, RequestCallback* callback, BufferVec* bu
         length += bufs->back().size();
       }
     }
-    length += encode_begin(version, elements().size(), callback, bufs);
+    length += encode_begin(version, elements_count(), callback, bufs);
     int32_t result = encode_values(version, callback, bufs);
     if (result < 0) return result;
     length += result;
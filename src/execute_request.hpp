@@ -33,13 +33,27 @@ public:
 
   const Prepared::ConstPtr& prepared() const { return prepared_; }
 
+  virtual ExecuteRequest* clone() const {
+    return new ExecuteRequest(*this);
+  }
+
   virtual int encode(int version, RequestCallback* callback, BufferVec* bufs) const;
 
   bool get_routing_key(std::string* routing_key)  const {
     return calculate_routing_key(prepared_->key_indices(), routing_key);
   }
 
+  // Builds a key that identifies the rows returned by the statement: its
+  // prepared ID, bound values and the settings that change which rows are
+  // returned. It returns false if the statement doesn't return rows or can't
+  // be identified (e.g. it has a custom payload).
+  bool get_result_key(std::string* key) const;
+
 private:
+  ExecuteRequest(const ExecuteRequest& other)
+    : Statement(other)
+    , prepared_(other.prepared_) { }
+
   virtual size_t get_indices(StringRef name, IndexVec* indices) {
     return prepared_->result()->metadata()->get_indices(name, indices);
   }
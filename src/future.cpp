@@ -16,6 +16,7 @@
 
 #include "future.hpp"
 
+#include "completion_queue.hpp"
 #include "external.hpp"
 #include "prepared.hpp"
 #include "request_handler.hpp"
@@ -51,6 +52,33 @@ cass_bool_t cass_future_wait_timed(CassFuture* future, cass_duration_t wait_us)
   return static_cast<cass_bool_t>(future->wait_for(wait_us));
 }
 
+size_t cass_future_wait_any(CassFuture** futures, size_t count) {
+  size_t index = count;
+  cass_future_wait_any_timed(futures, count, cass::Future::WAIT_FOREVER, &index);
+  return index;
+}
+
+cass_bool_t cass_future_wait_any_timed(CassFuture** futures, size_t count,
+                                       cass_duration_t wait_us, size_t* index) {
+  cass::Future::Vec internal_futures(futures, futures + count);
+  int result = cass::Future::wait_any(internal_futures, wait_us);
+  if (result < 0) {
+    return cass_false;
+  }
+  *index = static_cast<size_t>(result);
+  return cass_true;
+}
+
+void cass_future_wait_all(CassFuture** futures, size_t count) {
+  cass_future_wait_all_timed(futures, count, cass::Future::WAIT_FOREVER);
+}
+
+cass_bool_t cass_future_wait_all_timed(CassFuture** futures, size_t count,
+                                       cass_duration_t wait_us) {
+  cass::Future::Vec internal_futures(futures, futures + count);
+  return static_cast<cass_bool_t>(cass::Future::wait_all(internal_futures, wait_us));
+}
+
 const CassResult* cass_future_get_result(CassFuture* future) {
   if (future->type() != cass::CASS_FUTURE_TYPE_RESPONSE) {
     return NULL;
@@ -166,14 +194,175 @@ CassError cass_future_custom_payload_item(CassFuture* future,
 
 namespace cass {
 
+// A thread waiting on one or more futures. It has its own lock so that it
+// can be notified by any of the futures it's waiting on.
+class Future::Waiter {
+public:
+  Waiter()
+    : is_notified_(false) {
+    uv_mutex_init(&mutex_);
+    uv_cond_init(&cond_);
+  }
+
+  ~Waiter() {
+    uv_mutex_destroy(&mutex_);
+    uv_cond_destroy(&cond_);
+  }
+
+  void notify() {
+    ScopedMutex lock(&mutex_);
+    is_notified_ = true;
+    uv_cond_signal(&cond_);
+  }
+
+  // Returns false if the deadline passed before the waiter was notified
+  bool wait(uint64_t deadline_ns) {
+    ScopedMutex lock(&mutex_);
+    while (!is_notified_) {
+      if (deadline_ns == WAIT_FOREVER) {
+        uv_cond_wait(&cond_, lock.get());
+      } else {
+        uint64_t now_ns = uv_hrtime();
+        if (now_ns >= deadline_ns ||
+            uv_cond_timedwait(&cond_, lock.get(), deadline_ns - now_ns) != 0) {
+          break;
+        }
+      }
+    }
+    bool is_notified = is_notified_;
+    is_notified_ = false;
+    return is_notified;
+  }
+
+private:
+  uv_mutex_t mutex_;
+  uv_cond_t cond_;
+  bool is_notified_;
+};
+
+static uint64_t deadline(uint64_t timeout_us) {
+  if (timeout_us == Future::WAIT_FOREVER) {
+    return Future::WAIT_FOREVER;
+  }
+  return uv_hrtime() + timeout_us * 1000;
+}
+
+Future::~Future() {
+  if (completion_queue_ != NULL) {
+    completion_queue_->dec_ref();
+  }
+  uv_mutex_destroy(&mutex_);
+}
+
+bool Future::internal_wait_for(ScopedMutex& lock, uint64_t timeout_us) {
+  if (is_set() || timeout_us == 0) {
+    return is_set();
+  }
+  Waiter waiter;
+  WaiterNode node(&waiter);
+  add_waiter(&node);
+  lock.unlock();
+  waiter.wait(deadline(timeout_us));
+  lock.lock();
+  remove_waiter(&node);
+  return is_set();
+}
+
+int Future::wait_any(const Vec& futures, uint64_t timeout_us) {
+  if (futures.empty()) return -1;
+
+  Waiter waiter;
+  std::vector<WaiterNode> nodes(futures.size(), WaiterNode(&waiter));
+  uint64_t deadline_ns = deadline(timeout_us);
+  int index = -1;
+
+  // The waiter is added to all of the futures so that the first one set
+  // wakes it up
+  for (size_t i = 0; i < futures.size() && index < 0; ++i) {
+    ScopedMutex lock(&futures[i]->mutex_);
+    if (futures[i]->is_set()) {
+      index = static_cast<int>(i);
+    } else {
+      futures[i]->add_waiter(&nodes[i]);
+    }
+  }
+
+  if (index < 0 && timeout_us > 0) {
+    waiter.wait(deadline_ns);
+  }
+
+  for (size_t i = 0; i < futures.size(); ++i) {
+    ScopedMutex lock(&futures[i]->mutex_);
+    futures[i]->remove_waiter(&nodes[i]);
+    if (index < 0 && futures[i]->is_set()) {
+      index = static_cast<int>(i);
+    }
+  }
+
+  return index;
+}
+
+bool Future::wait_all(const Vec& futures, uint64_t timeout_us) {
+  uint64_t deadline_ns = deadline(timeout_us);
+  for (Vec::const_iterator it = futures.begin(), end = futures.end();
+       it != end; ++it) {
+    uint64_t remaining_us = WAIT_FOREVER;
+    if (deadline_ns != WAIT_FOREVER) {
+      uint64_t now_ns = uv_hrtime();
+      remaining_us = now_ns < deadline_ns ? (deadline_ns - now_ns) / 1000 : 0;
+    }
+    if (!(*it)->wait_for(remaining_us)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void Future::add_waiter(WaiterNode* node) {
+  node->prev = NULL;
+  node->next = waiters_;
+  if (waiters_ != NULL) {
+    waiters_->prev = node;
+  }
+  waiters_ = node;
+  node->is_linked = true;
+}
+
+void Future::remove_waiter(WaiterNode* node) {
+  if (!node->is_linked) return;
+  if (node->prev != NULL) {
+    node->prev->next = node->next;
+  } else {
+    waiters_ = node->next;
+  }
+  if (node->next != NULL) {
+    node->next->prev = node->prev;
+  }
+  node->is_linked = false;
+}
+
+void Future::notify_waiters() {
+  // The waiters are removed from the list before they're notified and they
+  // remove themselves (from all of their futures) under the futures' locks
+  // before they're destroyed
+  WaiterNode* node = waiters_;
+  waiters_ = NULL;
+  while (node != NULL) {
+    WaiterNode* next = node->next;
+    node->is_linked = false;
+    node->waiter->notify();
+    node = next;
+  }
+}
+
 bool Future::set_callback(Future::Callback callback, void* data) {
   ScopedMutex lock(&mutex_);
-  if (callback_) {
+  if (callback_ || completion_queue_ != NULL) {
     return false; // Callback is already set
   }
   callback_ = callback;
   data_ = data;
-  if (is_set_) {
+  if (is_set()) {
     // Run the callback if the future is already set
     lock.unlock();
     callback(CassFuture::to(this), data);
@@ -181,18 +370,43 @@ bool Future::set_callback(Future::Callback callback, void* data) {
   return true;
 }
 
+bool Future::set_completion_queue(CompletionQueue* completion_queue, void* data) {
+  ScopedMutex lock(&mutex_);
+  if (callback_ || completion_queue_ != NULL) {
+    return false;
+  }
+  if (is_set()) {
+    lock.unlock();
+    completion_queue->push(this, data);
+    return true;
+  }
+  // The queue is kept alive until the future is set
+  completion_queue->inc_ref();
+  completion_queue_ = completion_queue;
+  data_ = data;
+  return true;
+}
+
 void Future::internal_set(ScopedMutex& lock) {
-  is_set_ = true;
-  if (callback_) {
+  is_set_.store(true, MEMORY_ORDER_RELEASE);
+  if (completion_queue_ != NULL) {
+    CompletionQueue* completion_queue = completion_queue_;
+    void* data = data_;
+    completion_queue_ = NULL;
+    lock.unlock();
+    completion_queue->push(this, data);
+    completion_queue->dec_ref();
+    lock.lock();
+  } else if (callback_) {
     Callback callback = callback_;
     void* data = data_;
     lock.unlock();
     callback(CassFuture::to(this), data);
     lock.lock();
   }
-  // Broadcast after we've run the callback so that threads waiting
+  // Notify after we've run the callback so that threads waiting
   // on this future see the side effects of the callback.
-  uv_cond_broadcast(&cond_);
+  notify_waiters();
 }
 
 } // namespace cass
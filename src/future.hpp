@@ -22,6 +22,7 @@
 #include "external.hpp"
 #include "host.hpp"
 #include "macros.hpp"
+#include "object_pool.hpp"
 #include "scoped_lock.hpp"
 #include "scoped_ptr.hpp"
 #include "ref_counted.hpp"
@@ -29,9 +30,11 @@
 #include <uv.h>
 #include <assert.h>
 #include <string>
+#include <vector>
 
 namespace cass {
 
+class CompletionQueue;
 struct Error;
 
 enum FutureType {
@@ -39,7 +42,7 @@ enum FutureType {
   CASS_FUTURE_TYPE_RESPONSE
 };
 
-class Future : public RefCounted<Future> {
+class Future : public PooledRefCounted<Future> {
 public:
   typedef SharedRefPtr<Future> Ptr;
   typedef void (*Callback)(CassFuture*, void*);
@@ -53,24 +56,23 @@ public:
     std::string message;
   };
 
+  typedef std::vector<Future*> Vec;
+
   Future(FutureType type)
       : is_set_(false)
+      , waiters_(NULL)
       , type_(type)
-      , callback_(NULL) {
+      , callback_(NULL)
+      , completion_queue_(NULL) {
     uv_mutex_init(&mutex_);
-    uv_cond_init(&cond_);
   }
 
-  virtual ~Future() {
-    uv_mutex_destroy(&mutex_);
-    uv_cond_destroy(&cond_);
-  }
+  virtual ~Future();
 
   FutureType type() const { return type_; }
 
-  bool ready() {
-    ScopedMutex lock(&mutex_);
-    return is_set_;
+  bool ready() const {
+    return is_set_.load(MEMORY_ORDER_ACQUIRE);
   }
 
   virtual void wait() {
@@ -96,7 +98,7 @@ public:
 
   bool set_error(CassError code, const std::string& message) {
     ScopedMutex lock(&mutex_);
-    if (!is_set_) {
+    if (!is_set()) {
       internal_set_error(code, message, lock);
       return true;
     }
@@ -105,23 +107,28 @@ public:
 
   bool set_callback(Callback callback, void* data);
 
+  // The future is added to the queue when it's set instead of running a
+  // callback. A future can either have a callback or a completion queue.
+  bool set_completion_queue(CompletionQueue* completion_queue, void* data);
+
+  static const uint64_t WAIT_FOREVER = CASS_UINT64_MAX;
+
+  // Waits until one of the futures is set or the timeout expires. Returns
+  // the index of the first set future found or -1 if the timeout expired.
+  static int wait_any(const Vec& futures, uint64_t timeout_us = WAIT_FOREVER);
+
+  // Waits until all of the futures are set or the timeout expires. Returns
+  // false if the timeout expired.
+  static bool wait_all(const Vec& futures, uint64_t timeout_us = WAIT_FOREVER);
+
 protected:
-  bool is_set() const { return is_set_; }
+  bool is_set() const { return is_set_.load(MEMORY_ORDER_RELAXED); }
 
   void internal_wait(ScopedMutex& lock) {
-    while (!is_set_) {
-      uv_cond_wait(&cond_, lock.get());
-    }
+    internal_wait_for(lock, WAIT_FOREVER);
   }
 
-  bool internal_wait_for(ScopedMutex& lock, uint64_t timeout_us) {
-    if (!is_set_) {
-      if (uv_cond_timedwait(&cond_, lock.get(), timeout_us * 1000) != 0) { // Expects nanos
-        return false;
-      }
-    }
-    return is_set_;
-  }
+  bool internal_wait_for(ScopedMutex& lock, uint64_t timeout_us);
 
   void internal_set(ScopedMutex& lock);
 
@@ -133,11 +140,36 @@ protected:
   uv_mutex_t mutex_;
 
 private:
-  bool is_set_;
-  uv_cond_t cond_;
+  class Waiter;
+
+  // A waiter's place in a future's list of waiters. A waiter can be in the
+  // lists of many futures (see wait_any()).
+  struct WaiterNode {
+    WaiterNode(Waiter* waiter)
+      : waiter(waiter)
+      , prev(NULL)
+      , next(NULL)
+      , is_linked(false) { }
+
+    Waiter* waiter;
+    WaiterNode* prev;
+    WaiterNode* next;
+    bool is_linked;
+  };
+
+  void add_waiter(WaiterNode* node);
+  void remove_waiter(WaiterNode* node);
+  void notify_waiters();
+
+private:
+  Atomic<bool> is_set_;
+  // Threads waiting on the future. A condition variable is only created for
+  // the futures that are actually waited on.
+  WaiterNode* waiters_;
   FutureType type_;
   ScopedPtr<Error> error_;
   Callback callback_;
+  CompletionQueue* completion_queue_;
   void* data_;
 
 private:
@@ -16,6 +16,8 @@
 
 #include "host.hpp"
 
+#include <algorithm>
+
 namespace cass {
 
 void add_host(CopyOnWriteHostVec& hosts, const Host::Ptr& host) {
@@ -41,30 +43,101 @@ void remove_host(CopyOnWriteHostVec& hosts, const Host::Ptr& host) {
   }
 }
 
+// The relative step used to move the tail estimate towards its quantile
+#define TAIL_STEP 0.05
+
+Host::LatencyTracker::LatencyTracker(uint64_t scale_ns,
+                                     uint64_t threshold_to_account,
+                                     double tail_quantile)
+  : scale_ns_(scale_ns)
+  , threshold_to_account_(threshold_to_account)
+  , tail_quantile_(tail_quantile)
+  , pending_above_tail_(0)
+  , sequence_(0)
+  , average_(-1)
+  , tail_(-1)
+  , timestamp_(0)
+  , num_measured_(0) { }
+
 void Host::LatencyTracker::update(uint64_t latency_ns) {
-  uint64_t now = uv_hrtime();
+  if (tail_quantile_ > 0.0) {
+    int64_t tail = tail_.load(MEMORY_ORDER_RELAXED);
+    if (tail >= 0 && static_cast<int64_t>(latency_ns) > tail) {
+      pending_above_tail_.fetch_add(1, MEMORY_ORDER_RELAXED);
+    }
+  }
+  pending_.add(latency_ns); // Dropped if a merge has fallen this far behind
 
-  ScopedSpinlock l(SpinlockPool<LatencyTracker>::get_spinlock(this));
+  uint64_t sequence = sequence_.load(MEMORY_ORDER_RELAXED);
+  if ((sequence & 1) == 0 &&
+      sequence_.compare_exchange_strong(sequence, sequence + 1, MEMORY_ORDER_ACQUIRE)) {
+    merge(uv_hrtime());
+    sequence_.store(sequence + 2, MEMORY_ORDER_RELEASE);
+  }
+}
 
-  TimestampedAverage previous = current_;
+TimestampedAverage Host::LatencyTracker::get() const {
+  TimestampedAverage current;
+  uint64_t sequence;
+  do {
+    while ((sequence = sequence_.load(MEMORY_ORDER_ACQUIRE)) & 1) { }
+    current.average = average_.load(MEMORY_ORDER_RELAXED);
+    current.tail = tail_.load(MEMORY_ORDER_RELAXED);
+    current.timestamp = timestamp_.load(MEMORY_ORDER_RELAXED);
+    current.num_measured = num_measured_.load(MEMORY_ORDER_RELAXED);
+    atomic_thread_fence(MEMORY_ORDER_ACQUIRE);
+  } while (sequence != sequence_.load(MEMORY_ORDER_RELAXED));
+  return current;
+}
 
-  if (previous.num_measured < threshold_to_account_) {
-    current_.average = -1;
-  } else if (previous.average < 0) {
-    current_.average = latency_ns;
-  } else {
-    int64_t delay = now - previous.timestamp;
-    if (delay <= 0) {
-      return;
-    }
+void Host::LatencyTracker::merge(uint64_t now) {
+  int64_t average = average_.load(MEMORY_ORDER_RELAXED);
+  uint64_t timestamp = timestamp_.load(MEMORY_ORDER_RELAXED);
+  uint64_t num_measured = num_measured_.load(MEMORY_ORDER_RELAXED);
+
+  bool is_accounted = num_measured >= threshold_to_account_ && average >= 0;
+  int64_t delay = now - timestamp;
+  if (is_accounted && delay <= 0) {
+    return; // Leave the latencies to be merged later
+  }
+
+  uint64_t count, sum;
+  pending_.take(&count, &sum);
+  if (count == 0) return;
+  uint64_t above_tail = pending_above_tail_.exchange(0, MEMORY_ORDER_RELAXED);
+  if (above_tail > count) above_tail = count;
+
+  int64_t latency_ns = static_cast<int64_t>(sum / count);
 
+  if (num_measured < threshold_to_account_) {
+    average = -1;
+  } else if (average < 0) {
+    average = latency_ns;
+  } else {
     double scaled_delay = static_cast<double>(delay) / scale_ns_;
     double weight = log(scaled_delay + 1) / scaled_delay;
-    current_.average = static_cast<int64_t>((1.0 - weight) * latency_ns + weight * previous.average);
+    average = static_cast<int64_t>((1.0 - weight) * latency_ns + weight * average);
+  }
+
+  if (tail_quantile_ > 0.0) {
+    int64_t tail = tail_.load(MEMORY_ORDER_RELAXED);
+    if (tail < 0) {
+      tail = latency_ns;
+    } else {
+      // Move up for latencies above the estimate and down for the rest so
+      // that the estimate settles where (1 - quantile) of them are above it.
+      double factor = pow(1.0 + TAIL_STEP * tail_quantile_,
+                          static_cast<double>(above_tail)) *
+                      pow(1.0 - TAIL_STEP * (1.0 - tail_quantile_),
+                          static_cast<double>(count - above_tail));
+      tail = std::max(static_cast<int64_t>(tail * factor), static_cast<int64_t>(1));
+    }
+    tail_.store(tail, MEMORY_ORDER_RELAXED);
   }
 
-  current_.num_measured = previous.num_measured + 1;
-  current_.timestamp = now;
+  average_.store(average, MEMORY_ORDER_RELAXED);
+  timestamp_.store(now, MEMORY_ORDER_RELAXED);
+  num_measured_.store(num_measured + count, MEMORY_ORDER_RELAXED);
 }
 
 bool VersionNumber::parse(const std::string& version) {
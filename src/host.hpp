@@ -19,13 +19,16 @@
 
 #include "address.hpp"
 #include "atomic.hpp"
+#include "circuit_breaker.hpp"
+#include "concurrency_limiter.hpp"
 #include "copy_on_write_ptr.hpp"
 #include "get_time.hpp"
 #include "logger.hpp"
 #include "macros.hpp"
+#include "packed_sum.hpp"
+#include "rate_limiter.hpp"
 #include "ref_counted.hpp"
 #include "scoped_ptr.hpp"
-#include "spin_lock.hpp"
 
 #include <map>
 #include <math.h>
@@ -39,10 +42,12 @@ namespace cass {
 struct TimestampedAverage {
   TimestampedAverage()
     : average(-1)
+    , tail(-1)
     , timestamp(0)
     , num_measured(0) { }
 
   int64_t average;
+  int64_t tail; // An estimate of a high percentile (-1 if not tracked)
   uint64_t timestamp;
   uint64_t num_measured;
 };
@@ -118,7 +123,8 @@ public:
       , dc_id_(0)
       , mark_(mark)
       , state_(ADDED)
-      , address_string_(address.to_string()) { }
+      , address_string_(address.to_string())
+      , inflight_requests_(0) { }
 
   const Address& address() const { return address_; }
   const std::string& address_string() const { return address_string_; }
@@ -176,9 +182,11 @@ public:
     return ss.str();
   }
 
-  void enable_latency_tracking(uint64_t scale, uint64_t min_measured) {
+  void enable_latency_tracking(uint64_t scale, uint64_t min_measured,
+                               double tail_percentile = 0.0) {
     if (!latency_tracker_) {
-      latency_tracker_.reset(new LatencyTracker(scale, (30LL * min_measured) / 100LL));
+      latency_tracker_.reset(new LatencyTracker(scale, (30LL * min_measured) / 100LL,
+                                                tail_percentile / 100.0));
     }
   }
 
@@ -196,24 +204,133 @@ public:
     return TimestampedAverage();
   }
 
+  void enable_rate_limiting(const RateLimiter::Settings& settings) {
+    if (!rate_limiter_ && settings.is_enabled()) {
+      rate_limiter_.reset(new RateLimiter(settings));
+    }
+  }
+
+  // Takes a token from the host's rate limiter. It returns false if the
+  // host has reached its rate limit.
+  bool acquire_rate_limit() {
+    return !rate_limiter_ || rate_limiter_->try_acquire(get_time_monotonic_ns());
+  }
+
+  void enable_concurrency_limiting(const ConcurrencyLimiter::Settings& settings) {
+    if (!concurrency_limiter_ && settings.is_enabled()) {
+      concurrency_limiter_.reset(new ConcurrencyLimiter(settings));
+    }
+  }
+
+  // Adjusts the adaptive concurrency limit using a request's latency or a
+  // request that timed out (or was rejected because the host is overloaded)
+  void update_concurrency_limit(uint64_t latency_ns) {
+    if (concurrency_limiter_) {
+      concurrency_limiter_->on_sample(get_time_monotonic_ns(), latency_ns,
+                                      inflight_requests());
+    }
+  }
+  void drop_concurrency_limit() {
+    if (concurrency_limiter_) {
+      concurrency_limiter_->on_drop(get_time_monotonic_ns(), inflight_requests());
+    }
+  }
+
+  // The current limit on the number of requests in flight to the host (0 if
+  // the limit isn't enabled)
+  unsigned concurrency_limit() const {
+    return concurrency_limiter_ ? concurrency_limiter_->limit() : 0;
+  }
+  bool is_at_concurrency_limit() const {
+    return concurrency_limiter_ && concurrency_limiter_->is_at_limit(inflight_requests());
+  }
+
+  // Wakes the loop once the host drops below its concurrency limit. Returns
+  // false if it's no longer at its limit.
+  bool wait_for_concurrency(const LoopWaker::Ptr& waker) const {
+    return concurrency_limiter_ &&
+        concurrency_limiter_->add_waiter(waker, inflight_requests_);
+  }
+
+  void enable_circuit_breaker(const CircuitBreaker::Settings& settings) {
+    if (!circuit_breaker_ && settings.is_enabled()) {
+      circuit_breaker_.reset(new CircuitBreaker(settings));
+    }
+  }
+
+  // Query plans skip the host while this returns false (its circuit breaker
+  // is open or half-open with a probe already in flight)
+  bool allow_request() {
+    return !circuit_breaker_ || circuit_breaker_->allow_request(uv_hrtime());
+  }
+
+  // Records the outcome of a request for the host's circuit breaker. Only
+  // timeouts and errors that indicate a problem with the host are failures.
+  // "request_started_ns" is when the request was sent to the host (from
+  // uv_hrtime()) or 0 if it wasn't.
+  void record_request_success(uint64_t request_started_ns) {
+    if (circuit_breaker_ &&
+        circuit_breaker_->on_success(uv_hrtime(), request_started_ns)) {
+      LOG_INFO("Circuit breaker closed for host %s", address_string_.c_str());
+    }
+  }
+  void record_request_failure(uint64_t request_started_ns) {
+    if (circuit_breaker_ &&
+        circuit_breaker_->on_failure(uv_hrtime(), request_started_ns)) {
+      LOG_WARN("Circuit breaker opened for host %s", address_string_.c_str());
+    }
+  }
+
+  // The number of requests written to the host that are waiting for a
+  // response (across all connections). It's updated by the connections so
+  // it can be changed through a const host.
+  int64_t inflight_requests() const {
+    return inflight_requests_.load(MEMORY_ORDER_RELAXED);
+  }
+  void inc_inflight_requests() const {
+    inflight_requests_.fetch_add(1, MEMORY_ORDER_RELAXED);
+  }
+  void dec_inflight_requests(int64_t count = 1) const {
+    inflight_requests_.fetch_sub(count, MEMORY_ORDER_RELAXED);
+    if (concurrency_limiter_) {
+      concurrency_limiter_->notify_waiters(inflight_requests_);
+    }
+  }
+
 private:
+  // Latencies are recorded by all I/O threads and read by query plans
+  // without locking. Threads add their latencies to pending totals then
+  // try to become the single thread that merges them into the averages.
+  // A thread that loses just leaves its latency to be merged by the next
+  // one. The averages are published using a sequence lock so readers get a
+  // consistent snapshot without blocking writers.
   class LatencyTracker {
   public:
-    LatencyTracker(uint64_t scale_ns, uint64_t threshold_to_account)
-      : scale_ns_(scale_ns)
-      , threshold_to_account_(threshold_to_account) { }
+    LatencyTracker(uint64_t scale_ns, uint64_t threshold_to_account,
+                   double tail_quantile);
 
     void update(uint64_t latency_ns);
 
-    TimestampedAverage get() const {
-      ScopedSpinlock l(SpinlockPool<LatencyTracker>::get_spinlock(this));
-      return current_;
-    }
+    TimestampedAverage get() const;
 
   private:
-    uint64_t scale_ns_;
-    uint64_t threshold_to_account_;
-    TimestampedAverage current_;
+    void merge(uint64_t now);
+
+  private:
+    const uint64_t scale_ns_;
+    const uint64_t threshold_to_account_;
+    const double tail_quantile_;
+
+    // The count and sum (in nanoseconds) of the latencies not merged yet
+    PackedSum pending_;
+    Atomic<uint64_t> pending_above_tail_;
+
+    // Odd while a thread is merging
+    Atomic<uint64_t> sequence_;
+    Atomic<int64_t> average_;
+    Atomic<int64_t> tail_;
+    Atomic<uint64_t> timestamp_;
+    Atomic<uint64_t> num_measured_;
 
   private:
     DISALLOW_COPY_AND_ASSIGN(LatencyTracker);
@@ -241,6 +358,10 @@ private:
   std::string dc_;
 
   ScopedPtr<LatencyTracker> latency_tracker_;
+  ScopedPtr<RateLimiter> rate_limiter_;
+  ScopedPtr<ConcurrencyLimiter> concurrency_limiter_;
+  ScopedPtr<CircuitBreaker> circuit_breaker_;
+  mutable Atomic<int64_t> inflight_requests_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(Host);
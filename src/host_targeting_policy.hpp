@@ -18,10 +18,10 @@
 #define __CASS_HOST_TARGETING_POLICY_HPP_INCLUDED__
 
 #include "address.hpp"
+#include "dense_hash_map.hpp"
 #include "load_balancing.hpp"
 #include "request_handler.hpp"
 
-#include <sparsehash/dense_hash_map>
 
 namespace cass {
 
@@ -65,7 +65,7 @@ private:
   };
 
 private:
-  typedef sparsehash::dense_hash_map<Address, Host::Ptr, AddressHash> HostMap;
+  typedef DenseHashMap<Address, Host::Ptr, AddressHash> HostMap;
   HostMap available_hosts_;
 };
 
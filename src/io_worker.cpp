@@ -141,7 +141,9 @@ IOWorker::IOWorker(Session* session)
     , metrics_(session->metrics())
     , protocol_version_(-1)
     , pending_request_count_(0)
-    , request_queue_(config_.queue_size_io()) {
+    , request_queue_(config_.queue_size_io())
+    , waker_(new LoopWaker())
+    , prioritized_request_count_(0) {
   pools_.set_empty_key(Address::EMPTY_KEY);
   pools_.set_deleted_key(Address::DELETED_KEY);
   check_.data = this;
@@ -154,10 +156,21 @@ IOWorker::~IOWorker() {
 }
 
 int IOWorker::init() {
-  int rc = EventThread<IOWorkerEvent>::init(config_.queue_size_event());
+  // An external session shares its loop with the IO worker
+  int rc = EventThread<IOWorkerEvent>::init(config_.queue_size_event(),
+                                            session_->is_external(),
+                                            session_->is_external() ? session_->loop() : NULL);
   if (rc != 0) return rc;
   rc = request_queue_.init(loop(), this, &IOWorker::on_execute);
   if (rc != 0) return rc;
+  rc = waker_->init(loop(), this, &IOWorker::on_wake);
+  if (rc != 0) return rc;
+  if (session_->is_sharded()) {
+    sharded_request_queue_.reset(
+          new AsyncQueue<MPMCQueue<RequestHandler*> >(config_.queue_size_io()));
+    rc = sharded_request_queue_->init(loop(), this, &IOWorker::on_execute_sharded);
+    if (rc != 0) return rc;
+  }
   rc = uv_check_init(loop(), &check_);
   if (rc != 0) return rc;
   rc = uv_check_start(&check_, on_check);
@@ -189,7 +202,7 @@ bool IOWorker::is_host_up(const Address& address) const {
   return it != pools_.end() && it->second->is_ready();
 }
 
-bool IOWorker::add_pool_async(const Host::ConstPtr& host, bool is_initial_connection) {
+bool IOWorker::add_pool_async(const Host::Ptr& host, bool is_initial_connection) {
   IOWorkerEvent event;
   event.type = IOWorkerEvent::ADD_POOL;
   event.host = host;
@@ -197,7 +210,7 @@ bool IOWorker::add_pool_async(const Host::ConstPtr& host, bool is_initial_connec
   return send_event_async(event);
 }
 
-bool IOWorker::remove_pool_async(const Host::ConstPtr& host, bool cancel_reconnect) {
+bool IOWorker::remove_pool_async(const Host::Ptr& host, bool cancel_reconnect) {
   IOWorkerEvent event;
   event.type = IOWorkerEvent::REMOVE_POOL;
   event.host = host;
@@ -205,6 +218,27 @@ bool IOWorker::remove_pool_async(const Host::ConstPtr& host, bool cancel_reconne
   return send_event_async(event);
 }
 
+bool IOWorker::set_load_balancing_policy_async(const LoadBalancingPolicy::Ptr& policy) {
+  IOWorkerEvent event;
+  event.type = IOWorkerEvent::SET_LOAD_BALANCING_POLICY;
+  event.load_balancing_policy = policy;
+  return send_event_async(event);
+}
+
+bool IOWorker::notify_host_up_async(const Host::Ptr& host) {
+  IOWorkerEvent event;
+  event.type = IOWorkerEvent::HOST_UP;
+  event.host = host;
+  return send_event_async(event);
+}
+
+bool IOWorker::notify_host_down_async(const Host::Ptr& host) {
+  IOWorkerEvent event;
+  event.type = IOWorkerEvent::HOST_DOWN;
+  event.host = host;
+  return send_event_async(event);
+}
+
 void IOWorker::close_async() {
   while (!request_queue_.enqueue(NULL)) {
     // Keep trying
@@ -244,6 +278,15 @@ bool IOWorker::execute(const RequestHandler::Ptr& request_handler) {
   return true;
 }
 
+bool IOWorker::execute_sharded(const RequestHandler::Ptr& request_handler) {
+  request_handler->inc_ref(); // Queue reference
+  if (!sharded_request_queue_->enqueue(request_handler.get())) {
+    request_handler->dec_ref();
+    return false;
+  }
+  return true;
+}
+
 bool IOWorker::prepare_all(const Host::Ptr& current_host,
                            const Response::Ptr& response,
                            const RequestHandler::Ptr& request_handler) {
@@ -286,25 +329,36 @@ bool IOWorker::prepare_all(const Host::Ptr& current_host,
 }
 
 void IOWorker::retry(const RequestExecution::Ptr& request_execution) {
+  bool is_rate_limited = false;
   while (request_execution->current_host()) {
     PoolMap::const_iterator it = pools_.find(request_execution->current_host()->address());
-    if (it != pools_.end() &&
-        it->second->is_ready() &&
-        it->second->write(request_execution)) {
+    if (it != pools_.end() && it->second->is_ready()) {
+      // Hosts that have reached their rate limit are skipped like busy hosts
+      if (!request_execution->current_host()->acquire_rate_limit()) {
+        metrics_->rate_limited_hosts.inc();
+        is_rate_limited = true;
+      } else if (it->second->write(request_execution)) {
         return; // Successfully written or pending
+      }
     }
     request_execution->next_host();
   }
 
   request_execution->on_error(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE,
-                              "All hosts in current policy attempted "
-                              "and were either unavailable or failed");
+                              is_rate_limited
+                              ? "All hosts in current policy attempted "
+                                "and were either unavailable, failed or rate limited"
+                              : "All hosts in current policy attempted "
+                                "and were either unavailable or failed");
 }
 
 void IOWorker::request_finished() {
   pending_request_count_--;
   maybe_close();
   request_queue_.send();
+  if (sharded_request_queue_) {
+    sharded_request_queue_->send();
+  }
 }
 
 void IOWorker::notify_pool_ready(Pool* pool) {
@@ -352,7 +406,7 @@ void IOWorker::add_pending_request_processing(Pool* pool) {
 }
 
 void IOWorker::maybe_close() {
-  if (is_closing() && pending_request_count_ <= 0) {
+  if (is_closing() && pending_request_count_ <= 0 && prioritized_request_count_ == 0) {
     if (config_.core_connections_per_host() > 0) {
       for (PoolMap::iterator it = pools_.begin(); it != pools_.end();) {
         // Get the next iterator because Pool::close() can invalidate the
@@ -382,6 +436,31 @@ void IOWorker::maybe_notify_closed() {
 void IOWorker::close_handles() {
   EventThread<IOWorkerEvent>::close_handles();
   request_queue_.close_handles();
+  waker_->close_handles();
+  for (int i = 0; i < CASS_REQUEST_PRIORITY_COUNT; ++i) {
+    while (!prioritized_requests_[i].empty()) {
+      RequestHandler::Ptr request_handler(prioritized_requests_[i].front());
+      prioritized_requests_[i].pop_front();
+      request_handler->dec_ref(); // Queue reference
+      request_handler->set_error(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE,
+                                 "Session is closed");
+    }
+  }
+  prioritized_request_count_ = 0;
+  if (sharded_request_queue_) {
+    // Requests that raced with closing the session are never started
+    RequestHandler* temp = NULL;
+    while (sharded_request_queue_->dequeue(temp)) {
+      RequestHandler::Ptr request_handler(temp);
+      request_handler->dec_ref(); // Queue reference
+      request_handler->set_error(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE,
+                                 "Session is closed");
+    }
+    sharded_request_queue_->close_handles();
+  }
+  if (load_balancing_policy_) {
+    load_balancing_policy_->close_handles();
+  }
   uv_check_stop(&check_);
   uv_close(reinterpret_cast<uv_handle_t*>(&check_), NULL);
   uv_prepare_stop(&prepare_);
@@ -389,8 +468,6 @@ void IOWorker::close_handles() {
 }
 
 void IOWorker::on_event(const IOWorkerEvent& event) {
-  const Address& address = event.host->address();
-
   switch (event.type) {
     case IOWorkerEvent::ADD_POOL: {
       add_pool(event.host, event.is_initial_connection);
@@ -398,7 +475,7 @@ void IOWorker::on_event(const IOWorkerEvent& event) {
     }
 
     case IOWorkerEvent::REMOVE_POOL: {
-      PoolMap::iterator it = pools_.find(address);
+      PoolMap::iterator it = pools_.find(event.host->address());
       if (it != pools_.end()) {
         LOG_DEBUG("Remove pool event for %s closing pool(%p) io_worker(%p)",
                   event.host->address_string().c_str(),
@@ -409,6 +486,23 @@ void IOWorker::on_event(const IOWorkerEvent& event) {
       break;
     }
 
+    case IOWorkerEvent::SET_LOAD_BALANCING_POLICY:
+      load_balancing_policy_ = event.load_balancing_policy;
+      load_balancing_policy_->register_handles(loop());
+      if (sharded_request_queue_) {
+        // Start the requests that arrived before the policy
+        sharded_request_queue_->send();
+      }
+      break;
+
+    case IOWorkerEvent::HOST_UP:
+      if (load_balancing_policy_) load_balancing_policy_->on_up(event.host);
+      break;
+
+    case IOWorkerEvent::HOST_DOWN:
+      if (load_balancing_policy_) load_balancing_policy_->on_down(event.host);
+      break;
+
     default:
       assert(false);
       break;
@@ -423,41 +517,140 @@ void IOWorker::on_execute(uv_async_t* async) {
   IOWorker* io_worker = static_cast<IOWorker*>(async->data);
 
   RequestHandler* temp = NULL;
-  size_t remaining = io_worker->config().max_requests_per_flush();
-  while (remaining != 0 && io_worker->request_queue_.dequeue(temp)) {
-    RequestHandler::Ptr request_handler(temp);
-    if (request_handler) {
-      request_handler->dec_ref(); // Queue reference
-      io_worker->pending_request_count_++;
-      request_handler->start_request(io_worker);
-      RequestExecution::Ptr request_execution(new RequestExecution(request_handler,
-                                                                   request_handler->current_host()));
-      request_execution->execute();
+  while (!io_worker->is_prioritized_request_queue_full() &&
+         io_worker->request_queue_.dequeue(temp)) {
+    if (temp != NULL) {
+      io_worker->add_prioritized_request(temp);
     } else {
       io_worker->state_ = IO_WORKER_STATE_CLOSING;
     }
-    remaining--;
   }
 
+  io_worker->start_prioritized_requests();
   io_worker->maybe_close();
 }
 
+#if UV_VERSION_MAJOR == 0
+void IOWorker::on_execute_sharded(uv_async_t* async, int status) {
+#else
+void IOWorker::on_execute_sharded(uv_async_t* async) {
+#endif
+  IOWorker* io_worker = static_cast<IOWorker*>(async->data);
+
+  // Requests are left in the queue until the shard's policy is installed.
+  // The session's own policy can't be used because it's updated on the
+  // session thread.
+  if (!io_worker->load_balancing_policy_) return;
+
+  RequestHandler* temp = NULL;
+  while (!io_worker->is_prioritized_request_queue_full() &&
+         io_worker->sharded_request_queue_->dequeue(temp)) {
+    if (temp->is_expired()) {
+      RequestHandler::Ptr request_handler(temp);
+      request_handler->dec_ref(); // Queue reference
+      io_worker->metrics_->pending_request_timeouts.inc();
+      request_handler->set_error(CASS_ERROR_LIB_REQUEST_TIMED_OUT,
+                                 "Request deadline exceeded in the IO worker's queue");
+      continue;
+    }
+
+    if (!io_worker->session_->throttle(temp)) {
+      RequestHandler::Ptr request_handler(temp);
+      request_handler->dec_ref(); // Queue reference
+      continue;
+    }
+
+    // This is the work normally done by the session's thread
+    temp->init(io_worker->session_, io_worker->load_balancing_policy_.get());
+    temp->next_host();
+    if (!temp->current_host()) {
+      RequestHandler::Ptr request_handler(temp);
+      request_handler->dec_ref(); // Queue reference
+      request_handler->set_error(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE,
+                                 "No hosts available for the IO worker's shard");
+    } else {
+      io_worker->add_prioritized_request(temp);
+    }
+  }
+
+  io_worker->start_prioritized_requests();
+}
+
+void IOWorker::start_request(const RequestHandler::Ptr& request_handler) {
+  pending_request_count_++;
+  request_handler->start_request(this);
+  RequestExecution::Ptr request_execution(new RequestExecution(request_handler,
+                                                               request_handler->current_host()));
+  uint64_t now = uv_hrtime();
+  if (request_handler->throttled_until_ns() > now) {
+    // Delayed by a rate limiter. The time waiting in the queues counts toward
+    // the delay so it's rounded up to the next millisecond from now.
+    request_execution->execute_delayed((request_handler->throttled_until_ns() - now + 999999) /
+                                       (1000 * 1000));
+  } else {
+    request_execution->execute();
+  }
+}
+
+bool IOWorker::is_prioritized_request_queue_full() const {
+  // Keeps the request queues' backpressure
+  return prioritized_request_count_ >= config_.queue_size_io();
+}
+
+void IOWorker::add_prioritized_request(RequestHandler* request_handler) {
+  prioritized_requests_[request_handler->request()->priority()].push_back(request_handler);
+  prioritized_request_count_++;
+}
+
+void IOWorker::start_prioritized_requests() {
+  size_t remaining = config_.max_requests_per_flush();
+  for (int i = 0; i < CASS_REQUEST_PRIORITY_COUNT && remaining != 0; ++i) {
+    std::deque<RequestHandler*>& requests = prioritized_requests_[i];
+    while (remaining != 0 && !requests.empty()) {
+      RequestHandler::Ptr request_handler(requests.front());
+      requests.pop_front();
+      prioritized_request_count_--;
+      request_handler->dec_ref(); // Queue reference
+      if (request_handler->is_expired()) {
+        metrics_->pending_request_timeouts.inc();
+        request_handler->set_error(CASS_ERROR_LIB_REQUEST_TIMED_OUT,
+                                   "Request deadline exceeded in the IO worker's queue");
+        continue;
+      }
+      start_request(request_handler);
+      remaining--;
+    }
+  }
+}
+
 #if UV_VERSION_MAJOR == 0
 void IOWorker::on_check(uv_check_t* check, int status) {
 #else
 void IOWorker::on_check(uv_check_t* check) {
 #endif
   IOWorker* io_worker = static_cast<IOWorker*>(check->data);
+  io_worker->process_pending_requests();
+}
+
+#if UV_VERSION_MAJOR == 0
+void IOWorker::on_wake(uv_async_t* async, int status) {
+#else
+void IOWorker::on_wake(uv_async_t* async) {
+#endif
+  IOWorker* io_worker = static_cast<IOWorker*>(async->data);
+  io_worker->process_pending_requests();
+}
 
+void IOWorker::process_pending_requests() {
   PoolVec still_requires_processing;
-  for (PoolVec::iterator it = io_worker->pools_pending_request_processing_.begin(),
-       end = io_worker->pools_pending_request_processing_.end(); it != end; ++it) {
+  for (PoolVec::iterator it = pools_pending_request_processing_.begin(),
+       end = pools_pending_request_processing_.end(); it != end; ++it) {
     if ((*it)->process_pending_requests()) {
       still_requires_processing.push_back(*it);
     }
   }
 
-  io_worker->pools_pending_request_processing_.swap(still_requires_processing);
+  pools_pending_request_processing_.swap(still_requires_processing);
 }
 
 #if UV_VERSION_MAJOR == 0
@@ -22,17 +22,20 @@
 #include "async_queue.hpp"
 #include "copy_on_write_ptr.hpp"
 #include "constants.hpp"
+#include "dense_hash_map.hpp"
 #include "event_thread.hpp"
 #include "host.hpp"
+#include "load_balancing.hpp"
 #include "logger.hpp"
+#include "loop_waker.hpp"
 #include "metrics.hpp"
+#include "mpmc_queue.hpp"
 #include "pool.hpp"
 #include "request_handler.hpp"
 #include "spsc_queue.hpp"
 #include "timer.hpp"
 
-#include <sparsehash/dense_hash_map>
-
+#include <deque>
 #include <string>
 #include <uv.h>
 
@@ -49,7 +52,10 @@ struct IOWorkerEvent {
   enum Type {
     INVALID,
     ADD_POOL,
-    REMOVE_POOL
+    REMOVE_POOL,
+    SET_LOAD_BALANCING_POLICY,
+    HOST_UP,
+    HOST_DOWN
   };
 
   IOWorkerEvent()
@@ -58,9 +64,10 @@ struct IOWorkerEvent {
     , cancel_reconnect(false) {}
 
   Type type;
-  Host::ConstPtr host;
+  Host::Ptr host;
   bool is_initial_connection;
   bool cancel_reconnect;
+  LoadBalancingPolicy::Ptr load_balancing_policy;
 };
 
 class IOWorker
@@ -100,12 +107,22 @@ public:
 
   bool is_host_up(const Address& address) const;
 
-  bool add_pool_async(const Host::ConstPtr& host, bool is_initial_connection);
-  bool remove_pool_async(const Host::ConstPtr& host, bool cancel_reconnect);
+  bool add_pool_async(const Host::Ptr& host, bool is_initial_connection);
+  bool remove_pool_async(const Host::Ptr& host, bool cancel_reconnect);
   void close_async();
 
+  // Sharded sessions use a load balancing policy instance per IO worker so
+  // that query plans are created on the IO worker's thread.
+  bool set_load_balancing_policy_async(const LoadBalancingPolicy::Ptr& policy);
+  bool notify_host_up_async(const Host::Ptr& host);
+  bool notify_host_down_async(const Host::Ptr& host);
+
   bool execute(const RequestHandler::Ptr& request_handler);
 
+  // Executes a request from a thread bound to this IO worker. The request is
+  // initialized on the IO worker's thread instead of the session's thread.
+  bool execute_sharded(const RequestHandler::Ptr& request_handler);
+
   // Prepares a statement on all other hosts. It returns false if
   // "prepare on all" is disabled in the config or if there's
   // not enough hosts.
@@ -122,6 +139,10 @@ public:
   void add_pending_flush(Pool* pool);
   void add_pending_request_processing(Pool* pool);
 
+  // Wakes the IO worker's loop so that the requests waiting in its pools
+  // are processed (e.g. when a host drops below its concurrency limit)
+  const LoopWaker::Ptr& waker() const { return waker_; }
+
 private:
   void add_pool(const Host::ConstPtr& host, bool is_initial_connection);
   void maybe_close();
@@ -134,19 +155,29 @@ private:
 
 #if UV_VERSION_MAJOR == 0
   static void on_execute(uv_async_t* async, int status);
+  static void on_execute_sharded(uv_async_t* async, int status);
+  static void on_wake(uv_async_t* async, int status);
   static void on_check(uv_check_t *check, int status);
   static void on_prepare(uv_prepare_t *prepare, int status);
 #else
   static void on_execute(uv_async_t* async);
+  static void on_execute_sharded(uv_async_t* async);
+  static void on_wake(uv_async_t* async);
   static void on_check(uv_check_t *check);
   static void on_prepare(uv_prepare_t *prepare);
 #endif
 
 private:
-  typedef sparsehash::dense_hash_map<Address, Pool::Ptr, AddressHash> PoolMap;
+  typedef DenseHashMap<Address, Pool::Ptr, AddressHash> PoolMap;
   typedef std::vector<Pool::Ptr > PoolVec;
 
   void schedule_reconnect(const Host::ConstPtr& host);
+  void start_request(const RequestHandler::Ptr& request_handler);
+
+  bool is_prioritized_request_queue_full() const;
+  void add_prioritized_request(RequestHandler* request_handler);
+  void start_prioritized_requests();
+  void process_pending_requests();
 
 private:
   State state_;
@@ -167,6 +198,15 @@ private:
   int pending_request_count_;
 
   AsyncQueue<SPSCQueue<RequestHandler*> > request_queue_;
+  LoopWaker::Ptr waker_;
+
+  // Requests are moved from the request queues into a queue per priority and
+  // started in priority order. They hold the queue reference until started.
+  std::deque<RequestHandler*> prioritized_requests_[CASS_REQUEST_PRIORITY_COUNT];
+  size_t prioritized_request_count_;
+
+  LoadBalancingPolicy::Ptr load_balancing_policy_;
+  ScopedPtr<AsyncQueue<MPMCQueue<RequestHandler*> > > sharded_request_queue_;
 };
 
 } // namespace cass
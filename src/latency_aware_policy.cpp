@@ -31,7 +31,8 @@ void LatencyAwarePolicy::init(const Host::Ptr& connected_host,
   std::transform(hosts.begin(), hosts.end(), std::back_inserter(*hosts_), GetHost());
   for (HostMap::const_iterator i = hosts.begin(),
        end = hosts.end(); i != end; ++i) {
-    i->second->enable_latency_tracking(settings_.scale_ns, settings_.min_measured);
+    i->second->enable_latency_tracking(settings_.scale_ns, settings_.min_measured,
+                                       settings_.tail_percentile);
   }
   ChainedLoadBalancingPolicy::init(connected_host, hosts, random);
 }
@@ -39,16 +40,20 @@ void LatencyAwarePolicy::init(const Host::Ptr& connected_host,
 void LatencyAwarePolicy::register_handles(uv_loop_t* loop) {
   ChainedLoadBalancingPolicy::register_handles(loop);
 
-  calculate_min_average_task_ = PeriodicTask::start(loop,
-                                                    settings_.update_rate_ms,
-                                                    this,
-                                                    LatencyAwarePolicy::on_work,
-                                                    LatencyAwarePolicy::on_after_work);
+  // Host latencies can be read without locking so the minimum is cheap to
+  // compute directly on the loop
+  min_average_timer_ = new uv_timer_t;
+  min_average_timer_->data = this;
+  uv_timer_init(loop, min_average_timer_);
+  uv_timer_start(min_average_timer_, on_update_min_average,
+                 settings_.update_rate_ms, settings_.update_rate_ms);
 }
 
 void LatencyAwarePolicy::close_handles() {
-  if (calculate_min_average_task_) {
-    PeriodicTask::stop(calculate_min_average_task_);
+  if (min_average_timer_ != NULL) {
+    uv_timer_stop(min_average_timer_);
+    uv_close(reinterpret_cast<uv_handle_t*>(min_average_timer_), on_close);
+    min_average_timer_ = NULL;
   }
 
   ChainedLoadBalancingPolicy::close_handles();
@@ -62,7 +67,8 @@ QueryPlan* LatencyAwarePolicy::new_query_plan(const std::string& keyspace,
 }
 
 void LatencyAwarePolicy::on_add(const Host::Ptr& host) {
-  host->enable_latency_tracking(settings_.scale_ns, settings_.min_measured);
+  host->enable_latency_tracking(settings_.scale_ns, settings_.min_measured,
+                                settings_.tail_percentile);
   add_host(hosts_, host);
   ChainedLoadBalancingPolicy::on_add(host);
 }
@@ -82,6 +88,25 @@ void LatencyAwarePolicy::on_down(const Host::Ptr& host) {
   ChainedLoadBalancingPolicy::on_down(host);
 }
 
+int64_t LatencyAwarePolicy::score(const Host::Ptr& host, uint64_t now) const {
+  TimestampedAverage latency = host->get_current_average();
+
+  if (latency.average < 0 ||
+      latency.num_measured < settings_.min_measured ||
+      (now - latency.timestamp) > settings_.retry_period_ns) {
+    return -1;
+  }
+
+  int64_t score = latency.average;
+  if (settings_.tail_percentile > 0.0 && latency.tail >= 0) {
+    score = latency.tail;
+  }
+  if (settings_.weight_inflight) {
+    score *= 1 + std::max(host->inflight_requests(), static_cast<int64_t>(0));
+  }
+  return score;
+}
+
 Host::Ptr LatencyAwarePolicy::LatencyAwareQueryPlan::compute_next() {
   int64_t min = policy_->min_average_.load();
   const Settings& settings = policy_->settings_;
@@ -89,16 +114,13 @@ Host::Ptr LatencyAwarePolicy::LatencyAwareQueryPlan::compute_next() {
 
   Host::Ptr host;
   while ((host = child_plan_->compute_next())) {
-    TimestampedAverage latency = host->get_current_average();
+    int64_t score = policy_->score(host, now);
 
-    if (min < 0 ||
-        latency.average < 0 ||
-        latency.num_measured < settings.min_measured ||
-        (now - latency.timestamp) > settings.retry_period_ns) {
+    if (min < 0 || score < 0) {
       return host;
     }
 
-    if (latency.average <= static_cast<int64_t>(settings.exclusion_threshold * min)) {
+    if (score <= static_cast<int64_t>(settings.exclusion_threshold * min)) {
       return host;
     }
 
@@ -112,33 +134,37 @@ Host::Ptr LatencyAwarePolicy::LatencyAwareQueryPlan::compute_next() {
   return Host::Ptr();
 }
 
-void LatencyAwarePolicy::on_work(PeriodicTask* task) {
-  LatencyAwarePolicy* policy = static_cast<LatencyAwarePolicy*>(task->data());
+#if UV_VERSION_MAJOR == 0
+void LatencyAwarePolicy::on_update_min_average(uv_timer_t* handle, int status) {
+#else
+void LatencyAwarePolicy::on_update_min_average(uv_timer_t* handle) {
+#endif
+  LatencyAwarePolicy* policy = static_cast<LatencyAwarePolicy*>(handle->data);
+  policy->update_min_average();
+}
+
+void LatencyAwarePolicy::on_close(uv_handle_t* handle) {
+  delete reinterpret_cast<uv_timer_t*>(handle);
+}
 
-  const Settings& settings = policy->settings_;
-  const CopyOnWriteHostVec& hosts = policy->hosts_;
+void LatencyAwarePolicy::update_min_average() {
+  const CopyOnWriteHostVec& hosts = hosts_;
 
   int64_t new_min_average = CASS_INT64_MAX;
-  int64_t now = uv_hrtime();
+  uint64_t now = uv_hrtime();
 
   for (HostVec::const_iterator i = hosts->begin(),
        end = hosts->end(); i != end; ++i) {
-    TimestampedAverage latency = (*i)->get_current_average();
-    if (latency.average >= 0
-        && latency.num_measured >= settings.min_measured
-        && (now - latency.timestamp) <= settings.retry_period_ns) {
-      new_min_average = std::min(new_min_average, latency.average);
+    int64_t score = this->score(*i, now);
+    if (score >= 0) {
+      new_min_average = std::min(new_min_average, score);
     }
   }
 
   if (new_min_average != CASS_INT64_MAX) {
     LOG_TRACE("Calculated new minimum: %f", static_cast<double>(new_min_average) / 1e6);
-    policy->min_average_.store(new_min_average);
+    min_average_.store(new_min_average);
   }
 }
 
-void LatencyAwarePolicy::on_after_work(PeriodicTask* task) {
-  // no-op
-}
-
 } // namespace cass
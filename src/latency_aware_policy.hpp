@@ -20,9 +20,10 @@
 #include "atomic.hpp"
 #include "load_balancing.hpp"
 #include "macros.hpp"
-#include "periodic_task.hpp"
 #include "scoped_ptr.hpp"
 
+#include <uv.h>
+
 namespace cass {
 
 class LatencyAwarePolicy : public ChainedLoadBalancingPolicy {
@@ -33,19 +34,23 @@ public:
       , scale_ns(100LL * 1000LL * 1000LL)
       , retry_period_ns(10LL * 1000LL * 1000LL * 1000LL)
       , update_rate_ms(100LL)
-      , min_measured(50LL) {}
+      , min_measured(50LL)
+      , tail_percentile(0.0)
+      , weight_inflight(false) {}
 
     double exclusion_threshold;
     uint64_t scale_ns;
     uint64_t retry_period_ns;
     uint64_t update_rate_ms;
     uint64_t min_measured;
+    double tail_percentile; // Score by a tail latency instead of the average (0 to disable)
+    bool weight_inflight; // Scale the score by the host's in-flight requests
   };
 
   LatencyAwarePolicy(LoadBalancingPolicy* child_policy, const Settings& settings)
     : ChainedLoadBalancingPolicy(child_policy)
     , min_average_(-1)
-    , calculate_min_average_task_(NULL)
+    , min_average_timer_(NULL)
     , settings_(settings)
     , hosts_(new HostVec) {}
 
@@ -74,6 +79,10 @@ public:
     return min_average_.load();
   }
 
+  // A host's latency score, lower is better (-1 if there aren't enough
+  // recent measurements)
+  int64_t score(const Host::Ptr& host, uint64_t now) const;
+
 private:
   class LatencyAwareQueryPlan : public QueryPlan {
   public:
@@ -92,11 +101,18 @@ private:
     size_t skipped_index_;
   };
 
-  static void on_work(PeriodicTask* task);
-  static void on_after_work(PeriodicTask* task);
+#if UV_VERSION_MAJOR == 0
+  static void on_update_min_average(uv_timer_t* handle, int status);
+#else
+  static void on_update_min_average(uv_timer_t* handle);
+#endif
+  static void on_close(uv_handle_t* handle);
+
+  void update_min_average();
 
+  // The minimum score of all hosts
   Atomic<int64_t> min_average_;
-  PeriodicTask::Ptr calculate_min_average_task_;
+  uv_timer_t* min_average_timer_;
   Settings settings_;
   CopyOnWriteHostVec hosts_;
 
@@ -20,6 +20,7 @@
 #include "cassandra.h"
 #include "constants.hpp"
 #include "host.hpp"
+#include "object_pool.hpp"
 #include "request.hpp"
 
 #include <list>
@@ -63,7 +64,7 @@ inline bool is_dc_local(CassConsistency cl) {
   return cl == CASS_CONSISTENCY_LOCAL_ONE || cl == CASS_CONSISTENCY_LOCAL_QUORUM;
 }
 
-class QueryPlan {
+class QueryPlan : public Pooled {
 public:
   virtual ~QueryPlan() {}
   virtual Host::Ptr compute_next() = 0;
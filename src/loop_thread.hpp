@@ -58,6 +58,8 @@ public:
 #else
       : is_loop_initialized_(false)
 #endif
+      , external_loop_(NULL)
+      , is_external_(false)
       , is_joinable_(false) {}
 
   virtual ~LoopThread() {
@@ -70,14 +72,27 @@ public:
 #endif
   }
 
-  int init() {
+  // An external loop thread doesn't create a thread of its own; the loop is
+  // run by the application instead. If "external_loop" is provided then the
+  // handles are attached to that loop rather than to a loop owned by this
+  // object.
+  int init(bool is_external = false, uv_loop_t* external_loop = NULL) {
     int rc = 0;
+    is_external_ = is_external;
+    external_loop_ = external_loop;
 #if UV_VERSION_MAJOR > 0
-    rc = uv_loop_init(&loop_);
-    if (rc != 0) return rc;
-    is_loop_initialized_ = true;
+    // A loop is reused when reconnecting
+    if (external_loop_ == NULL && !is_loop_initialized_) {
+      rc = uv_loop_init(&loop_);
+      if (rc != 0) return rc;
+      is_loop_initialized_ = true;
+    }
 #endif
 
+    // The signal mask of an application thread is left alone; the application
+    // is responsible for handling SIGPIPE when it runs the loop.
+    if (is_external_) return rc;
+
 #if defined(HAVE_SIGTIMEDWAIT) && !defined(HAVE_NOSIGPIPE)
     rc = block_sigpipe();
     if (rc != 0) return rc;
@@ -90,19 +105,37 @@ public:
   }
 
   void close_handles() {
+    if (is_external_) {
+      // There's no thread exit to wait on so "on_after_run()" is deferred
+      // until the next iteration of the loop. This guarantees that the handles
+      // closed during this iteration have finished closing.
+      uv_timer_init(loop(), &after_run_timer_);
+      after_run_timer_.data = this;
+      uv_timer_start(&after_run_timer_, on_after_run_timer, 0, 0);
+      return;
+    }
 #if defined(HAVE_SIGTIMEDWAIT) && !defined(HAVE_NOSIGPIPE)
     uv_prepare_stop(&prepare_);
     uv_close(reinterpret_cast<uv_handle_t*>(&prepare_), NULL);
 #endif
   }
 
+  uv_loop_t* loop() {
+    if (external_loop_ != NULL) return external_loop_;
 #if UV_VERSION_MAJOR == 0
-  uv_loop_t* loop() { return loop_; }
+    return loop_;
 #else
-  uv_loop_t* loop() { return &loop_; }
+    return &loop_;
 #endif
+  }
+
+  bool is_external() const { return is_external_; }
 
   int run() {
+    if (is_external_) {
+      on_run();
+      return 0;
+    }
     int rc = uv_thread_create(&thread_, on_run_internal, this);
     if (rc == 0) is_joinable_ = true;
     return rc;
@@ -129,6 +162,19 @@ private:
     thread->on_after_run();
   }
 
+#if UV_VERSION_MAJOR == 0
+  static void on_after_run_timer(uv_timer_t* timer, int status) {
+#else
+  static void on_after_run_timer(uv_timer_t* timer) {
+#endif
+    uv_close(reinterpret_cast<uv_handle_t*>(timer), on_after_run_close);
+  }
+
+  static void on_after_run_close(uv_handle_t* handle) {
+    LoopThread* thread = static_cast<LoopThread*>(handle->data);
+    thread->on_after_run();
+  }
+
 #if UV_VERSION_MAJOR == 0
   uv_loop_t* loop_;
 #else
@@ -151,6 +197,10 @@ private:
   uv_prepare_t prepare_;
 #endif
 
+  uv_loop_t* external_loop_;
+  bool is_external_;
+  uv_timer_t after_run_timer_;
+
   uv_thread_t thread_;
   bool is_joinable_;
 };
@@ -0,0 +1,65 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#include "loop_waker.hpp"
+
+#include "scoped_lock.hpp"
+
+namespace cass {
+
+LoopWaker::LoopWaker()
+  : is_initialized_(false)
+  , is_closed_(false) {
+  uv_mutex_init(&mutex_);
+}
+
+LoopWaker::~LoopWaker() {
+  uv_mutex_destroy(&mutex_);
+}
+
+int LoopWaker::init(uv_loop_t* loop, void* data, uv_async_cb async_cb) {
+  int rc = uv_async_init(loop, &async_, async_cb);
+  if (rc != 0) return rc;
+  async_.data = data;
+  is_initialized_ = true;
+  return 0;
+}
+
+void LoopWaker::wake() {
+  ScopedMutex l(&mutex_);
+  if (is_initialized_ && !is_closed_) {
+    uv_async_send(&async_);
+  }
+}
+
+void LoopWaker::close_handles() {
+  {
+    ScopedMutex l(&mutex_);
+    if (!is_initialized_ || is_closed_) return;
+    is_closed_ = true;
+  }
+  // The handle is part of this object so it's kept alive until it's closed
+  inc_ref();
+  async_.data = this;
+  uv_close(reinterpret_cast<uv_handle_t*>(&async_), on_close);
+}
+
+void LoopWaker::on_close(uv_handle_t* handle) {
+  static_cast<LoopWaker*>(handle->data)->dec_ref();
+}
+
+} // namespace cass
@@ -0,0 +1,59 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#ifndef __CASS_LOOP_WAKER_HPP_INCLUDED__
+#define __CASS_LOOP_WAKER_HPP_INCLUDED__
+
+#include "macros.hpp"
+#include "ref_counted.hpp"
+
+#include <uv.h>
+
+namespace cass {
+
+// Wakes an event loop from any thread. Unlike a bare uv_async_t it can be
+// shared with objects that outlive the loop's handles: waking it after its
+// handle has been closed does nothing.
+class LoopWaker : public RefCounted<LoopWaker> {
+public:
+  typedef SharedRefPtr<LoopWaker> Ptr;
+
+  LoopWaker();
+  ~LoopWaker();
+
+  int init(uv_loop_t* loop, void* data, uv_async_cb async_cb);
+
+  void wake();
+
+  void close_handles();
+
+private:
+  static void on_close(uv_handle_t* handle);
+
+private:
+  uv_mutex_t mutex_;
+  bool is_initialized_;
+  bool is_closed_;
+  uv_async_t async_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(LoopWaker);
+};
+
+} // namespace cass
+
+#endif
@@ -0,0 +1,144 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "memory.hpp"
+
+#include "atomic.hpp"
+
+#include <stdlib.h>
+#include <string.h>
+#include <uv.h>
+
+// Keeps the blocks returned to callers aligned the same as malloc()
+#define BLOCK_HEADER_SIZE 16
+
+#if UV_VERSION_MAJOR > 1 || (UV_VERSION_MAJOR == 1 && UV_VERSION_MINOR >= 6)
+#define CASS_HAS_UV_REPLACE_ALLOCATOR
+#endif
+
+extern "C" {
+
+void cass_alloc_set_functions(CassMallocFunction malloc_func,
+                              CassReallocFunction realloc_func,
+                              CassFreeFunction free_func) {
+  cass::Memory::set_functions(malloc_func, realloc_func, free_func);
+}
+
+cass_int64_t cass_alloc_get_allocated_bytes() {
+  return cass::Memory::allocated_bytes();
+}
+
+} // extern "C"
+
+namespace cass {
+
+namespace {
+
+CassMallocFunction malloc_func_ = ::malloc;
+CassReallocFunction realloc_func_ = ::realloc;
+CassFreeFunction free_func_ = ::free;
+
+// Blocks only have a size header (and are only counted) when custom
+// functions are installed so the default allocator has no overhead
+bool is_tracked_ = false;
+Atomic<int64_t> allocated_bytes_(0);
+
+struct BlockHeader {
+  size_t size;
+};
+
+inline void* to_block(BlockHeader* header) {
+  return reinterpret_cast<char*>(header) + BLOCK_HEADER_SIZE;
+}
+
+inline BlockHeader* header_of(void* ptr) {
+  return reinterpret_cast<BlockHeader*>(static_cast<char*>(ptr) - BLOCK_HEADER_SIZE);
+}
+
+#if defined(CASS_HAS_UV_REPLACE_ALLOCATOR)
+// libuv's blocks don't have a header (and aren't included in the allocated
+// bytes) because libuv might free memory that it allocated before its
+// allocator was replaced.
+void* uv_calloc_func(size_t count, size_t size) {
+  size_t total = count * size;
+  if (size != 0 && total / size != count) return NULL; // Overflow
+  void* ptr = malloc_func_(total);
+  if (ptr != NULL) memset(ptr, 0, total);
+  return ptr;
+}
+#endif
+
+} // namespace
+
+void Memory::set_functions(CassMallocFunction malloc_func,
+                           CassReallocFunction realloc_func,
+                           CassFreeFunction free_func) {
+  if (malloc_func == NULL || realloc_func == NULL || free_func == NULL) {
+    malloc_func_ = ::malloc;
+    realloc_func_ = ::realloc;
+    free_func_ = ::free;
+    is_tracked_ = false;
+  } else {
+    malloc_func_ = malloc_func;
+    realloc_func_ = realloc_func;
+    free_func_ = free_func;
+    is_tracked_ = true;
+  }
+
+#if defined(CASS_HAS_UV_REPLACE_ALLOCATOR)
+  uv_replace_allocator(malloc_func_, realloc_func_,
+                       uv_calloc_func, free_func_);
+#endif
+}
+
+void* Memory::malloc(size_t size) {
+  if (!is_tracked_) return malloc_func_(size);
+  BlockHeader* header = static_cast<BlockHeader*>(malloc_func_(BLOCK_HEADER_SIZE + size));
+  if (header == NULL) return NULL;
+  header->size = size;
+  allocated_bytes_.fetch_add(static_cast<int64_t>(size), MEMORY_ORDER_RELAXED);
+  return to_block(header);
+}
+
+void* Memory::realloc(void* ptr, size_t size) {
+  if (!is_tracked_) return realloc_func_(ptr, size);
+  if (ptr == NULL) return Memory::malloc(size);
+  BlockHeader* header = header_of(ptr);
+  size_t old_size = header->size;
+  header = static_cast<BlockHeader*>(realloc_func_(header, BLOCK_HEADER_SIZE + size));
+  if (header == NULL) return NULL; // The original block is still valid
+  header->size = size;
+  allocated_bytes_.fetch_add(static_cast<int64_t>(size) - static_cast<int64_t>(old_size),
+                             MEMORY_ORDER_RELAXED);
+  return to_block(header);
+}
+
+void Memory::free(void* ptr) {
+  if (ptr == NULL) return;
+  if (!is_tracked_) {
+    free_func_(ptr);
+    return;
+  }
+  BlockHeader* header = header_of(ptr);
+  allocated_bytes_.fetch_sub(static_cast<int64_t>(header->size), MEMORY_ORDER_RELAXED);
+  free_func_(header);
+}
+
+int64_t Memory::allocated_bytes() {
+  return allocated_bytes_.load(MEMORY_ORDER_RELAXED);
+}
+
+} // namespace cass
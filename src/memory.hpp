@@ -0,0 +1,141 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_MEMORY_HPP_INCLUDED__
+#define __CASS_MEMORY_HPP_INCLUDED__
+
+#include "cassandra.h"
+
+#include <limits>
+#include <new>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace cass {
+
+// All of the driver's internal allocations go through these functions so
+// that an application can provide its own allocator (e.g. a dedicated
+// jemalloc arena) using cass_alloc_set_functions(). When custom functions
+// are installed every block carries a small header with its size so that
+// the number of bytes allocated by the driver can be tracked no matter
+// which allocator is used. The default allocator has no header and isn't
+// tracked.
+class Memory {
+public:
+  static void set_functions(CassMallocFunction malloc_func,
+                            CassReallocFunction realloc_func,
+                            CassFreeFunction free_func);
+
+  static void* malloc(size_t size);
+  static void* realloc(void* ptr, size_t size);
+  static void free(void* ptr);
+
+  // The number of bytes currently allocated by the driver (not including
+  // the block headers). This is always 0 with the default allocator.
+  static int64_t allocated_bytes();
+};
+
+// A base class for objects allocated using the driver's allocator
+class Allocated {
+public:
+  static void* operator new(size_t size) {
+    void* ptr = Memory::malloc(size);
+    if (ptr == NULL) throw std::bad_alloc();
+    return ptr;
+  }
+
+  static void* operator new[](size_t size) {
+    void* ptr = Memory::malloc(size);
+    if (ptr == NULL) throw std::bad_alloc();
+    return ptr;
+  }
+
+  static void operator delete(void* ptr) {
+    Memory::free(ptr);
+  }
+
+  static void operator delete[](void* ptr) {
+    Memory::free(ptr);
+  }
+};
+
+// A standard allocator that uses the driver's allocator. This is used for
+// containers that are allocated often or grow large (e.g. hash maps).
+template <class T>
+class Allocator {
+public:
+  typedef T value_type;
+  typedef T* pointer;
+  typedef T& reference;
+  typedef const T* const_pointer;
+  typedef const T& const_reference;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+
+  template <class U>
+  struct rebind {
+    typedef Allocator<U> other;
+  };
+
+  Allocator() { }
+
+  template <class U>
+  Allocator(const Allocator<U>&) { }
+
+  pointer address(reference x) const {
+    return &x;
+  }
+
+  const_pointer address(const_reference x) const {
+    return &x;
+  }
+
+  pointer allocate(size_type n, const void* hint = NULL) {
+    void* ptr = Memory::malloc(sizeof(T) * n);
+    if (ptr == NULL) throw std::bad_alloc();
+    return static_cast<pointer>(ptr);
+  }
+
+  void deallocate(pointer p, size_type n) {
+    Memory::free(p);
+  }
+
+  void construct(pointer p, const_reference x) {
+    new (p) value_type(x);
+  }
+
+  void destroy(pointer p) {
+    p->~value_type();
+  }
+
+  size_type max_size() const throw() {
+    return std::numeric_limits<size_type>::max() / sizeof(T);
+  }
+};
+
+template <class T, class U>
+inline bool operator==(const Allocator<T>&, const Allocator<U>&) {
+  return true;
+}
+
+template <class T, class U>
+inline bool operator!=(const Allocator<T>&, const Allocator<U>&) {
+  return false;
+}
+
+} // namespace cass
+
+#endif
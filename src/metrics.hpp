@@ -21,6 +21,7 @@
 #define __CASS_METRICS_HPP_INCLUDED__
 
 #include "atomic.hpp"
+#include "cassandra.h"
 #include "constants.hpp"
 #include "scoped_ptr.hpp"
 #include "scoped_lock.hpp"
@@ -105,6 +106,10 @@ public:
       counters_[thread_state_->current_thread_id()].sub(1LL);
     }
 
+    void add(int64_t n) {
+      counters_[thread_state_->current_thread_id()].add(n);
+    }
+
     int64_t sum() const {
       int64_t sum = 0;
       for (size_t i = 0; i < thread_state_->max_threads(); ++i) {
@@ -462,23 +467,53 @@ public:
     : thread_state_(max_threads)
 #endif
     , request_latencies(&thread_state_)
+    , interactive_request_latencies(&thread_state_)
+    , normal_request_latencies(&thread_state_)
+    , background_request_latencies(&thread_state_)
     , request_rates(&thread_state_)
     , total_connections(&thread_state_)
     , connection_timeouts(&thread_state_)
     , pending_request_timeouts(&thread_state_)
-    , request_timeouts(&thread_state_) {}
-
-  void record_request(uint64_t latency_ns) {
+    , request_timeouts(&thread_state_)
+    , ssl_full_handshakes(&thread_state_)
+    , ssl_resumed_handshakes(&thread_state_)
+    , speculative_executions(&thread_state_)
+    , dropped_speculative_executions(&thread_state_)
+    , wasted_responses(&thread_state_)
+    , wasted_response_bytes(&thread_state_)
+    , throttled_requests(&thread_state_)
+    , throttled_time_us(&thread_state_)
+    , rate_limited_requests(&thread_state_)
+    , rate_limited_hosts(&thread_state_) {}
+
+  void record_request(uint64_t latency_ns,
+                      CassRequestPriority priority = CASS_REQUEST_PRIORITY_NORMAL) {
     // Final measurement is in microseconds
     request_latencies.record_value(latency_ns / 1000);
+    request_latencies_by_priority(priority).record_value(latency_ns / 1000);
     request_rates.mark();
   }
 
+  Histogram& request_latencies_by_priority(CassRequestPriority priority) {
+    switch (priority) {
+      case CASS_REQUEST_PRIORITY_INTERACTIVE: return interactive_request_latencies;
+      case CASS_REQUEST_PRIORITY_BACKGROUND: return background_request_latencies;
+      default: return normal_request_latencies;
+    }
+  }
+
+  const Histogram& request_latencies_by_priority(CassRequestPriority priority) const {
+    return const_cast<Metrics*>(this)->request_latencies_by_priority(priority);
+  }
+
 private:
   ThreadState thread_state_;
 
 public:
   Histogram request_latencies;
+  Histogram interactive_request_latencies;
+  Histogram normal_request_latencies;
+  Histogram background_request_latencies;
   Meter request_rates;
 
   Counter total_connections;
@@ -487,6 +522,19 @@ public:
   Counter pending_request_timeouts;
   Counter request_timeouts;
 
+  Counter ssl_full_handshakes;
+  Counter ssl_resumed_handshakes;
+
+  Counter speculative_executions;
+  Counter dropped_speculative_executions;
+  Counter wasted_responses;
+  Counter wasted_response_bytes;
+
+  Counter throttled_requests;
+  Counter throttled_time_us;
+  Counter rate_limited_requests;
+  Counter rate_limited_hosts;
+
 private:
   DISALLOW_COPY_AND_ASSIGN(Metrics);
 };
@@ -0,0 +1,341 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "object_pool.hpp"
+
+#include "atomic.hpp"
+#include "macros.hpp"
+#include "memory.hpp"
+#include "scoped_lock.hpp"
+
+#include <new>
+#include <uv.h>
+
+// Older compilers don't support "thread_local" and the pool is disabled
+#if (defined(_MSC_VER) && _MSC_VER < 1900) || \
+    (!defined(_MSC_VER) && __cplusplus < 201103L)
+#define CASS_NO_THREAD_LOCAL
+#endif
+
+#define BLOCK_ALIGNMENT 16
+#define BLOCK_HEADER_SIZE 16
+#define MAX_POOLED_SIZE 1024
+#define NUM_SIZE_CLASSES (MAX_POOLED_SIZE / BLOCK_ALIGNMENT)
+#define MAX_CACHED_BLOCKS_PER_CLASS 1024
+
+extern "C" {
+
+void cass_alloc_get_object_pool_metrics(CassObjectPoolMetrics* output) {
+  uint64_t hits, misses;
+  cass::ObjectPool::metrics(&hits, &misses);
+  output->hits = hits;
+  output->misses = misses;
+}
+
+} // extern "C"
+
+namespace cass {
+
+namespace {
+
+class ThreadCache;
+
+// The live thread caches and the totals of the caches whose threads have
+// exited. The hits and misses are summed when they're read so that
+// allocating doesn't update shared counters.
+uv_once_t registry_guard = UV_ONCE_INIT;
+uv_mutex_t registry_mutex;
+ThreadCache* registry_head = NULL;
+uint64_t retired_hits = 0;
+uint64_t retired_misses = 0;
+
+void init_registry() {
+  uv_mutex_init(&registry_mutex);
+}
+
+struct BlockHeader {
+  ThreadCache* owner; // NULL if the block isn't pooled
+  size_t size_class;
+};
+
+// A free block reuses the object's memory to link the free list
+struct FreeBlock {
+  FreeBlock* next;
+};
+
+inline BlockHeader* header_of(void* ptr) {
+  return reinterpret_cast<BlockHeader*>(static_cast<char*>(ptr) - BLOCK_HEADER_SIZE);
+}
+
+inline FreeBlock* free_block_of(BlockHeader* header) {
+  return reinterpret_cast<FreeBlock*>(reinterpret_cast<char*>(header) + BLOCK_HEADER_SIZE);
+}
+
+inline BlockHeader* header_of(FreeBlock* block) {
+  return header_of(static_cast<void*>(block));
+}
+
+void* allocate_unpooled(size_t size) {
+  BlockHeader* header = static_cast<BlockHeader*>(Memory::malloc(BLOCK_HEADER_SIZE + size));
+  if (header == NULL) throw std::bad_alloc();
+  header->owner = NULL;
+  header->size_class = 0;
+  return free_block_of(header);
+}
+
+// The blocks allocated by a thread. The cache is kept alive by its thread
+// and by each of the blocks it allocated that haven't been freed yet.
+class ThreadCache : public Allocated {
+public:
+  ThreadCache()
+    : prev_(NULL)
+    , next_(NULL)
+    , remote_frees_(NULL)
+    , ref_count_(1)
+    , hits_(0)
+    , misses_(0) {
+    for (size_t i = 0; i < NUM_SIZE_CLASSES; ++i) {
+      free_lists_[i] = NULL;
+      counts_[i] = 0;
+    }
+    uv_once(&registry_guard, init_registry);
+    ScopedMutex lock(&registry_mutex);
+    next_ = registry_head;
+    if (next_ != NULL) next_->prev_ = this;
+    registry_head = this;
+  }
+
+  void* allocate(size_t size) {
+    size_t size_class = (size + BLOCK_ALIGNMENT - 1) / BLOCK_ALIGNMENT - 1;
+    if (free_lists_[size_class] == NULL) {
+      collect_remote_frees();
+    }
+
+    FreeBlock* block = free_lists_[size_class];
+    if (block != NULL) {
+      free_lists_[size_class] = block->next;
+      counts_[size_class]--;
+      increment(hits_);
+      return block;
+    }
+
+    BlockHeader* header = static_cast<BlockHeader*>(
+                            Memory::malloc(BLOCK_HEADER_SIZE + (size_class + 1) * BLOCK_ALIGNMENT));
+    if (header == NULL) throw std::bad_alloc();
+    header->owner = this;
+    header->size_class = size_class;
+    ref_count_.fetch_add(1, MEMORY_ORDER_RELAXED);
+    increment(misses_);
+    return free_block_of(header);
+  }
+
+  // Called by the owning thread
+  void deallocate(BlockHeader* header) {
+    size_t size_class = header->size_class;
+    if (counts_[size_class] >= MAX_CACHED_BLOCKS_PER_CLASS) {
+      Memory::free(header);
+      release();
+      return;
+    }
+    FreeBlock* block = free_block_of(header);
+    block->next = free_lists_[size_class];
+    free_lists_[size_class] = block;
+    counts_[size_class]++;
+  }
+
+  // Called by other threads
+  void deallocate_remote(BlockHeader* header) {
+    FreeBlock* block = free_block_of(header);
+    FreeBlock* head = remote_frees_.load(MEMORY_ORDER_RELAXED);
+    do {
+      if (head == abandoned()) {
+        // The owning thread has exited
+        Memory::free(header);
+        release();
+        return;
+      }
+      block->next = head;
+    } while (!remote_frees_.compare_exchange_weak(head, block, MEMORY_ORDER_RELEASE));
+  }
+
+  // Called when the owning thread exits
+  void abandon() {
+    {
+      ScopedMutex lock(&registry_mutex);
+      if (prev_ != NULL) {
+        prev_->next_ = next_;
+      } else {
+        registry_head = next_;
+      }
+      if (next_ != NULL) next_->prev_ = prev_;
+      retired_hits += hits_.load(MEMORY_ORDER_RELAXED);
+      retired_misses += misses_.load(MEMORY_ORDER_RELAXED);
+    }
+    free_list(remote_frees_.exchange(abandoned(), MEMORY_ORDER_ACQUIRE));
+    for (size_t i = 0; i < NUM_SIZE_CLASSES; ++i) {
+      free_list(free_lists_[i]);
+      free_lists_[i] = NULL;
+      counts_[i] = 0;
+    }
+    release();
+  }
+
+  size_t cached_count() const {
+    size_t count = 0;
+    for (size_t i = 0; i < NUM_SIZE_CLASSES; ++i) {
+      count += counts_[i];
+    }
+    return count;
+  }
+
+  // Called with the registry's mutex held
+  static void metrics(uint64_t* hits, uint64_t* misses) {
+    *hits = retired_hits;
+    *misses = retired_misses;
+    for (ThreadCache* cache = registry_head; cache != NULL; cache = cache->next_) {
+      *hits += cache->hits_.load(MEMORY_ORDER_RELAXED);
+      *misses += cache->misses_.load(MEMORY_ORDER_RELAXED);
+    }
+  }
+
+private:
+  static FreeBlock* abandoned() {
+    return reinterpret_cast<FreeBlock*>(1);
+  }
+
+  // Only the owning thread updates its counters
+  static void increment(Atomic<uint64_t>& counter) {
+    counter.store(counter.load(MEMORY_ORDER_RELAXED) + 1, MEMORY_ORDER_RELAXED);
+  }
+
+
+  void collect_remote_frees() {
+    FreeBlock* block = remote_frees_.exchange(NULL, MEMORY_ORDER_ACQUIRE);
+    while (block != NULL) {
+      FreeBlock* next = block->next;
+      deallocate(header_of(block));
+      block = next;
+    }
+  }
+
+  void free_list(FreeBlock* block) {
+    while (block != NULL) {
+      FreeBlock* next = block->next;
+      Memory::free(header_of(block));
+      release();
+      block = next;
+    }
+  }
+
+  void release() {
+    if (ref_count_.fetch_sub(1, MEMORY_ORDER_ACQ_REL) == 1) {
+      delete this;
+    }
+  }
+
+private:
+  ThreadCache* prev_;
+  ThreadCache* next_;
+  FreeBlock* free_lists_[NUM_SIZE_CLASSES];
+  size_t counts_[NUM_SIZE_CLASSES];
+  Atomic<FreeBlock*> remote_frees_;
+  Atomic<size_t> ref_count_;
+  Atomic<uint64_t> hits_;
+  Atomic<uint64_t> misses_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ThreadCache);
+};
+
+#if !defined(CASS_NO_THREAD_LOCAL)
+class ThreadCacheHolder {
+public:
+  ThreadCacheHolder()
+    : cache_(NULL)
+    , is_destroyed_(false) { }
+
+  ~ThreadCacheHolder() {
+    if (cache_ != NULL) {
+      cache_->abandon();
+      cache_ = NULL;
+    }
+    is_destroyed_ = true;
+  }
+
+  // Returns NULL while the thread is exiting
+  ThreadCache* get() {
+    if (cache_ == NULL && !is_destroyed_) {
+      cache_ = new ThreadCache();
+    }
+    return cache_;
+  }
+
+private:
+  ThreadCache* cache_;
+  bool is_destroyed_;
+};
+
+thread_local ThreadCacheHolder thread_cache;
+#endif
+
+} // namespace
+
+void* ObjectPool::allocate(size_t size) {
+#if !defined(CASS_NO_THREAD_LOCAL)
+  if (size > 0 && size <= MAX_POOLED_SIZE) {
+    ThreadCache* cache = thread_cache.get();
+    if (cache != NULL) {
+      return cache->allocate(size);
+    }
+  }
+#endif
+  return allocate_unpooled(size);
+}
+
+void ObjectPool::deallocate(void* ptr) {
+  if (ptr == NULL) return;
+  BlockHeader* header = header_of(ptr);
+  ThreadCache* owner = header->owner;
+  if (owner == NULL) {
+    Memory::free(header);
+    return;
+  }
+#if !defined(CASS_NO_THREAD_LOCAL)
+  if (owner == thread_cache.get()) {
+    owner->deallocate(header);
+    return;
+  }
+#endif
+  owner->deallocate_remote(header);
+}
+
+size_t ObjectPool::cached_count() {
+#if !defined(CASS_NO_THREAD_LOCAL)
+  ThreadCache* cache = thread_cache.get();
+  if (cache != NULL) {
+    return cache->cached_count();
+  }
+#endif
+  return 0;
+}
+
+void ObjectPool::metrics(uint64_t* hits, uint64_t* misses) {
+  uv_once(&registry_guard, init_registry);
+  ScopedMutex lock(&registry_mutex);
+  ThreadCache::metrics(hits, misses);
+}
+
+} // namespace cass
@@ -0,0 +1,78 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_OBJECT_POOL_HPP_INCLUDED__
+#define __CASS_OBJECT_POOL_HPP_INCLUDED__
+
+#include "ref_counted.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace cass {
+
+// Recycles the memory of small objects that are allocated for every request
+// (e.g. request handlers, executions, futures, query plans and timers) so
+// that a steady stream of requests doesn't need to call malloc()/free().
+//
+// Each thread caches freed blocks by size. A block freed by a thread other
+// than the one that allocated it (e.g. a request handler created by the
+// application and released by an I/O thread) is handed back to the thread
+// that allocated it using a lock-free list, so that the threads that
+// allocate the objects don't run out of blocks. A thread's cached blocks are
+// freed when it exits.
+class ObjectPool {
+public:
+  static void* allocate(size_t size);
+  static void deallocate(void* ptr);
+
+  // The number of blocks cached by the calling thread
+  static size_t cached_count();
+
+  // The allocations of all threads that were served by a cached block
+  // (hits) or that had to allocate a new block (misses)
+  static void metrics(uint64_t* hits, uint64_t* misses);
+};
+
+// A base class for objects allocated from the object pool
+class Pooled {
+public:
+  static void* operator new(size_t size) {
+    return ObjectPool::allocate(size);
+  }
+
+  static void operator delete(void* ptr) {
+    ObjectPool::deallocate(ptr);
+  }
+};
+
+// A reference counted object allocated from the object pool instead of
+// the driver's allocator
+template <class T>
+class PooledRefCounted : public RefCounted<T> {
+public:
+  static void* operator new(size_t size) {
+    return ObjectPool::allocate(size);
+  }
+
+  static void operator delete(void* ptr) {
+    ObjectPool::deallocate(ptr);
+  }
+};
+
+} // namespace cass
+
+#endif
@@ -0,0 +1,73 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#ifndef __CASS_PACKED_SUM_HPP_INCLUDED__
+#define __CASS_PACKED_SUM_HPP_INCLUDED__
+
+#include "atomic.hpp"
+#include "macros.hpp"
+
+#include <stdint.h>
+
+namespace cass {
+
+// A count and a sum of values packed into one word so that they can be
+// updated by many threads and taken as a consistent pair. The count is kept
+// in the high 20 bits and the sum in the low 44 bits.
+class PackedSum {
+public:
+  PackedSum()
+    : packed_(0) { }
+
+  // Adds a value. The value is dropped, and false is returned, if either the
+  // count or the sum would overflow (i.e. the sums aren't being taken fast
+  // enough).
+  bool add(uint64_t value) {
+    uint64_t packed = packed_.load(MEMORY_ORDER_RELAXED);
+    uint64_t desired;
+    do {
+      uint64_t count = packed >> COUNT_SHIFT;
+      uint64_t sum = packed & SUM_MASK;
+      if (count == COUNT_MAX || value > SUM_MASK - sum) {
+        return false;
+      }
+      desired = ((count + 1) << COUNT_SHIFT) | (sum + value);
+    } while (!packed_.compare_exchange_weak(packed, desired, MEMORY_ORDER_RELEASE));
+    return true;
+  }
+
+  // Takes the current count and sum and resets them to zero
+  void take(uint64_t* count, uint64_t* sum) {
+    uint64_t packed = packed_.exchange(0, MEMORY_ORDER_ACQUIRE);
+    *count = packed >> COUNT_SHIFT;
+    *sum = packed & SUM_MASK;
+  }
+
+private:
+  static const uint64_t COUNT_SHIFT = 44;
+  static const uint64_t SUM_MASK = (static_cast<uint64_t>(1) << COUNT_SHIFT) - 1;
+  static const uint64_t COUNT_MAX = ~static_cast<uint64_t>(0) >> COUNT_SHIFT;
+
+  Atomic<uint64_t> packed_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(PackedSum);
+};
+
+} // namespace cass
+
+#endif
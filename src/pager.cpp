@@ -0,0 +1,244 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#include "pager.hpp"
+
+#include "constants.hpp"
+#include "request_handler.hpp"
+#include "result_response.hpp"
+#include "scoped_lock.hpp"
+#include "session.hpp"
+
+#define PAGER_DEFAULT_PREFETCH_DEPTH 1
+#define PAGER_DEFAULT_MAX_BUFFERED_BYTES (64 * 1024 * 1024)
+
+extern "C" {
+
+CassPager* cass_pager_new(CassSession* session,
+                          const CassStatement* statement) {
+  cass::Pager* pager = new cass::Pager(session, statement);
+  pager->inc_ref();
+  return CassPager::to(pager);
+}
+
+void cass_pager_free(CassPager* pager) {
+  pager->close();
+  pager->dec_ref();
+}
+
+void cass_pager_set_prefetch_depth(CassPager* pager,
+                                   unsigned prefetch_depth) {
+  pager->set_prefetch_depth(prefetch_depth);
+}
+
+void cass_pager_set_max_buffered_bytes(CassPager* pager,
+                                       size_t max_buffered_bytes) {
+  pager->set_max_buffered_bytes(max_buffered_bytes);
+}
+
+cass_bool_t cass_pager_has_more_pages(CassPager* pager) {
+  return pager->has_more_pages() ? cass_true : cass_false;
+}
+
+CassFuture* cass_pager_next_page(CassPager* pager) {
+  cass::Future::Ptr future(pager->next_page());
+  future->inc_ref();
+  return CassFuture::to(future.get());
+}
+
+} // extern "C"
+
+namespace cass {
+
+Pager::Pager(Session* session, const Statement* statement)
+  : session_(session)
+  , statement_(statement->clone())
+  , prefetch_depth_(PAGER_DEFAULT_PREFETCH_DEPTH)
+  , max_buffered_bytes_(PAGER_DEFAULT_MAX_BUFFERED_BYTES)
+  , buffered_bytes_(0)
+  , is_in_flight_prefetched_(false)
+  , has_next_page_(true)
+  , is_closed_(false) {
+  uv_mutex_init(&mutex_);
+}
+
+Pager::~Pager() {
+  uv_mutex_destroy(&mutex_);
+}
+
+void Pager::set_prefetch_depth(unsigned prefetch_depth) {
+  ScopedMutex lock(&mutex_);
+  prefetch_depth_ = prefetch_depth;
+}
+
+void Pager::set_max_buffered_bytes(size_t max_buffered_bytes) {
+  ScopedMutex lock(&mutex_);
+  max_buffered_bytes_ = max_buffered_bytes;
+}
+
+bool Pager::has_more_pages() {
+  ScopedMutex lock(&mutex_);
+  return !pages_.empty() || has_next_page_;
+}
+
+size_t Pager::buffered_bytes() {
+  ScopedMutex lock(&mutex_);
+  return buffered_bytes_;
+}
+
+Future::Ptr Pager::next_page() {
+  Statement::Ptr request;
+  ResponseFuture::Ptr future;
+  {
+    ScopedMutex lock(&mutex_);
+    if (!pages_.empty()) {
+      Page& page = pages_.front();
+      future = page.future;
+      buffered_bytes_ -= page.size;
+      pages_.pop_front();
+    } else if (has_next_page_ && !is_closed_) {
+      // The future is set with the page after the ones already requested
+      future.reset(new ResponseFuture());
+      waiting_.push_back(future);
+    } else {
+      future.reset(new ResponseFuture());
+      future->set_error(CASS_ERROR_LIB_NO_PAGING_STATE, "No more pages");
+      return future;
+    }
+
+    // Taking a page makes room for the next one
+    request = maybe_fetch(lock);
+  }
+  if (request) fetch(request);
+  return future;
+}
+
+void Pager::close() {
+  FutureQueue waiting;
+  {
+    ScopedMutex lock(&mutex_);
+    is_closed_ = true;
+    has_next_page_ = false;
+    pages_.clear();
+    buffered_bytes_ = 0;
+    waiting.swap(waiting_);
+  }
+  fail_waiting(&waiting, "The pager was closed");
+}
+
+Future::Ptr Pager::execute(const Statement::Ptr& statement) {
+  return session_->execute(Request::ConstPtr(statement));
+}
+
+Statement::Ptr Pager::maybe_fetch(ScopedMutex& lock) {
+  if (is_closed_ || in_flight_ || !has_next_page_) {
+    return Statement::Ptr();
+  }
+
+  if (!waiting_.empty()) {
+    // The application is waiting for this page
+    in_flight_ = waiting_.front();
+    waiting_.pop_front();
+    is_in_flight_prefetched_ = false;
+  } else if (pages_.size() < prefetch_depth_ &&
+             (max_buffered_bytes_ == 0 || buffered_bytes_ < max_buffered_bytes_)) {
+    in_flight_.reset(new ResponseFuture());
+    pages_.push_back(Page(in_flight_.get()));
+    is_in_flight_prefetched_ = true;
+  } else {
+    return Statement::Ptr();
+  }
+
+  // Every page is sent using its own copy of the statement so the paging
+  // state can be updated while the previous request is still being retried
+  // or speculatively executed.
+  return Statement::Ptr(statement_->clone());
+}
+
+void Pager::fetch(const Statement::Ptr& statement) {
+  Future::Ptr future(execute(statement));
+  inc_ref(); // Released in on_page()
+  future->set_callback(on_page, this);
+}
+
+void Pager::on_page(CassFuture* future, void* data) {
+  Pager* pager = static_cast<Pager*>(data);
+  pager->handle_page(static_cast<ResponseFuture*>(future->from()));
+  pager->dec_ref();
+}
+
+void Pager::handle_page(ResponseFuture* future) {
+  // The future is already set so none of these wait
+  Future::Error* error = future->error();
+  Address address(future->address());
+  Response::Ptr response(future->response());
+
+  ResponseFuture::Ptr page_future;
+  Statement::Ptr request;
+  FutureQueue waiting;
+  {
+    ScopedMutex lock(&mutex_);
+    page_future = in_flight_;
+    in_flight_.reset();
+
+    if (error == NULL && response && response->opcode() == CQL_OPCODE_RESULT &&
+        static_cast<ResultResponse*>(response.get())->has_more_pages()) {
+      ResultResponse* result = static_cast<ResultResponse*>(response.get());
+      statement_->set_paging_state(result->paging_state().to_string());
+    } else {
+      has_next_page_ = false;
+    }
+
+    // A prefetched page is still queued if the application hasn't taken it
+    // yet. It's always the last page in the queue.
+    if (is_in_flight_prefetched_ && !pages_.empty() &&
+        pages_.back().future == page_future) {
+      size_t size = response ? response->buffer_size() : 0;
+      pages_.back().size = size;
+      buffered_bytes_ += size;
+    }
+
+    if (!has_next_page_) {
+      waiting.swap(waiting_);
+    }
+
+    request = maybe_fetch(lock);
+  }
+
+  // The next page is requested before the application's callback runs
+  if (request) fetch(request);
+
+  if (error == NULL) {
+    page_future->set_response(address, response);
+  } else if (response) {
+    page_future->set_error_with_response(address, response, error->code, error->message);
+  } else {
+    page_future->set_error_with_address(address, error->code, error->message);
+  }
+
+  // Futures for pages after the last one
+  fail_waiting(&waiting, "No more pages");
+}
+
+void Pager::fail_waiting(FutureQueue* waiting, const char* message) {
+  for (FutureQueue::iterator it = waiting->begin(),
+       end = waiting->end(); it != end; ++it) {
+    (*it)->set_error(CASS_ERROR_LIB_NO_PAGING_STATE, message);
+  }
+}
+
+} // namespace cass
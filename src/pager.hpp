@@ -0,0 +1,121 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#ifndef __CASS_PAGER_HPP_INCLUDED__
+#define __CASS_PAGER_HPP_INCLUDED__
+
+#include "cassandra.h"
+#include "external.hpp"
+#include "future.hpp"
+#include "macros.hpp"
+#include "ref_counted.hpp"
+#include "statement.hpp"
+
+#include <deque>
+#include <uv.h>
+
+namespace cass {
+
+class ResponseFuture;
+class Session;
+
+// Iterates over the pages of a statement's result and requests the next page
+// as soon as the previous page arrives, so the network round trip for a page
+// overlaps the application processing the pages before it. Pages can only be
+// requested one at a time (each request needs the previous page's paging
+// state), so at most one request is in flight. Pages are always requested
+// for the futures the application is waiting on. Other pages are prefetched
+// until "prefetch_depth" pages are waiting to be taken by the application or
+// the unconsumed pages use more than "max_buffered_bytes".
+class Pager : public RefCounted<Pager> {
+public:
+  typedef SharedRefPtr<Pager> Ptr;
+
+  Pager(Session* session, const Statement* statement);
+  virtual ~Pager();
+
+  void set_prefetch_depth(unsigned prefetch_depth);
+  void set_max_buffered_bytes(size_t max_buffered_bytes);
+
+  // Returns false after the last page (or an error) has been returned
+  bool has_more_pages();
+
+  size_t buffered_bytes();
+
+  // Returns a future for the next page. The future is set with the error
+  // CASS_ERROR_LIB_NO_PAGING_STATE if there are no more pages.
+  Future::Ptr next_page();
+
+  // Stops requesting pages. Prefetched pages are dropped and the futures
+  // still waiting for a page are failed.
+  void close();
+
+protected:
+  // Sends the request for a page (overridden by tests)
+  virtual Future::Ptr execute(const Statement::Ptr& statement);
+
+private:
+  struct Page {
+    Page(ResponseFuture* future)
+      : future(future)
+      , size(0) { }
+
+    SharedRefPtr<ResponseFuture> future;
+    size_t size;
+  };
+
+  typedef std::deque<Page> PageQueue;
+  typedef std::deque<SharedRefPtr<ResponseFuture> > FutureQueue;
+
+  // Queues the request for the next page if one is needed. The returned
+  // statement is sent after the lock is released.
+  Statement::Ptr maybe_fetch(ScopedMutex& lock);
+  void fetch(const Statement::Ptr& statement);
+
+  static void on_page(CassFuture* future, void* data);
+  void handle_page(ResponseFuture* future);
+
+  static void fail_waiting(FutureQueue* waiting, const char* message);
+
+private:
+  uv_mutex_t mutex_;
+  Session* session_;
+  Statement::Ptr statement_;
+  unsigned prefetch_depth_;
+  size_t max_buffered_bytes_;
+  size_t buffered_bytes_;
+  // Prefetched pages (the last one can still be in flight)
+  PageQueue pages_;
+  // Futures returned to the application for pages that haven't been
+  // requested yet or are in flight
+  FutureQueue waiting_;
+  // The page that's being requested
+  SharedRefPtr<ResponseFuture> in_flight_;
+  bool is_in_flight_prefetched_;
+  // The last page received has a paging state
+  bool has_next_page_;
+  bool is_closed_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(Pager);
+};
+
+} // namespace cass
+
+EXTERNAL_TYPE(cass::Pager, CassPager)
+
+#endif
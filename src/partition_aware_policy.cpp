@@ -92,9 +92,6 @@ static bool get_hash_key_from_execute(const ExecuteRequest* execute,
   // Set full table name.
   *full_table_name = result->keyspace().to_string() + '.' + result->table().to_string();
 
-  // Get binded values and write it into binary stream.
-  const AbstractData::ElementVec& elems = execute->elements();
-
   // Get primary keys indexes.
   const ResultResponse::PKIndexVec& ki = prepared->key_indices();
 
@@ -102,7 +99,8 @@ static bool get_hash_key_from_execute(const ExecuteRequest* execute,
   BufferVec buffers;
   size_t total_size = 0;
   for (size_t i : ki) {
-    const Buffer b = elems[i].get_buffer(CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION);
+    // Get binded values and write it into binary stream.
+    const Buffer b = execute->get_buffer(i, CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION);
 
     if (b.size() >= header_size) {
       buffers.push_back(b);
@@ -267,7 +265,7 @@ Host::Ptr PartitionAwarePolicy::PartitionAwareQueryPlan::compute_next() {
     host = (*replicas_)[0];
     assert(host);
 
-    if (host->is_up()) {
+    if (host->is_up() && host->allow_request()) {
       use_leader_ = false;
       return host;
     }
@@ -279,7 +277,8 @@ Host::Ptr PartitionAwarePolicy::PartitionAwareQueryPlan::compute_next() {
       --remaining_;
       host = ((*replicas_)[1 + (index_++ % (replicas_->size() - 1))]);
 
-      if (host->is_up() && child_policy_->distance(host) == CASS_HOST_DISTANCE_LOCAL) {
+      if (host->is_up() && child_policy_->distance(host) == CASS_HOST_DISTANCE_LOCAL &&
+          host->allow_request()) {
         return host;
       }
     }
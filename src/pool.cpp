@@ -123,12 +123,18 @@ Pool::Pool(IOWorker* io_worker,
     , cancel_reconnect_(false) { }
 
 Pool::~Pool() {
+  size_t pending_request_count = 0;
+  for (int i = 0; i < CASS_REQUEST_PRIORITY_COUNT; ++i) {
+    pending_request_count += pending_requests_[i].size();
+  }
   LOG_DEBUG("Pool(%p) dtor with %u pending requests",
             static_cast<void*>(this),
-            static_cast<unsigned int>(pending_requests_.size()));
-  for (RequestCallback::Vec::iterator it = pending_requests_.begin(),
-       end = pending_requests_.end(); it != end; ++it) {
-    (*it)->on_retry_next_host();
+            static_cast<unsigned int>(pending_request_count));
+  for (int i = 0; i < CASS_REQUEST_PRIORITY_COUNT; ++i) {
+    for (RequestCallback::Vec::iterator it = pending_requests_[i].begin(),
+         end = pending_requests_[i].end(); it != end; ++it) {
+      (*it)->on_retry_next_host();
+    }
   }
 }
 
@@ -213,6 +219,15 @@ Connection* Pool::borrow_connection() {
     return NULL;
   }
 
+  // Requests wait for the host's in-flight requests to drop below its
+  // adaptive limit the same way they wait for busy connections. The limit is
+  // shared with the other IO workers so this IO worker's loop is woken when
+  // requests finish on any of them.
+  if (host_->is_at_concurrency_limit() &&
+      host_->wait_for_concurrency(io_worker_->waker())) {
+    return NULL;
+  }
+
   Connection* connection = find_least_busy();
 
   if (connection == NULL ||
@@ -254,7 +269,7 @@ void Pool::wait_for_connection(const RequestCallback::Ptr& callback) {
     return;
   }
 
-  pending_requests_.push_back(callback);
+  pending_requests_[callback->priority()].push_back(callback);
 
   if (!is_pending_request_processing_) {
     io_worker_->add_pending_request_processing(this);
@@ -271,34 +286,54 @@ void Pool::flush() {
 }
 
 bool Pool::process_pending_requests() {
-  RequestCallback::Vec::iterator it = pending_requests_.begin();
-  for (RequestCallback::Vec::iterator end = pending_requests_.end();
-       it != end; ++it) {
-    const RequestCallback::Ptr& callback(*it);
-
-    // Skip cancelled requests (and remove them)
-    if (callback->state() == RequestCallback::REQUEST_STATE_CANCELLED) {
-      continue;
-    }
+  // Higher priority requests are given the available connections first
+  bool has_connection = true;
+  is_pending_request_processing_ = false;
+  for (int i = 0; i < CASS_REQUEST_PRIORITY_COUNT; ++i) {
+    RequestCallback::Vec& pending_requests = pending_requests_[i];
+
+    RequestCallback::Vec::iterator it = pending_requests.begin();
+    for (RequestCallback::Vec::iterator end = pending_requests.end();
+         has_connection && it != end; ++it) {
+      const RequestCallback::Ptr& callback(*it);
+
+      // Skip cancelled requests (and remove them)
+      if (callback->state() == RequestCallback::REQUEST_STATE_CANCELLED) {
+        continue;
+      }
+
+      if (callback->is_expired()) {
+        metrics_->pending_request_timeouts.inc();
+        callback->on_error(CASS_ERROR_LIB_REQUEST_TIMED_OUT,
+                           "Request deadline exceeded waiting for a connection");
+        continue;
+      }
 
-    Connection* connection = borrow_connection();
+      Connection* connection = borrow_connection();
 
-    // Stop processing requests because there are no more streams available.
-    if (connection == NULL) break;
+      // Stop processing requests because there are no more streams available.
+      if (connection == NULL) {
+        has_connection = false;
+        break;
+      }
 
-    if (!internal_write(connection, callback)) {
-      callback->on_retry_next_host();
+      if (!internal_write(connection, callback)) {
+        callback->on_retry_next_host();
+      }
     }
-  }
 
-  LOG_TRACE("Processed (or cancelled) %u pending request(s) on %s pool(%p)",
-            static_cast<unsigned int>(it - pending_requests_.begin()),
-            host_->address_string().c_str(),
-            static_cast<void*>(this));
+    LOG_TRACE("Processed (or cancelled) %u pending request(s) of priority %d on %s pool(%p)",
+              static_cast<unsigned int>(it - pending_requests.begin()),
+              i,
+              host_->address_string().c_str(),
+              static_cast<void*>(this));
 
-  pending_requests_.erase(pending_requests_.begin(), it);
+    pending_requests.erase(pending_requests.begin(), it);
 
-  is_pending_request_processing_ = !pending_requests_.empty();
+    if (!pending_requests.empty()) {
+      is_pending_request_processing_ = true;
+    }
+  }
 
   return is_pending_request_processing_;
 }
@@ -113,7 +113,8 @@ private:
   Connection::ConnectionError error_code_;
   ConnectionVec connections_;
   ConnectionVec pending_connections_;
-  RequestCallback::Vec pending_requests_;
+  // Requests waiting for a connection, by priority
+  RequestCallback::Vec pending_requests_[CASS_REQUEST_PRIORITY_COUNT];
   bool is_initial_connection_;
   bool is_pending_flush_;
   bool is_pending_request_processing_;
@@ -18,6 +18,7 @@
 #define __CASS_PREPARED_HPP_INCLUDED__
 
 #include "buffer.hpp"
+#include "dense_hash_map.hpp"
 #include "external.hpp"
 #include "prepare_request.hpp"
 #include "ref_counted.hpp"
@@ -27,7 +28,6 @@
 #include "scoped_lock.hpp"
 #include "scoped_ptr.hpp"
 
-#include <sparsehash/dense_hash_set>
 #include <string>
 #include <uv.h>
 #include <vector>
@@ -125,7 +125,7 @@ public:
   }
 
 private:
-  typedef sparsehash::dense_hash_map<std::string, Entry::Ptr> Map;
+  typedef DenseHashMap<std::string, Entry::Ptr> Map;
 
   mutable uv_rwlock_t rwlock_;
   Map metadata_;
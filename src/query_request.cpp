@@ -23,6 +23,16 @@
 
 namespace cass {
 
+QueryRequest::QueryRequest(const QueryRequest& other)
+  : Statement(other) {
+  if (other.value_names_) {
+    value_names_.reset(new ValueNameHashTable(elements_count()));
+    for (size_t i = 0; i < other.value_names_->size(); ++i) {
+      value_names_->add(ValueName((*other.value_names_)[i].name));
+    }
+  }
+}
+
 int QueryRequest::encode(int version, RequestCallback* callback, BufferVec* bufs) const {
   if (version == 1) {
     return encode_v1(callback, bufs);
@@ -33,7 +43,7 @@ int QueryRequest::encode(int version, RequestCallback* callback, BufferVec* bufs
       length += encode_begin(version, value_names_->size(), callback, bufs);
       result = encode_values_with_names(version, callback, bufs);
     } else {
-      length += encode_begin(version, elements().size(), callback, bufs);
+      length += encode_begin(version, elements_count(), callback, bufs);
       result = encode_values(version, callback, bufs);
     }
     if (result < 0) return result;
@@ -53,10 +63,7 @@ int32_t QueryRequest::encode_values_with_names(int version, RequestCallback* cal
     const Buffer& name_buf = (*value_names_)[i].buf;
     bufs->push_back(name_buf);
 
-    Buffer value_buf(elements()[i].get_buffer(version));
-    bufs->push_back(value_buf);
-
-    size += name_buf.size() + value_buf.size();
+    size += name_buf.size() + get_buffers(i, version, bufs);
   }
   return size;
 }
@@ -64,11 +71,11 @@ int32_t QueryRequest::encode_values_with_names(int version, RequestCallback* cal
 size_t QueryRequest::get_indices(StringRef name, IndexVec* indices) {
   if (!value_names_) {
     set_has_names_for_values(true);
-    value_names_.reset(new ValueNameHashTable(elements().size()));
+    value_names_.reset(new ValueNameHashTable(elements_count()));
   }
 
   if (value_names_->get_indices(name, indices) == 0) {
-    if (value_names_->size() > elements().size()) {
+    if (value_names_->size() > elements_count()) {
       // No more space left for new named values
       return 0;
     }
@@ -36,9 +36,15 @@ public:
                size_t value_count)
     : Statement(query, query_length, value_count) { }
 
+  virtual QueryRequest* clone() const {
+    return new QueryRequest(*this);
+  }
+
   virtual int encode(int version, RequestCallback* callback, BufferVec* bufs) const;
 
 private:
+  QueryRequest(const QueryRequest& other);
+
   int32_t encode_values_with_names(int version, RequestCallback* callback, BufferVec* bufs) const;
 
   virtual size_t get_indices(StringRef name, IndexVec* indices);
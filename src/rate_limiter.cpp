@@ -0,0 +1,59 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#include "rate_limiter.hpp"
+
+#include <algorithm>
+
+// Keeps the burst's tolerance and the arrival times from overflowing. This
+// is over a hundred years so lower rates make no practical difference.
+#define MAX_TOLERANCE_NS (static_cast<uint64_t>(1) << 62)
+
+namespace cass {
+
+static uint64_t interval_ns(const RateLimiter::Settings& settings) {
+  uint64_t max_interval_ns = MAX_TOLERANCE_NS / std::max(settings.burst, 1u);
+  double interval_ns = 1e9 / settings.requests_per_second;
+  if (!(interval_ns < static_cast<double>(max_interval_ns))) {
+    return max_interval_ns;
+  }
+  return std::max(static_cast<uint64_t>(interval_ns), static_cast<uint64_t>(1));
+}
+
+RateLimiter::RateLimiter(const Settings& settings)
+  : interval_ns_(interval_ns(settings))
+  , tolerance_ns_(interval_ns_ * std::max(settings.burst, 1u))
+  , theoretical_arrival_ns_(0) { }
+
+bool RateLimiter::acquire(uint64_t now_ns, uint64_t max_wait_ns, uint64_t* wait_ns) {
+  uint64_t theoretical_arrival_ns = theoretical_arrival_ns_.load(MEMORY_ORDER_RELAXED);
+  while (true) {
+    uint64_t next_arrival_ns = std::max(theoretical_arrival_ns, now_ns) + interval_ns_;
+    uint64_t allowed_at_ns = next_arrival_ns > tolerance_ns_ ? next_arrival_ns - tolerance_ns_ : 0;
+    *wait_ns = allowed_at_ns > now_ns ? allowed_at_ns - now_ns : 0;
+    if (*wait_ns > max_wait_ns) {
+      return false;
+    }
+    if (theoretical_arrival_ns_.compare_exchange_weak(theoretical_arrival_ns,
+                                                      next_arrival_ns,
+                                                      MEMORY_ORDER_RELAXED)) {
+      return true;
+    }
+  }
+}
+
+} // namespace cass
@@ -0,0 +1,70 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#ifndef __CASS_RATE_LIMITER_HPP_INCLUDED__
+#define __CASS_RATE_LIMITER_HPP_INCLUDED__
+
+#include "atomic.hpp"
+#include "macros.hpp"
+
+#include <stdint.h>
+
+namespace cass {
+
+// A token bucket implemented as a generic cell rate algorithm (GCRA). The
+// whole bucket is a single atomic "theoretical arrival time" so it can be
+// shared by all the application and IO threads without locking. A request
+// that arrives before its theoretical arrival time (minus the burst) has to
+// wait until then for its token.
+class RateLimiter {
+public:
+  struct Settings {
+    Settings()
+      : requests_per_second(0.0)
+      , burst(1) { }
+
+    bool is_enabled() const { return requests_per_second > 0.0; }
+
+    double requests_per_second;
+    unsigned burst;
+  };
+
+  RateLimiter(const Settings& settings);
+
+  // Takes a token if one is available within "max_wait_ns". The time to wait
+  // for the token is returned in "wait_ns" (zero if the token is available
+  // now). If the request would have to wait longer than "max_wait_ns" then
+  // no token is taken and false is returned.
+  bool acquire(uint64_t now_ns, uint64_t max_wait_ns, uint64_t* wait_ns);
+
+  bool try_acquire(uint64_t now_ns) {
+    uint64_t wait_ns;
+    return acquire(now_ns, 0, &wait_ns);
+  }
+
+private:
+  const uint64_t interval_ns_;
+  const uint64_t tolerance_ns_;
+  Atomic<uint64_t> theoretical_arrival_ns_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(RateLimiter);
+};
+
+} // namespace cass
+
+#endif
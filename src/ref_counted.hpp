@@ -19,6 +19,7 @@
 
 #include "atomic.hpp"
 #include "macros.hpp"
+#include "memory.hpp"
 
 #include <assert.h>
 #include <new>
@@ -26,7 +27,8 @@
 
 namespace cass {
 
-struct RefCountedBase { };
+// Reference counted objects are allocated using the driver's allocator
+struct RefCountedBase : public Allocated { };
 
 template <class T>
 class RefCounted : public RefCountedBase {
@@ -133,33 +135,82 @@ private:
 class RefBuffer : public RefCounted<RefBuffer> {
 public:
   typedef SharedRefPtr<RefBuffer> Ptr;
+  typedef void (*ReleaseCallback)(void* data);
 
   static RefBuffer* create(size_t size) {
 #if defined(_WIN32)
 #pragma warning(push)
 #pragma warning(disable: 4291) //Invalid warning thrown RefBuffer has a delete function
 #endif
-    return new (size) RefBuffer();
+    return new (size) RefBuffer(false);
 #if defined(_WIN32)
 #pragma warning(pop)
 #endif
   }
 
+  // A buffer that references memory owned by the application. The release
+  // callback is called when the buffer is no longer referenced.
+  static RefBuffer* create_external(const char* data,
+                                    ReleaseCallback release_callback,
+                                    void* release_data) {
+#if defined(_WIN32)
+#pragma warning(push)
+#pragma warning(disable: 4291) //Invalid warning thrown RefBuffer has a delete function
+#endif
+    RefBuffer* buffer = new (sizeof(External)) RefBuffer(true);
+#if defined(_WIN32)
+#pragma warning(pop)
+#endif
+    External* external = buffer->external();
+    external->data = const_cast<char*>(data);
+    external->release_callback = release_callback;
+    external->release_data = release_data;
+    return buffer;
+  }
+
+  ~RefBuffer() {
+    if (is_external_) {
+      External* external = this->external();
+      if (external->release_callback != NULL) {
+        external->release_callback(external->release_data);
+      }
+    }
+  }
+
   char* data() {
-    return reinterpret_cast<char*>(this) + sizeof(RefBuffer);
+    return is_external_ ? external()->data : inline_data();
   }
 
   void operator delete(void* ptr) {
-    ::operator delete(ptr);
+    Memory::free(ptr);
   }
 
 private:
-  RefBuffer() { }
+  struct External {
+    char* data;
+    ReleaseCallback release_callback;
+    void* release_data;
+  };
+
+  RefBuffer(bool is_external)
+    : is_external_(is_external) { }
+
+  char* inline_data() {
+    return reinterpret_cast<char*>(this) + sizeof(RefBuffer);
+  }
+
+  External* external() {
+    return reinterpret_cast<External*>(inline_data());
+  }
 
   void* operator new(size_t size, size_t extra) {
-    return ::operator new(size + extra);
+    void* ptr = Memory::malloc(size + extra);
+    if (ptr == NULL) throw std::bad_alloc();
+    return ptr;
   }
 
+  bool is_external_;
+
   DISALLOW_COPY_AND_ASSIGN(RefBuffer);
 };
 
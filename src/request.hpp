@@ -63,12 +63,16 @@ struct RequestSettings {
     : consistency(CASS_CONSISTENCY_UNKNOWN)
     , serial_consistency(CASS_CONSISTENCY_UNKNOWN)
     , request_timeout_ms(CASS_UINT64_MAX)
-    , is_idempotent(false) { }
+    , deadline_ms(CASS_UINT64_MAX)
+    , is_idempotent(false)
+    , priority(CASS_REQUEST_PRIORITY_NORMAL) { }
   CassConsistency consistency;
   CassConsistency serial_consistency;
   uint64_t request_timeout_ms;
+  uint64_t deadline_ms;
   RetryPolicy::Ptr retry_policy;
   bool is_idempotent;
+  CassRequestPriority priority;
   std::string keyspace;
 };
 
@@ -81,7 +85,8 @@ public:
     REQUEST_ERROR_BATCH_WITH_NAMED_VALUES = -2,
     REQUEST_ERROR_PARAMETER_UNSET = -3,
     REQUEST_ERROR_NO_AVAILABLE_STREAM_IDS = -4,
-    REQUEST_ERROR_CANCELLED = -5
+    REQUEST_ERROR_CANCELLED = -5,
+    REQUEST_ERROR_DEADLINE_EXCEEDED = -6
   };
 
   Request(uint8_t opcode)
@@ -113,6 +118,12 @@ public:
     settings_.request_timeout_ms = request_timeout_ms;
   }
 
+  uint64_t deadline_ms() const { return settings_.deadline_ms; }
+
+  void set_deadline_ms(uint64_t deadline_ms) {
+    settings_.deadline_ms = deadline_ms;
+  }
+
   const RetryPolicy::Ptr& retry_policy() const {
     return settings_.retry_policy;
   }
@@ -129,6 +140,10 @@ public:
 
   void set_is_idempotent(bool is_idempotent) { settings_.is_idempotent = is_idempotent; }
 
+  CassRequestPriority priority() const { return settings_.priority; }
+
+  void set_priority(CassRequestPriority priority) { settings_.priority = priority; }
+
   const std::string& keyspace() const { return settings_.keyspace; }
 
   void set_keyspace(const std::string& keyspace) { settings_.keyspace = keyspace; }
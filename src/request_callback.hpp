@@ -22,6 +22,7 @@
 #include "constants.hpp"
 #include "utils.hpp"
 #include "list.hpp"
+#include "object_pool.hpp"
 #include "prepared.hpp"
 #include "request.hpp"
 #include "response.hpp"
@@ -55,6 +56,7 @@ public:
     , consistency_(CASS_DEFAULT_CONSISTENCY)
     , serial_consistency_(CASS_DEFAULT_SERIAL_CONSISTENCY)
     , request_timeout_ms_(CASS_DEFAULT_REQUEST_TIMEOUT_MS)
+    , deadline_ns_(CASS_UINT64_MAX)
     , timestamp_(CASS_INT64_MIN) { }
 
   void init(const Config& config,
@@ -85,6 +87,16 @@ public:
     return request_timeout_ms_;
   }
 
+  // The absolute time (from uv_hrtime()) by which the request must be
+  // finished, including the time it spends in the driver's queues.
+  uint64_t deadline_ns() const { return deadline_ns_; }
+
+  void set_deadline_ns(uint64_t deadline_ns) { deadline_ns_ = deadline_ns; }
+
+  bool is_expired() const {
+    return deadline_ns_ != CASS_UINT64_MAX && uv_hrtime() >= deadline_ns_;
+  }
+
   int64_t timestamp() const {
     if (request()->timestamp() != CASS_INT64_MIN) {
       return request()->timestamp();
@@ -108,12 +120,14 @@ private:
   CassConsistency consistency_;
   CassConsistency serial_consistency_;
   uint64_t request_timeout_ms_;
+  uint64_t deadline_ns_;
   int64_t timestamp_;
   RetryPolicy::Ptr retry_policy_;
   PreparedMetadata::Entry::Ptr prepared_metadata_entry_;
 };
 
-class RequestCallback : public RefCounted<RequestCallback>, public List<RequestCallback>::Node {
+class RequestCallback : public PooledRefCounted<RequestCallback>,
+                        public List<RequestCallback>::Node {
 public:
   typedef SharedRefPtr<RequestCallback> Ptr;
   typedef std::vector<Ptr> Vec;
@@ -153,6 +167,10 @@ public:
 
   const Request* request() const { return wrapper_.request().get(); }
 
+  CassRequestPriority priority() const { return request()->priority(); }
+
+  bool is_expired() const { return wrapper_.is_expired(); }
+
   bool skip_metadata() const;
 
   CassConsistency consistency() {
@@ -0,0 +1,91 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "request_coalescer.hpp"
+
+#include "request_handler.hpp"
+#include "scoped_lock.hpp"
+
+namespace cass {
+
+RequestCoalescer::Call::~Call() {
+  if (is_finished_) return;
+  std::vector<ResponseFuture::Ptr> followers;
+  remove(&followers);
+  for (std::vector<ResponseFuture::Ptr>::iterator it = followers.begin(),
+       end = followers.end(); it != end; ++it) {
+    (*it)->set_error(CASS_ERROR_LIB_INTERNAL_ERROR,
+                     "The request shared by coalesced reads was dropped");
+  }
+}
+
+void RequestCoalescer::Call::finish(ResponseFuture* future) {
+  std::vector<ResponseFuture::Ptr> followers;
+  remove(&followers);
+  if (followers.empty()) return;
+
+  // The future is already set so none of these wait
+  Future::Error* error = future->error();
+  Address address(future->address());
+  Response::Ptr response(future->response());
+  for (std::vector<ResponseFuture::Ptr>::iterator it = followers.begin(),
+       end = followers.end(); it != end; ++it) {
+    if (error == NULL) {
+      (*it)->set_response(address, response);
+    } else if (response) {
+      (*it)->set_error_with_response(address, response, error->code, error->message);
+    } else {
+      (*it)->set_error_with_address(address, error->code, error->message);
+    }
+  }
+}
+
+void RequestCoalescer::Call::remove(std::vector<ResponseFuture::Ptr>* followers) {
+  ScopedMutex l(&coalescer_->mutex_);
+  coalescer_->calls_.erase(key_);
+  followers->swap(followers_);
+  is_finished_ = true;
+}
+
+RequestCoalescer::RequestCoalescer() {
+  uv_mutex_init(&mutex_);
+  calls_.set_empty_key(std::string());
+  calls_.set_deleted_key(std::string(1, '\0'));
+}
+
+RequestCoalescer::~RequestCoalescer() {
+  uv_mutex_destroy(&mutex_);
+}
+
+RequestCoalescer::Call::Ptr RequestCoalescer::join(const std::string& key,
+                                                   ResponseFuture* future) {
+  ScopedMutex l(&mutex_);
+  CallMap::iterator it = calls_.find(key);
+  if (it != calls_.end()) {
+    it->second->followers_.push_back(ResponseFuture::Ptr(future));
+    return Call::Ptr();
+  }
+  Call::Ptr call(new Call(this, key));
+  calls_[key] = call.get();
+  return call;
+}
+
+size_t RequestCoalescer::size() {
+  ScopedMutex l(&mutex_);
+  return calls_.size();
+}
+
+} // namespace cass
@@ -0,0 +1,89 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_REQUEST_COALESCER_HPP_INCLUDED__
+#define __CASS_REQUEST_COALESCER_HPP_INCLUDED__
+
+#include "dense_hash_map.hpp"
+#include "macros.hpp"
+#include "ref_counted.hpp"
+
+#include <string>
+#include <uv.h>
+#include <vector>
+
+namespace cass {
+
+class RequestCoalescer;
+class ResponseFuture;
+
+// Lets concurrent identical reads share a single request ("single-flight").
+// The first request for a key is sent and requests with the same key that
+// arrive while it's in flight wait for it instead. When the sent request
+// finishes all the waiting futures are completed with its (refcounted)
+// response or error.
+class RequestCoalescer {
+public:
+  class Call : public RefCounted<Call> {
+  public:
+    typedef SharedRefPtr<Call> Ptr;
+
+    Call(RequestCoalescer* coalescer, const std::string& key)
+      : coalescer_(coalescer)
+      , key_(key)
+      , is_finished_(false) { }
+
+    // Fails the waiting futures if the call was never finished
+    ~Call();
+
+    // Removes the call so later requests are sent again, then completes the
+    // waiting futures using the sent request's future.
+    void finish(ResponseFuture* future);
+
+  private:
+    friend class RequestCoalescer;
+
+    void remove(std::vector<SharedRefPtr<ResponseFuture> >* followers);
+
+    RequestCoalescer* coalescer_;
+    std::string key_;
+    bool is_finished_;
+    std::vector<SharedRefPtr<ResponseFuture> > followers_;
+  };
+
+  RequestCoalescer();
+  ~RequestCoalescer();
+
+  // Returns a new call if there isn't one in flight for the key (the request
+  // needs to be sent). Otherwise the future is added to the call in flight
+  // and NULL is returned.
+  Call::Ptr join(const std::string& key, ResponseFuture* future);
+
+  size_t size();
+
+private:
+  typedef DenseHashMap<std::string, Call*> CallMap;
+
+  uv_mutex_t mutex_;
+  CallMap calls_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(RequestCoalescer);
+};
+
+} // namespace cass
+
+#endif
@@ -115,20 +115,30 @@ void RequestHandler::schedule_next_execution(const Host::Ptr& current_host) {
   }
 }
 
+void RequestHandler::invalidate_result_cache(const Response* response) {
+  if (result_cache_ != NULL && !result_cache_fill_) {
+    result_cache_->invalidate(request(), response);
+  }
+}
+
 void RequestHandler::init(Session* session) {
+  init(session, session->config().load_balancing_policy().get());
+}
+
+void RequestHandler::init(Session* session, LoadBalancingPolicy* load_balancing_policy) {
   const Config& config = session->config();
   wrapper_.init(config, session->prepared_metadata());
 
   // Attempt to use the statement's keyspace first then if not set then use the session's keyspace
   const std::string& keyspace(!request()->keyspace().empty() ? request()->keyspace() : session->keyspace());
 
-  query_plan_.reset(config.load_balancing_policy()->new_query_plan(keyspace, this, session));
+  query_plan_.reset(load_balancing_policy->new_query_plan(keyspace, this, session));
   execution_plan_.reset(config.speculative_execution_policy()->new_plan(keyspace, wrapper_.request().get()));
 }
 
 void RequestHandler::start_request(IOWorker* io_worker) {
   io_worker_ = io_worker;
-  uint64_t request_timeout_ms = wrapper_.request_timeout_ms();
+  uint64_t request_timeout_ms = this->request_timeout_ms(uv_hrtime());
   if (request_timeout_ms > 0) { // 0 means no timeout
     timer_.start(io_worker->loop(),
                  request_timeout_ms,
@@ -137,16 +147,32 @@ void RequestHandler::start_request(IOWorker* io_worker) {
   }
 }
 
+uint64_t RequestHandler::request_timeout_ms(uint64_t now_ns) const {
+  uint64_t request_timeout_ms = wrapper_.request_timeout_ms();
+  uint64_t deadline_ns = wrapper_.deadline_ns();
+  if (deadline_ns != CASS_UINT64_MAX) {
+    // The request can't time out after its deadline
+    uint64_t remaining_ms = deadline_ns > now_ns ? (deadline_ns - now_ns + 999999) / (1000 * 1000) : 1;
+    if (request_timeout_ms == 0 || remaining_ms < request_timeout_ms) {
+      request_timeout_ms = remaining_ms;
+    }
+  }
+  return request_timeout_ms;
+}
+
 void RequestHandler::set_response(const Host::Ptr& host,
                                   const Response::Ptr& response) {
+  invalidate_result_cache(response.get());
   if (future_->set_response(host->address(), response)) {
-    io_worker_->metrics()->record_request(uv_hrtime() - start_time_ns_);
+    io_worker_->metrics()->record_request(uv_hrtime() - start_time_ns_,
+                                          request()->priority());
     stop_request();
   }
 }
 
 void RequestHandler::set_error(CassError code,
                                const std::string& message) {
+  invalidate_result_cache(NULL);
   if (future_->set_error(code, message)) {
     stop_request();
   }
@@ -157,6 +183,7 @@ void RequestHandler::set_error(const Host::Ptr& host,
   bool skip = (code == CASS_ERROR_LIB_NO_HOSTS_AVAILABLE && --running_executions_ > 0);
   if (!skip) {
     if (host) {
+      invalidate_result_cache(NULL);
       if (future_->set_error_with_address(host->address(), code, message)) {
         stop_request();
       }
@@ -169,6 +196,7 @@ void RequestHandler::set_error(const Host::Ptr& host,
 void RequestHandler::set_error_with_error_response(const Host::Ptr& host,
                                                    const Response::Ptr& error,
                                                    CassError code, const std::string& message) {
+  invalidate_result_cache(NULL);
   if (future_->set_error_with_response(host->address(), error, code, message)) {
     stop_request();
   }
@@ -178,13 +206,35 @@ void RequestHandler::on_timeout(Timer* timer) {
   RequestHandler* request_handler =
       static_cast<RequestHandler*>(timer->data());
   request_handler->io_worker_->metrics()->request_timeouts.inc();
+  // Hosts that were still working on the request lower their concurrency
+  // limits and count the timeout against their circuit breakers
+  for (RequestExecutionVec::const_iterator i = request_handler->request_executions_.begin(),
+       end = request_handler->request_executions_.end(); i != end; ++i) {
+    RequestExecution* request_execution = *i;
+    if (request_execution->state() == RequestCallback::REQUEST_STATE_WRITING ||
+        request_execution->state() == RequestCallback::REQUEST_STATE_READING ||
+        request_execution->state() == RequestCallback::REQUEST_STATE_READ_BEFORE_WRITE) {
+      request_execution->current_host()->drop_concurrency_limit();
+      request_execution->current_host()->record_request_failure(request_execution->start_time_ns());
+    }
+  }
   request_handler->set_error(CASS_ERROR_LIB_REQUEST_TIMED_OUT,
                              "Request timed out");
   LOG_DEBUG("Request timed out");
 }
 
 void RequestHandler::stop_request() {
+  // Cancelled executions release their references to this handler
+  RequestHandler::Ptr temp(this);
   timer_.stop();
+  if (coalesced_call_) {
+    coalesced_call_->finish(future_.get());
+    coalesced_call_.reset();
+  }
+  if (result_cache_fill_) {
+    result_cache_->add(result_cache_fill_, future_.get(), uv_hrtime());
+    result_cache_fill_.reset();
+  }
   for (RequestExecutionVec::const_iterator i = request_executions_.begin(),
        end = request_executions_.end(); i != end; ++i) {
     RequestExecution* request_execution = *i;
@@ -231,6 +281,20 @@ void RequestExecution::retry_next_host() {
 
 void RequestExecution::on_execute(Timer* timer) {
   RequestExecution* request_execution = static_cast<RequestExecution*>(timer->data());
+  Metrics* metrics = request_execution->request_handler_->io_worker()->metrics();
+  if (!request_execution->request_handler_->execution_plan_->acquire_execution()) {
+    // The speculative execution isn't sent. This is reported the same way as
+    // an execution that has run out of hosts so that it's ignored while other
+    // executions are still running.
+    LOG_DEBUG("Dropping speculative execution (%p) for request (%p)",
+              static_cast<void*>(request_execution),
+              static_cast<void*>(request_execution->request_handler_.get()));
+    metrics->dropped_speculative_executions.inc();
+    request_execution->set_error(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE,
+                                 "No hosts available for the speculative execution");
+    return;
+  }
+  metrics->speculative_executions.inc();
   request_execution->next_host();
   request_execution->execute();
 }
@@ -265,6 +329,9 @@ void RequestExecution::on_error(CassError code, const std::string& message) {
   // Handle recoverable errors by retrying with the next host
   if (code == CASS_ERROR_LIB_WRITE_ERROR ||
       code == CASS_ERROR_LIB_UNABLE_TO_SET_KEYSPACE) {
+    if (code == CASS_ERROR_LIB_WRITE_ERROR) {
+      current_host_->record_request_failure(start_time_ns_);
+    }
     retry_next_host();
   } else {
     set_error(code, message);
@@ -329,6 +396,15 @@ void RequestExecution::execute() {
 
 }
 
+void RequestExecution::execute_delayed(uint64_t delay_ms) {
+  schedule_timer_.start(request_handler_->io_worker()->loop(), delay_ms, this, on_execute_delayed);
+}
+
+void RequestExecution::on_execute_delayed(Timer* timer) {
+  RequestExecution* request_execution = static_cast<RequestExecution*>(timer->data());
+  request_execution->execute();
+}
+
 void RequestExecution::schedule_next(int64_t timeout) {
   if (timeout > 0) {
     schedule_timer_.start(request_handler_->io_worker()->loop(), timeout, this, on_execute);
@@ -340,16 +416,28 @@ void RequestExecution::schedule_next(int64_t timeout) {
 
 void RequestExecution::cancel() {
   schedule_timer_.stop();
+  bool is_finished = (state() == REQUEST_STATE_FINISHED);
   set_state(REQUEST_STATE_CANCELLED);
+  if (!is_finished) {
+    // A losing execution can stay in flight until its host responds, but it
+    // doesn't need the request handler (and the future and response it
+    // holds) anymore. Its response is discarded without being decoded.
+    request_handler_.reset();
+  }
 }
 
 void RequestExecution::on_result_response(Connection* connection, ResponseMessage* response) {
   ResultResponse* result =
       static_cast<ResultResponse*>(response->response_body().get());
 
+  uint64_t latency_ns = uv_hrtime() - start_time_ns_;
+  request_handler_->execution_plan_->record_latency(current_host_, latency_ns);
+  current_host_->update_concurrency_limit(latency_ns);
+  current_host_->record_request_success(start_time_ns_);
+
   switch (result->kind()) {
     case CASS_RESULT_KIND_ROWS:
-      current_host_->update_latency(uv_hrtime() - start_time_ns_);
+      current_host_->update_latency(latency_ns);
 
       // Execute statements with no metadata get their metadata from
       // result_metadata() returned when the statement was prepared.
@@ -407,6 +495,8 @@ void RequestExecution::on_error_response(Connection* connection, ResponseMessage
 
   switch(error->code()) {
     case CQL_ERROR_READ_TIMEOUT:
+      current_host_->drop_concurrency_limit();
+      current_host_->record_request_failure(start_time_ns_);
       if (retry_policy()) {
         decision =  retry_policy()->on_read_timeout(request(),
                                                     error->consistency(),
@@ -418,6 +508,8 @@ void RequestExecution::on_error_response(Connection* connection, ResponseMessage
       break;
 
     case CQL_ERROR_WRITE_TIMEOUT:
+      current_host_->drop_concurrency_limit();
+      current_host_->record_request_failure(start_time_ns_);
       if (retry_policy() && request()->is_idempotent()) {
         decision = retry_policy()->on_write_timeout(request(),
                                                     error->consistency(),
@@ -441,6 +533,8 @@ void RequestExecution::on_error_response(Connection* connection, ResponseMessage
     case CQL_ERROR_OVERLOADED:
       LOG_WARN("Host %s is overloaded.",
                connection->address_string().c_str());
+      current_host_->drop_concurrency_limit();
+      current_host_->record_request_failure(start_time_ns_);
       if (retry_policy() && request()->is_idempotent()) {
         decision = retry_policy()->on_request_error(request(),
                                                     consistency(),
@@ -454,6 +548,7 @@ void RequestExecution::on_error_response(Connection* connection, ResponseMessage
                error->message().to_string().c_str(),
                connection->address_string().c_str());
       connection->defunct();
+      current_host_->record_request_failure(start_time_ns_);
       if (retry_policy() && request()->is_idempotent()) {
         decision = retry_policy()->on_request_error(request(),
                                                     consistency(),
@@ -535,16 +630,22 @@ bool RequestExecution::is_host_up(const Address& address) const {
 }
 
 void RequestExecution::set_response(const Response::Ptr& response) {
-  request_handler_->set_response(current_host_, response);
+  if (request_handler_) {
+    request_handler_->set_response(current_host_, response);
+  }
 }
 
 void RequestExecution::set_error(CassError code, const std::string& message) {
-  request_handler_->set_error(current_host_, code, message);
+  if (request_handler_) {
+    request_handler_->set_error(current_host_, code, message);
+  }
 }
 
 void RequestExecution::set_error_with_error_response(const Response::Ptr& error,
                                                      CassError code, const std::string& message) {
-  request_handler_->set_error_with_error_response(current_host_, error, code, message);
+  if (request_handler_) {
+    request_handler_->set_error_with_error_response(current_host_, error, code, message);
+  }
 }
 
 } // namespace cass
@@ -24,9 +24,12 @@
 #include "host.hpp"
 #include "load_balancing.hpp"
 #include "metadata.hpp"
+#include "object_pool.hpp"
 #include "prepare_request.hpp"
 #include "request.hpp"
+#include "request_coalescer.hpp"
 #include "response.hpp"
+#include "result_cache.hpp"
 #include "result_response.hpp"
 #include "retry_policy.hpp"
 #include "scoped_ptr.hpp"
@@ -137,7 +140,7 @@ public:
                                           const ResultResponse::ConstPtr& result_response) = 0;
 };
 
-class RequestHandler : public RefCounted<RequestHandler> {
+class RequestHandler : public PooledRefCounted<RequestHandler> {
 public:
   typedef SharedRefPtr<RequestHandler> Ptr;
 
@@ -149,9 +152,19 @@ public:
     , io_worker_(NULL)
     , running_executions_(0)
     , start_time_ns_(uv_hrtime())
-    , listener_(listener) { }
+    , throttled_until_ns_(0)
+    , result_cache_(NULL)
+    , listener_(listener) {
+    // The deadline starts when the request is executed so that it includes
+    // the time spent waiting in the session's and IO worker's queues.
+    // Deadlines too far in the future to be represented are ignored.
+    if (request->deadline_ms() < (CASS_UINT64_MAX - start_time_ns_) / (1000 * 1000)) {
+      wrapper_.set_deadline_ns(start_time_ns_ + request->deadline_ms() * 1000 * 1000);
+    }
+  }
 
   void init(Session* session);
+  void init(Session* session, LoadBalancingPolicy* load_balancing_policy);
 
   const RequestWrapper& wrapper() const { return wrapper_; }
 
@@ -159,6 +172,17 @@ public:
 
   CassConsistency consistency() const { return wrapper_.consistency(); }
 
+  bool is_expired() const { return wrapper_.is_expired(); }
+
+  uint64_t start_time_ns() const { return start_time_ns_; }
+
+  // The time (from uv_hrtime()) until which a request delayed by a rate
+  // limiter has to wait before it's sent.
+  uint64_t throttled_until_ns() const { return throttled_until_ns_; }
+  void set_throttled_until_ns(uint64_t throttled_until_ns) {
+    throttled_until_ns_ = throttled_until_ns;
+  }
+
   const Address& preferred_address() const {
     return preferred_address_;
   }
@@ -167,6 +191,19 @@ public:
     preferred_address_ = preferred_address;
   }
 
+  // Coalesced reads waiting for this request are completed when it finishes
+  void set_coalesced_call(const RequestCoalescer::Call::Ptr& coalesced_call) {
+    coalesced_call_ = coalesced_call;
+  }
+
+  // Reads with a fill add their rows to the cache and any other requests
+  // invalidate the tables they might have written to
+  void set_result_cache(ResultCache* result_cache,
+                        const ResultCache::Fill::Ptr& result_cache_fill) {
+    result_cache_ = result_cache;
+    result_cache_fill_ = result_cache_fill;
+  }
+
   const Host::Ptr& current_host() const { return current_host_; }
   const Host::Ptr& next_host() {
     current_host_ = query_plan_->compute_next();
@@ -177,6 +214,10 @@ public:
 
   void start_request(IOWorker* io_worker);
 
+  // The request timeout capped by the time left before the request's
+  // deadline (0 means no timeout)
+  uint64_t request_timeout_ms(uint64_t now_ns) const;
+
   void set_response(const Host::Ptr& host,
                     const Response::Ptr& response);
   void set_error(CassError code, const std::string& message);
@@ -195,6 +236,7 @@ private:
   void add_execution(RequestExecution* request_execution);
   void add_attempted_address(const Address& address);
   void schedule_next_execution(const Host::Ptr& current_host);
+  void invalidate_result_cache(const Response* response);
 
   // This MUST only be called once and that's currently guaranteed by the
   // response future.
@@ -213,8 +255,12 @@ private:
   int running_executions_;
   RequestExecutionVec request_executions_;
   uint64_t start_time_ns_;
+  uint64_t throttled_until_ns_;
   Address preferred_address_;
   ResultMetadata::Ptr prepared_result_metadata_;
+  RequestCoalescer::Call::Ptr coalesced_call_;
+  ResultCache* result_cache_;
+  ResultCache::Fill::Ptr result_cache_fill_;
   RequestListener* listener_;
 };
 
@@ -226,9 +272,15 @@ public:
                    const Host::Ptr& current_host = Host::Ptr());
 
   const Host::Ptr& current_host() const { return current_host_; }
-  void next_host() { current_host_ = request_handler_->next_host(); }
+  // When the request was last sent (from uv_hrtime()) or 0 if it wasn't
+  uint64_t start_time_ns() const { return start_time_ns_; }
+  void next_host() {
+    // Cancelled executions are detached from their request handler
+    current_host_ = request_handler_ ? request_handler_->next_host() : Host::Ptr();
+  }
 
   void execute();
+  void execute_delayed(uint64_t delay_ms);
   void schedule_next(int64_t timeout = 0);
   void cancel();
 
@@ -246,6 +298,7 @@ private:
 
 private:
   static void on_execute(Timer* timer);
+  static void on_execute_delayed(Timer* timer);
 
   virtual void on_start();
 
@@ -138,8 +138,13 @@ ssize_t ResponseMessage::decode(char* input, size_t size) {
         return -1;
       }
 
-      response_body_->set_buffer(length_);
-      body_buffer_pos_ = response_body_->data();
+      if (filter_ != NULL && stream_ >= 0 && filter_->is_body_discarded(stream_)) {
+        is_body_discarded_ = true;
+        response_body_.reset();
+      } else {
+        response_body_->set_buffer(length_);
+        body_buffer_pos_ = response_body_->data();
+      }
     } else {
       // We haven't received all the data for the header. We consume the
       // entire buffer.
@@ -152,6 +157,14 @@ ssize_t ResponseMessage::decode(char* input, size_t size) {
   const size_t remaining = size - (input_pos - input);
   const size_t frame_size = header_size_ + length_;
 
+  if (is_body_discarded_) {
+    if (received_ >= frame_size) {
+      is_body_ready_ = true;
+      return size - (received_ - frame_size);
+    }
+    return size;
+  }
+
   if (received_ >= frame_size) {
     // We may have received more data then we need, only copy what we need
     size_t overage = received_ - frame_size;
@@ -162,22 +175,9 @@ ssize_t ResponseMessage::decode(char* input, size_t size) {
     input_pos += needed;
     assert(body_buffer_pos_ == response_body_->data() + length_);
 
-    char* pos = response_body()->data();
-
-    if (flags_ & CASS_FLAG_WARNING) {
-      pos = response_body()->decode_warnings(pos, length_);
-    }
-
-    if (flags_ & CASS_FLAG_CUSTOM_PAYLOAD) {
-      pos = response_body()->decode_custom_payload(pos, length_);
-    }
-
-    if (!response_body_->decode(version_, pos, length_)) {
-      is_body_error_ = true;
+    if (!decode_body()) {
       return -1;
     }
-
-    is_body_ready_ = true;
   } else {
     // We haven't received all the data for the frame. We consume the entire
     // buffer.
@@ -189,5 +189,45 @@ ssize_t ResponseMessage::decode(char* input, size_t size) {
   return input_pos - input;
 }
 
+size_t ResponseMessage::body_remaining() const {
+  if (!is_header_received_ || is_body_ready_ || is_body_error_ || is_body_discarded_) return 0;
+  return response_body_->data() + length_ - body_buffer_pos_;
+}
+
+ssize_t ResponseMessage::commit_body(size_t size) {
+  assert(size <= body_remaining());
+
+  received_ += size;
+  body_buffer_pos_ += size;
+
+  if (body_buffer_pos_ == response_body_->data() + length_) {
+    if (!decode_body()) {
+      return -1;
+    }
+  }
+
+  return size;
+}
+
+bool ResponseMessage::decode_body() {
+  char* pos = response_body()->data();
+
+  if (flags_ & CASS_FLAG_WARNING) {
+    pos = response_body()->decode_warnings(pos, length_);
+  }
+
+  if (flags_ & CASS_FLAG_CUSTOM_PAYLOAD) {
+    pos = response_body()->decode_custom_payload(pos, length_);
+  }
+
+  if (!response_body_->decode(version_, pos, length_)) {
+    is_body_error_ = true;
+    return false;
+  }
+
+  is_body_ready_ = true;
+  return true;
+}
+
 } // namespace cass
 
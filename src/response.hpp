@@ -43,7 +43,8 @@ public:
   typedef SmallVector<StringRef, 8> WarningVec;
 
   Response(uint8_t opcode)
-      : opcode_(opcode) { }
+      : opcode_(opcode)
+      , buffer_size_(0) { }
 
   virtual ~Response() { }
 
@@ -53,8 +54,11 @@ public:
 
   const RefBuffer::Ptr& buffer() const { return buffer_; }
 
+  size_t buffer_size() const { return buffer_size_; }
+
   void set_buffer(size_t size) {
     buffer_ = RefBuffer::Ptr(RefBuffer::create(size));
+    buffer_size_ = size;
   }
 
   const CustomPayloadVec& custom_payload() const { return custom_payload_; }
@@ -68,6 +72,7 @@ public:
 private:
   uint8_t opcode_;
   RefBuffer::Ptr buffer_;
+  size_t buffer_size_;
   CustomPayloadVec custom_payload_;
 
 private:
@@ -76,8 +81,18 @@ private:
 
 class ResponseMessage {
 public:
-  ResponseMessage()
-      : version_(0)
+  // Decides, once a response's header has been received, if its body can be
+  // skipped without being buffered or decoded (e.g. because the request on
+  // that stream has been cancelled).
+  class BodyFilter {
+  public:
+    virtual ~BodyFilter() { }
+    virtual bool is_body_discarded(int16_t stream) const = 0;
+  };
+
+  ResponseMessage(const BodyFilter* filter = NULL)
+      : filter_(filter)
+      , version_(0)
       , flags_(0)
       , stream_(0)
       , opcode_(0)
@@ -88,6 +103,7 @@ public:
       , header_buffer_pos_(header_buffer_)
       , is_body_ready_(false)
       , is_body_error_(false)
+      , is_body_discarded_(false)
       , body_buffer_pos_(NULL) {}
 
   uint8_t floats() const { return flags_; }
@@ -100,12 +116,26 @@ public:
 
   bool is_body_ready() const { return is_body_ready_; }
 
+  // The body was skipped and there's no response body
+  bool is_body_discarded() const { return is_body_discarded_; }
+
+  size_t frame_size() const { return header_size_ + length_; }
+
   ssize_t decode(char* input, size_t size);
 
+  // The part of the body that hasn't been received yet. Data can be written
+  // here directly (e.g. by decrypting into it) and then committed instead of
+  // being copied in by decode().
+  char* body_buffer_pos() const { return body_buffer_pos_; }
+  size_t body_remaining() const;
+  ssize_t commit_body(size_t size);
+
 private:
   bool allocate_body(int8_t opcode);
+  bool decode_body();
 
 private:
+  const BodyFilter* filter_;
   uint8_t version_;
   uint8_t flags_;
   int16_t stream_;
@@ -120,6 +150,7 @@ private:
 
   bool is_body_ready_;
   bool is_body_error_;
+  bool is_body_discarded_;
   Response::Ptr response_body_;
   char* body_buffer_pos_;
 
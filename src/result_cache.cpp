@@ -0,0 +1,279 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "result_cache.hpp"
+
+#include "batch_request.hpp"
+#include "execute_request.hpp"
+#include "hash.hpp"
+#include "request_handler.hpp"
+#include "result_response.hpp"
+#include "scoped_lock.hpp"
+
+#define NUM_SHARDS 16
+
+namespace cass {
+
+static std::string table_key(const std::string& keyspace, const std::string& table) {
+  std::string key(keyspace);
+  key.push_back('.');
+  key.append(table);
+  return key;
+}
+
+// The columns only have their own table spec if the metadata doesn't have a
+// global one (which is then stored in the prepared result)
+static std::string column_keyspace(const ResultResponse* prepared_result,
+                                   const ColumnDefinition& def) {
+  return (def.keyspace.empty() ? prepared_result->keyspace() : def.keyspace).to_string();
+}
+
+static std::string column_table(const ResultResponse* prepared_result,
+                                const ColumnDefinition& def) {
+  return (def.table.empty() ? prepared_result->table() : def.table).to_string();
+}
+
+// The conditional updates return rows with an "[applied]" column
+static bool is_read_result(const Response* response) {
+  if (response == NULL || response->opcode() != CQL_OPCODE_RESULT) return false;
+  const ResultResponse* result = static_cast<const ResultResponse*>(response);
+  if (result->kind() == CASS_RESULT_KIND_SET_KEYSPACE) return true;
+  return result->kind() == CASS_RESULT_KIND_ROWS &&
+      (result->column_count() == 0 ||
+       result->metadata()->get_column_definition(0).name != "[applied]");
+}
+
+ResultCache::Shard::Shard()
+  : size_bytes(0)
+  , evictions(0) {
+  uv_mutex_init(&mutex);
+  index.set_empty_key(std::string());
+  index.set_deleted_key(std::string(1, '\0'));
+}
+
+ResultCache::Shard::~Shard() {
+  uv_mutex_destroy(&mutex);
+}
+
+ResultCache::ResultCache(const Settings& settings)
+  : settings_(settings)
+  , max_shard_size_bytes_(std::max(settings.max_size_bytes / NUM_SHARDS,
+                                   static_cast<size_t>(1)))
+  , shards_(new Shard[NUM_SHARDS])
+  , epoch_(0)
+  , hits_(0)
+  , misses_(0) {
+  uv_mutex_init(&tables_mutex_);
+  tables_.set_empty_key(std::string());
+}
+
+ResultCache::~ResultCache() {
+  uv_mutex_destroy(&tables_mutex_);
+}
+
+Response::Ptr ResultCache::get(const ExecuteRequest* request, const std::string& key,
+                               uint64_t now_ns, Address* address, Fill::Ptr* fill) {
+  Shard& shard = shard_for(key);
+  {
+    ScopedMutex l(&shard.mutex);
+    EntryMap::iterator it = shard.index.find(key);
+    if (it != shard.index.end()) {
+      if (is_valid(*it->second, now_ns)) {
+        shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+        *address = it->second->address;
+        hits_.fetch_add(1, MEMORY_ORDER_RELAXED);
+        return it->second->response;
+      }
+      remove(shard, it);
+    }
+  }
+  misses_.fetch_add(1, MEMORY_ORDER_RELAXED);
+
+  // The generations are captured before the read is sent
+  const ResultResponse* prepared_result = request->prepared()->result().get();
+  const ColumnDefinition& def =
+      prepared_result->result_metadata()->get_column_definition(0);
+  Table::Ptr table(get_table(column_keyspace(prepared_result, def),
+                             column_table(prepared_result, def)));
+  fill->reset(new Fill(key, table,
+                       table->generation.load(MEMORY_ORDER_ACQUIRE),
+                       epoch_.load(MEMORY_ORDER_ACQUIRE)));
+  return Response::Ptr();
+}
+
+void ResultCache::add(const Fill::Ptr& fill, ResponseFuture* future, uint64_t now_ns) {
+  // The future is already set so none of these wait
+  if (future->error() != NULL) return;
+  const Response::Ptr& response(future->response());
+  if (is_read_result(response.get()) &&
+      static_cast<const ResultResponse*>(response.get())->kind() == CASS_RESULT_KIND_ROWS) {
+    put(fill, future->address(), response, now_ns);
+  }
+}
+
+void ResultCache::invalidate(const Request* request, const Response* response) {
+  switch (request->opcode()) {
+    case CQL_OPCODE_EXECUTE: {
+      const ExecuteRequest* execute = static_cast<const ExecuteRequest*>(request);
+      const ResultMetadata::Ptr& result_metadata(execute->prepared()->result()->result_metadata());
+      if (!result_metadata || result_metadata->column_count() == 0) {
+        invalidate_prepared(execute);
+      }
+      break;
+    }
+
+    case CQL_OPCODE_QUERY:
+      // The query isn't parsed so anything that didn't return rows could
+      // have been a write to any table
+      if (!is_read_result(response)) {
+        invalidate_all();
+      }
+      break;
+
+    case CQL_OPCODE_BATCH: {
+      const BatchRequest* batch = static_cast<const BatchRequest*>(request);
+      for (BatchRequest::StatementVec::const_iterator i = batch->statements().begin(),
+           end = batch->statements().end(); i != end; ++i) {
+        if ((*i)->opcode() == CQL_OPCODE_EXECUTE) {
+          invalidate_prepared(static_cast<const ExecuteRequest*>(i->get()));
+        } else {
+          invalidate_all();
+          break;
+        }
+      }
+      break;
+    }
+
+    default:
+      break;
+  }
+}
+
+void ResultCache::invalidate_table(const std::string& keyspace, const std::string& table) {
+  ScopedMutex l(&tables_mutex_);
+  TableMap::iterator it = tables_.find(table_key(keyspace, table));
+  if (it != tables_.end()) {
+    it->second->generation.fetch_add(1, MEMORY_ORDER_RELEASE);
+  }
+}
+
+void ResultCache::invalidate_keyspace(const std::string& keyspace) {
+  ScopedMutex l(&tables_mutex_);
+  for (TableMap::iterator it = tables_.begin(), end = tables_.end(); it != end; ++it) {
+    if (it->second->keyspace == keyspace) {
+      it->second->generation.fetch_add(1, MEMORY_ORDER_RELEASE);
+    }
+  }
+}
+
+void ResultCache::invalidate_all() {
+  epoch_.fetch_add(1, MEMORY_ORDER_RELEASE);
+}
+
+ResultCache::Stats ResultCache::stats() {
+  Stats stats;
+  stats.hits = hits_.load(MEMORY_ORDER_RELAXED);
+  stats.misses = misses_.load(MEMORY_ORDER_RELAXED);
+  stats.evictions = 0;
+  stats.entries = 0;
+  stats.size_bytes = 0;
+  for (size_t i = 0; i < NUM_SHARDS; ++i) {
+    Shard& shard = shards_[i];
+    ScopedMutex l(&shard.mutex);
+    stats.evictions += shard.evictions;
+    stats.entries += shard.index.size();
+    stats.size_bytes += shard.size_bytes;
+  }
+  return stats;
+}
+
+ResultCache::Shard& ResultCache::shard_for(const std::string& key) {
+  return shards_[hash::fnv1a(key.data(), key.size()) % NUM_SHARDS];
+}
+
+ResultCache::Table::Ptr ResultCache::get_table(const std::string& keyspace,
+                                               const std::string& table) {
+  std::string key(table_key(keyspace, table));
+  ScopedMutex l(&tables_mutex_);
+  TableMap::iterator it = tables_.find(key);
+  if (it != tables_.end()) {
+    return it->second;
+  }
+  Table::Ptr result(new Table(keyspace));
+  tables_[key] = result;
+  return result;
+}
+
+bool ResultCache::is_valid(const Entry& entry, uint64_t now_ns) const {
+  return now_ns < entry.expires_at_ns &&
+      entry.epoch == epoch_.load(MEMORY_ORDER_ACQUIRE) &&
+      entry.generation == entry.table->generation.load(MEMORY_ORDER_ACQUIRE);
+}
+
+void ResultCache::put(const Fill::Ptr& fill, const Address& address,
+                      const Response::Ptr& response, uint64_t now_ns) {
+  Entry entry;
+  entry.key = fill->key;
+  entry.response = response;
+  entry.address = address;
+  entry.table = fill->table;
+  entry.generation = fill->generation;
+  entry.epoch = fill->epoch;
+  entry.expires_at_ns = now_ns + settings_.ttl_ns;
+  entry.size = sizeof(Entry) + fill->key.size() + response->buffer_size();
+
+  // Skip results that were invalidated while the read was in flight
+  if (entry.size > max_shard_size_bytes_ || !is_valid(entry, now_ns)) {
+    return;
+  }
+
+  Shard& shard = shard_for(fill->key);
+  ScopedMutex l(&shard.mutex);
+  EntryMap::iterator it = shard.index.find(fill->key);
+  if (it != shard.index.end()) {
+    remove(shard, it);
+  }
+  shard.entries.push_front(entry);
+  shard.index[fill->key] = shard.entries.begin();
+  shard.size_bytes += entry.size;
+
+  while (shard.size_bytes > max_shard_size_bytes_) {
+    EntryMap::iterator lru = shard.index.find(shard.entries.back().key);
+    remove(shard, lru);
+    shard.evictions++;
+  }
+}
+
+void ResultCache::remove(Shard& shard, EntryMap::iterator it) {
+  EntryList::iterator entry = it->second;
+  shard.size_bytes -= entry->size;
+  shard.index.erase(it);
+  shard.entries.erase(entry);
+}
+
+void ResultCache::invalidate_prepared(const ExecuteRequest* request) {
+  const ResultResponse* prepared_result = request->prepared()->result().get();
+  const ResultMetadata::Ptr& metadata(prepared_result->metadata());
+  if (metadata && metadata->column_count() > 0) {
+    const ColumnDefinition& def = metadata->get_column_definition(0);
+    invalidate_table(column_keyspace(prepared_result, def),
+                     column_table(prepared_result, def));
+  } else {
+    invalidate_all();
+  }
+}
+
+} // namespace cass
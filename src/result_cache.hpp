@@ -0,0 +1,179 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_RESULT_CACHE_HPP_INCLUDED__
+#define __CASS_RESULT_CACHE_HPP_INCLUDED__
+
+#include "address.hpp"
+#include "atomic.hpp"
+#include "dense_hash_map.hpp"
+#include "macros.hpp"
+#include "ref_counted.hpp"
+#include "response.hpp"
+#include "scoped_ptr.hpp"
+
+#include <list>
+#include <string>
+#include <uv.h>
+
+namespace cass {
+
+class ExecuteRequest;
+class Request;
+class ResponseFuture;
+
+// A bounded cache of the rows returned by prepared SELECT statements. The
+// entries are keyed by the statement's prepared ID, bound values and paging
+// state (see ExecuteRequest::get_result_key()) and expire after a TTL. The
+// cache is split into shards, each with its own lock and LRU list.
+//
+// Entries are invalidated using generations instead of being removed: each
+// table has a generation that's incremented when the table is written to
+// through the session or its schema changes, and the whole cache has an
+// epoch that's incremented for writes that could affect any table. An
+// entry is only valid if both are unchanged since its read was sent, so a
+// write that completes while a read is in flight keeps the read's result
+// out of the cache.
+class ResultCache {
+public:
+  struct Settings {
+    Settings()
+      : max_size_bytes(0)
+      , ttl_ns(0) { }
+
+    bool is_enabled() const { return max_size_bytes > 0 && ttl_ns > 0; }
+
+    size_t max_size_bytes;
+    uint64_t ttl_ns;
+  };
+
+  class Table : public RefCounted<Table> {
+  public:
+    typedef SharedRefPtr<Table> Ptr;
+
+    Table(const std::string& keyspace)
+      : keyspace(keyspace)
+      , generation(0) { }
+
+    const std::string keyspace;
+    Atomic<uint64_t> generation;
+  };
+
+  // The state of a read captured before it's sent
+  class Fill : public RefCounted<Fill> {
+  public:
+    typedef SharedRefPtr<Fill> Ptr;
+
+    Fill(const std::string& key, const Table::Ptr& table,
+         uint64_t generation, uint64_t epoch)
+      : key(key)
+      , table(table)
+      , generation(generation)
+      , epoch(epoch) { }
+
+    const std::string key;
+    const Table::Ptr table;
+    const uint64_t generation;
+    const uint64_t epoch;
+  };
+
+  struct Stats {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    uint64_t entries;
+    uint64_t size_bytes;
+  };
+
+  ResultCache(const Settings& settings);
+  ~ResultCache();
+
+  // Returns the cached rows for a read (with the key from
+  // ExecuteRequest::get_result_key()) or NULL if there aren't any valid rows.
+  // A miss returns the state needed to add the read's result.
+  Response::Ptr get(const ExecuteRequest* request, const std::string& key,
+                    uint64_t now_ns, Address* address, Fill::Ptr* fill);
+
+  // Adds the rows from a read's future (if it succeeded) unless the read's
+  // tables were invalidated after it was sent.
+  void add(const Fill::Ptr& fill, ResponseFuture* future, uint64_t now_ns);
+
+  // Invalidates the tables a request that isn't a cached read might have
+  // written to. This is called before the request's future is set so that
+  // reads that follow a write never see the rows from before it. The
+  // response is NULL if the request failed.
+  void invalidate(const Request* request, const Response* response);
+
+  void invalidate_table(const std::string& keyspace, const std::string& table);
+  void invalidate_keyspace(const std::string& keyspace);
+  void invalidate_all();
+
+  Stats stats();
+
+private:
+  struct Entry {
+    std::string key;
+    Response::Ptr response;
+    Address address;
+    Table::Ptr table;
+    uint64_t generation;
+    uint64_t epoch;
+    uint64_t expires_at_ns;
+    size_t size;
+  };
+
+  typedef std::list<Entry> EntryList;
+  typedef DenseHashMap<std::string, EntryList::iterator> EntryMap;
+
+  struct Shard {
+    Shard();
+    ~Shard();
+
+    uv_mutex_t mutex;
+    EntryList entries; // In LRU order (most recently used first)
+    EntryMap index;
+    size_t size_bytes;
+    uint64_t evictions;
+  };
+
+  typedef DenseHashMap<std::string, Table::Ptr> TableMap;
+
+  Shard& shard_for(const std::string& key);
+  Table::Ptr get_table(const std::string& keyspace, const std::string& table);
+  bool is_valid(const Entry& entry, uint64_t now_ns) const;
+  void put(const Fill::Ptr& fill, const Address& address,
+           const Response::Ptr& response, uint64_t now_ns);
+  void remove(Shard& shard, EntryMap::iterator it);
+  void invalidate_prepared(const ExecuteRequest* request);
+
+private:
+  const Settings settings_;
+  const size_t max_shard_size_bytes_;
+  ScopedPtr<Shard[]> shards_;
+  Atomic<uint64_t> epoch_;
+  Atomic<uint64_t> hits_;
+  Atomic<uint64_t> misses_;
+
+  uv_mutex_t tables_mutex_;
+  TableMap tables_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ResultCache);
+};
+
+} // namespace cass
+
+#endif
@@ -60,7 +60,7 @@ Host::Ptr RoundRobinPolicy::RoundRobinQueryPlan::compute_next() {
   while (remaining_ > 0) {
     --remaining_;
     const Host::Ptr& host((*hosts_)[index_++ % hosts_->size()]);
-    if (host->is_up()) {
+    if (host->is_up() && host->allow_request()) {
       return host;
     }
   }
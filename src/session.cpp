@@ -30,6 +30,8 @@
 #include "timer.hpp"
 #include "external.hpp"
 
+#include <algorithm>
+
 extern "C" {
 
 CassSession* cass_session_new() {
@@ -42,7 +44,15 @@ void cass_session_free(CassSession* session) {
   // if the session is already closed.
   cass::SharedRefPtr<cass::Future> future(new cass::SessionFuture());
   session->close_async(future);
-  future->wait();
+  if (session->is_external()) {
+    // Nothing else is going to run the loop so it's driven here until the
+    // session is fully closed.
+    while (!future->ready()) {
+      session->run_event_loop(true);
+    }
+  } else {
+    future->wait();
+  }
 
   delete session->from();
 }
@@ -146,6 +156,112 @@ void  cass_session_get_metrics(const CassSession* session,
   metrics->errors.request_timeouts = internal_metrics->request_timeouts.sum();
 }
 
+void cass_session_get_ssl_metrics(const CassSession* session,
+                                  CassSslMetrics* metrics) {
+  const cass::Metrics* internal_metrics = session->metrics();
+
+  metrics->full_handshakes = internal_metrics->ssl_full_handshakes.sum();
+  metrics->resumed_handshakes = internal_metrics->ssl_resumed_handshakes.sum();
+}
+
+void cass_session_get_speculative_execution_metrics(const CassSession* session,
+                                                    CassSpeculativeExecutionMetrics* metrics) {
+  const cass::Metrics* internal_metrics = session->metrics();
+
+  metrics->executions = internal_metrics->speculative_executions.sum();
+  metrics->dropped_executions = internal_metrics->dropped_speculative_executions.sum();
+  metrics->wasted_responses = internal_metrics->wasted_responses.sum();
+  metrics->wasted_bytes = internal_metrics->wasted_response_bytes.sum();
+}
+
+void cass_session_get_request_priority_metrics(const CassSession* session,
+                                               CassRequestPriority priority,
+                                               CassRequestPriorityMetrics* metrics) {
+  const cass::Metrics* internal_metrics = session->metrics();
+
+  cass::Metrics::Histogram::Snapshot snapshot;
+  internal_metrics->request_latencies_by_priority(priority).get_snapshot(&snapshot);
+
+  metrics->min = snapshot.min;
+  metrics->max = snapshot.max;
+  metrics->mean = snapshot.mean;
+  metrics->stddev = snapshot.stddev;
+  metrics->median = snapshot.median;
+  metrics->percentile_75th = snapshot.percentile_75th;
+  metrics->percentile_95th = snapshot.percentile_95th;
+  metrics->percentile_98th = snapshot.percentile_98th;
+  metrics->percentile_99th = snapshot.percentile_99th;
+  metrics->percentile_999th = snapshot.percentile_999th;
+}
+
+void cass_session_get_rate_limiter_metrics(const CassSession* session,
+                                           CassRateLimiterMetrics* metrics) {
+  const cass::Metrics* internal_metrics = session->metrics();
+
+  metrics->delayed_requests = internal_metrics->throttled_requests.sum();
+  metrics->delayed_time = internal_metrics->throttled_time_us.sum();
+  metrics->rejected_requests = internal_metrics->rate_limited_requests.sum();
+  metrics->skipped_hosts = internal_metrics->rate_limited_hosts.sum();
+}
+
+CassError cass_session_get_host_concurrency_metrics(const CassSession* session,
+                                                    const char* host,
+                                                    CassHostConcurrencyMetrics* output) {
+  cass::Address address;
+  if (!cass::Address::from_string(host, session->config().port(), &address)) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cass::Host::Ptr internal_host(session->get_host(address));
+  if (!internal_host) {
+    return CASS_ERROR_LIB_HOST_RESOLUTION;
+  }
+  output->limit = internal_host->concurrency_limit();
+  output->inflight_requests = std::max(internal_host->inflight_requests(),
+                                       static_cast<int64_t>(0));
+  return CASS_OK;
+}
+
+void cass_session_get_result_cache_metrics(const CassSession* session,
+                                           CassResultCacheMetrics* output) {
+  memset(output, 0, sizeof(CassResultCacheMetrics));
+  cass::ResultCache* result_cache = session->result_cache();
+  if (result_cache == NULL) return;
+
+  cass::ResultCache::Stats stats(result_cache->stats());
+  output->hits = stats.hits;
+  output->misses = stats.misses;
+  output->evictions = stats.evictions;
+  output->entries = stats.entries;
+  output->size_bytes = stats.size_bytes;
+}
+
+int cass_session_event_loop_fd(CassSession* session) {
+  if (!session->is_external()) return -1;
+  return uv_backend_fd(session->loop());
+}
+
+int cass_session_event_loop_timeout(CassSession* session) {
+  if (!session->is_external()) return -1;
+  return uv_backend_timeout(session->loop());
+}
+
+CassError cass_session_bind_thread(CassSession* session,
+                                   unsigned shard) {
+  if (!session->bind_thread(shard)) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  return CASS_OK;
+}
+
+CassError cass_session_event_loop_run(CassSession* session,
+                                      cass_bool_t wait) {
+  if (!session->is_external()) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  session->run_event_loop(wait == cass_true);
+  return CASS_OK;
+}
+
 } // extern "C"
 
 namespace cass {
@@ -156,7 +272,12 @@ Session::Session()
     , current_host_mark_(true)
     , pending_pool_count_(0)
     , pending_workers_count_(0)
-    , current_io_worker_(0) {
+    , current_io_worker_(0)
+    , is_sharded_(false)
+    , next_shard_(0) {
+#if UV_VERSION_MAJOR >= 1
+  uv_key_create(&shard_key_);
+#endif
   uv_mutex_init(&state_mutex_);
   uv_mutex_init(&hosts_mutex_);
   uv_mutex_init(&keyspace_mutex_);
@@ -165,6 +286,9 @@ Session::Session()
 
 Session::~Session() {
   join();
+#if UV_VERSION_MAJOR >= 1
+  uv_key_delete(&shard_key_);
+#endif
   uv_mutex_destroy(&state_mutex_);
   uv_mutex_destroy(&hosts_mutex_);
   uv_mutex_destroy(&keyspace_mutex_);
@@ -175,6 +299,13 @@ void Session::clear(const Config& config) {
   config_ = config.new_instance();
   random_.reset();
   metrics_.reset(new Metrics(config_.thread_count_io() + 1));
+  for (int i = 0; i < CASS_REQUEST_PRIORITY_COUNT; ++i) {
+    const RateLimiter::Settings& settings
+        = config_.rate_limit_settings(static_cast<CassRequestPriority>(i));
+    rate_limiters_[i].reset(settings.is_enabled() ? new RateLimiter(settings) : NULL);
+  }
+  result_cache_.reset(config_.result_cache_settings().is_enabled()
+                      ? new ResultCache(config_.result_cache_settings()) : NULL);
   connect_future_.reset();
   close_future_.reset();
   {
@@ -198,14 +329,35 @@ void Session::clear(const Config& config) {
 }
 
 int Session::init() {
-  int rc = EventThread<SessionEvent>::init(config_.queue_size_event());
+  int rc = EventThread<SessionEvent>::init(config_.queue_size_event(),
+                                           config_.external_event_loop(),
+                                           config_.event_loop());
   if (rc != 0) return rc;
   request_queue_.reset(
       new AsyncQueue<MPMCQueue<RequestHandler*> >(config_.queue_size_io()));
   rc = request_queue_->init(loop(), this, &Session::on_execute);
   if (rc != 0) return rc;
 
-  for (unsigned int i = 0; i < config_.thread_count_io(); ++i) {
+  // All the work happens on the application's thread when using an external
+  // loop so additional IO workers wouldn't add any parallelism.
+  unsigned thread_count_io = is_external() ? 1 : config_.thread_count_io();
+
+  is_sharded_ = false;
+  if (config_.session_sharding() && !is_external()) {
+#if UV_VERSION_MAJOR >= 1
+    if (config_.token_aware_routing()) {
+      // The token map is updated in place on the session thread
+      LOG_WARN("Session sharding is not supported with token aware routing "
+               "(enabled by default); requests will be routed through the "
+               "session thread");
+    } else {
+      is_sharded_ = true;
+    }
+#else
+    LOG_WARN("Session sharding requires libuv 1.x");
+#endif
+  }
+  for (unsigned int i = 0; i < thread_count_io; ++i) {
     IOWorker::Ptr io_worker(new IOWorker(this));
     int rc = io_worker->init();
     if (rc != 0) return rc;
@@ -215,6 +367,20 @@ int Session::init() {
   return rc;
 }
 
+bool Session::run_event_loop(bool wait) {
+  return uv_run(loop(), wait ? UV_RUN_ONCE : UV_RUN_NOWAIT) != 0;
+}
+
+bool Session::bind_thread(unsigned shard) {
+#if UV_VERSION_MAJOR >= 1
+  // The shard is stored off by one because NULL means unbound
+  uv_key_set(&shard_key_, reinterpret_cast<void*>(static_cast<size_t>(shard) + 1));
+  return true;
+#else
+  return false;
+#endif
+}
+
 std::string Session::keyspace() const {
   ScopedMutex l(&keyspace_mutex_);
   return keyspace_;
@@ -240,10 +406,10 @@ void Session::broadcast_keyspace_change(const std::string& keyspace,
   set_keyspace(keyspace);
 }
 
-Host::Ptr Session::get_host(const Address& address) {
+Host::Ptr Session::get_host(const Address& address) const {
   // Lock hosts. This can be called on a non-session thread.
   ScopedMutex l(&hosts_mutex_);
-  HostMap::iterator it = hosts_.find(address);
+  HostMap::const_iterator it = hosts_.find(address);
   if (it == hosts_.end()) {
     return Host::Ptr();
   }
@@ -253,6 +419,9 @@ Host::Ptr Session::get_host(const Address& address) {
 Host::Ptr Session::add_host(const Address& address) {
   LOG_DEBUG("Adding new host: %s", address.to_string().c_str());
   Host::Ptr host(new Host(address, !current_host_mark_));
+  host->enable_rate_limiting(config_.host_rate_limit_settings());
+  host->enable_concurrency_limiting(config_.concurrency_limit_settings());
+  host->enable_circuit_breaker(config_.circuit_breaker_settings());
   { // Lock hosts
     ScopedMutex l(&hosts_mutex_);
     hosts_[address] = host;
@@ -547,8 +716,12 @@ void Session::close_handles() {
 }
 
 void Session::on_run() {
-  LOG_DEBUG("Creating %u IO worker threads",
-            static_cast<unsigned int>(io_workers_.size()));
+  if (is_external()) {
+    LOG_DEBUG("Using an external event loop for the session and its IO worker");
+  } else {
+    LOG_DEBUG("Creating %u IO worker threads",
+              static_cast<unsigned int>(io_workers_.size()));
+  }
 
   for (IOWorkerVec::iterator it = io_workers_.begin(), end = io_workers_.end();
        it != end; ++it) {
@@ -674,6 +847,11 @@ void Session::execute(const RequestHandler::Ptr& request_handler) {
     return;
   }
 
+  if (is_sharded_) {
+    execute_sharded(request_handler);
+    return;
+  }
+
   request_handler->inc_ref(); // Queue reference
   if (!request_queue_->enqueue(request_handler.get())) {
     request_handler->dec_ref();
@@ -682,6 +860,39 @@ void Session::execute(const RequestHandler::Ptr& request_handler) {
   }
 }
 
+void Session::execute_sharded(const RequestHandler::Ptr& request_handler) {
+#if UV_VERSION_MAJOR >= 1
+  // Threads that haven't been explicitly bound are assigned an IO worker
+  // on their first request.
+  size_t shard = reinterpret_cast<size_t>(uv_key_get(&shard_key_));
+  if (shard == 0) {
+    shard = next_shard_.fetch_add(1) + 1;
+    uv_key_set(&shard_key_, reinterpret_cast<void*>(shard));
+  }
+  const IOWorker::Ptr& io_worker = io_workers_[(shard - 1) % io_workers_.size()];
+  if (!io_worker->execute_sharded(request_handler)) {
+    request_handler->set_error(CASS_ERROR_LIB_REQUEST_QUEUE_FULL,
+                               "The request queue has reached capacity");
+  }
+#endif
+}
+
+void Session::notify_shards_up(const Host::Ptr& host) {
+  if (!is_sharded_) return;
+  for (IOWorkerVec::iterator it = io_workers_.begin(),
+       end = io_workers_.end(); it != end; ++it) {
+    (*it)->notify_host_up_async(host);
+  }
+}
+
+void Session::notify_shards_down(const Host::Ptr& host) {
+  if (!is_sharded_) return;
+  for (IOWorkerVec::iterator it = io_workers_.begin(),
+       end = io_workers_.end(); it != end; ++it) {
+    (*it)->notify_host_down_async(host);
+  }
+}
+
 #if UV_VERSION_MAJOR >= 1
 void Session::on_resolve_name(MultiResolver<Session*>::NameResolver* resolver) {
   Session* session = resolver->data()->data();
@@ -716,6 +927,13 @@ void Session::on_control_connection_ready() {
   for (IOWorkerVec::iterator it = io_workers_.begin(),
        end = io_workers_.end(); it != end; ++it) {
     (*it)->set_protocol_version(control_connection_.protocol_version());
+    if (is_sharded_) {
+      // This is queued before the IO worker's pools are added so the policy
+      // is in place before any requests can be routed to the shard.
+      LoadBalancingPolicy::Ptr policy(config().load_balancing_policy()->new_instance());
+      policy->init(control_connection_.connected_host(), hosts_, random_.get());
+      (*it)->set_load_balancing_policy_async(policy);
+    }
   }
   for (HostMap::iterator it = hosts_.begin(), hosts_end = hosts_.end();
        it != hosts_end; ++it) {
@@ -802,6 +1020,7 @@ void Session::internal_on_add(Host::Ptr host, bool is_initial_connection) {
     pending_pool_count_ += io_workers_.size();
   } else {
     config().load_balancing_policy()->on_add(host);
+    notify_shards_up(host);
   }
 
   for (IOWorkerVec::iterator it = io_workers_.begin(),
@@ -814,6 +1033,7 @@ void Session::on_remove(Host::Ptr host) {
   host->set_down();
 
   config().load_balancing_policy()->on_remove(host);
+  notify_shards_down(host);
   { // Lock hosts
     ScopedMutex l(&hosts_mutex_);
     hosts_.erase(host->address());
@@ -841,6 +1061,7 @@ void Session::internal_on_up(Host::Ptr host) {
   }
 
   config().load_balancing_policy()->on_up(host);
+  notify_shards_up(host);
 
   for (IOWorkerVec::iterator it = io_workers_.begin(),
        end = io_workers_.end(); it != end; ++it) {
@@ -858,6 +1079,7 @@ void Session::internal_on_up(Host::Ptr host) {
 void Session::on_down(Host::Ptr host) {
   host->set_down();
   config().load_balancing_policy()->on_down(host);
+  notify_shards_down(host);
 
   bool cancel_reconnect = false;
   if (config().load_balancing_policy()->distance(host) == CASS_HOST_DISTANCE_IGNORE) {
@@ -888,7 +1110,39 @@ Future::Ptr Session::execute(const Request::ConstPtr& request,
                              const Address* preferred_address) {
   ResponseFuture::Ptr future(new ResponseFuture());
 
+  std::string key;
+  bool is_read = (result_cache_ || config_.coalesce_reads()) &&
+                 preferred_address == NULL &&
+                 request->opcode() == CQL_OPCODE_EXECUTE &&
+                 static_cast<const ExecuteRequest*>(request.get())->get_result_key(&key);
+
+  // Reads are served from the result cache when possible
+  ResultCache::Fill::Ptr result_cache_fill;
+  if (result_cache_ && is_read) {
+    Address address;
+    Response::Ptr response(
+          result_cache_->get(static_cast<const ExecuteRequest*>(request.get()),
+                             key, uv_hrtime(), &address, &result_cache_fill));
+    if (response) {
+      future->set_response(address, response);
+      return future;
+    }
+  }
+
+  // Identical idempotent reads that are already in flight are shared
+  RequestCoalescer::Call::Ptr coalesced_call;
+  if (config_.coalesce_reads() && is_read && request->is_idempotent()) {
+    coalesced_call = request_coalescer_.join(key, future.get());
+    if (!coalesced_call) {
+      return future;
+    }
+  }
+
   RequestHandler::Ptr request_handler(new RequestHandler(request, future, this));
+  request_handler->set_coalesced_call(coalesced_call);
+  if (result_cache_) {
+    request_handler->set_result_cache(result_cache_.get(), result_cache_fill);
+  }
 
   if (preferred_address) {
     request_handler->set_preferred_address(*preferred_address);
@@ -899,6 +1153,39 @@ Future::Ptr Session::execute(const Request::ConstPtr& request,
   return future;
 }
 
+bool Session::throttle(RequestHandler* request_handler) {
+  const ScopedPtr<RateLimiter>& rate_limiter
+      = rate_limiters_[request_handler->request()->priority()];
+  if (!rate_limiter) return true;
+
+  // The request's arrival is when it was executed by the application
+  uint64_t now = request_handler->start_time_ns();
+
+  uint64_t max_delay_ms = config_.rate_limit_max_delay_ms();
+  uint64_t max_wait_ns = max_delay_ms < CASS_UINT64_MAX / (1000 * 1000)
+                         ? max_delay_ms * 1000 * 1000
+                         : CASS_UINT64_MAX;
+  uint64_t deadline_ns = request_handler->wrapper().deadline_ns();
+  if (deadline_ns != CASS_UINT64_MAX) {
+    max_wait_ns = std::min(max_wait_ns, deadline_ns > now ? deadline_ns - now : 0);
+  }
+
+  uint64_t wait_ns;
+  if (!rate_limiter->acquire(now, max_wait_ns, &wait_ns)) {
+    metrics_->rate_limited_requests.inc();
+    request_handler->set_error(CASS_ERROR_LIB_RATE_LIMITED,
+                               "The request exceeded the session's rate limit");
+    return false;
+  }
+
+  if (wait_ns > 0) {
+    metrics_->throttled_requests.inc();
+    metrics_->throttled_time_us.add(wait_ns / 1000);
+    request_handler->set_throttled_until_ns(now + wait_ns);
+  }
+  return true;
+}
+
 #if UV_VERSION_MAJOR == 0
 void Session::on_execute(uv_async_t* data, int status) {
 #else
@@ -913,6 +1200,19 @@ void Session::on_execute(uv_async_t* data) {
     RequestHandler::Ptr request_handler(temp);
     if (request_handler) {
       request_handler->dec_ref(); // Queue reference
+
+      // Stale requests are dropped instead of adding to an overload
+      if (request_handler->is_expired()) {
+        session->metrics_->pending_request_timeouts.inc();
+        request_handler->set_error(CASS_ERROR_LIB_REQUEST_TIMED_OUT,
+                                   "Request deadline exceeded in the session's queue");
+        continue;
+      }
+
+      if (!session->throttle(request_handler.get())) {
+        continue;
+      }
+
       request_handler->init(session);
 
       bool is_done = false;
@@ -28,10 +28,14 @@
 #include "metadata.hpp"
 #include "metrics.hpp"
 #include "mpmc_queue.hpp"
+#include "periodic_task.hpp"
 #include "prepared.hpp"
 #include "prepare_host_handler.hpp"
 #include "random.hpp"
+#include "rate_limiter.hpp"
 #include "ref_counted.hpp"
+#include "request_coalescer.hpp"
+#include "result_cache.hpp"
 #include "request_handler.hpp"
 #include "resolver.hpp"
 #include "row.hpp"
@@ -85,11 +89,21 @@ public:
 
   const Config& config() const { return config_; }
   Metrics* metrics() const { return metrics_.get(); }
+  ResultCache* result_cache() const { return result_cache_.get(); }
 
   PreparedMetadata::Entry::Vec prepared_metadata_entries() const {
     return prepared_metadata_.copy();
   }
 
+  // Runs a single iteration of the session's loop. This is only used when the
+  // loop is driven by the application (external event loop mode).
+  bool run_event_loop(bool wait);
+
+  // In a sharded session each application thread is bound to a single IO
+  // worker and its requests are handled entirely on that IO worker's thread.
+  bool is_sharded() const { return is_sharded_; }
+  bool bind_thread(unsigned shard);
+
   std::string keyspace() const;
 
 private:
@@ -99,7 +113,7 @@ public:
   void broadcast_keyspace_change(const std::string& keyspace,
                                  const IOWorker* calling_io_worker);
 
-  Host::Ptr get_host(const Address& address);
+  Host::Ptr get_host(const Address& address) const;
 
   bool notify_ready_async();
   bool notify_keyspace_error_async();
@@ -115,6 +129,12 @@ public:
   Future::Ptr execute(const Request::ConstPtr& request,
                       const Address* preferred_address = NULL);
 
+  // Takes a token from the session's rate limiter for the request's priority.
+  // A request that has to wait for its token is delayed when it's started.
+  // It returns false, after failing the request, if the wait would be longer
+  // than the maximum delay or the request's deadline.
+  bool throttle(RequestHandler* request_handler);
+
   const PreparedMetadata& prepared_metadata() const { return prepared_metadata_; }
 
   const Metadata& metadata() const { return metadata_; }
@@ -145,6 +165,10 @@ private:
   void notify_closed();
 
   void execute(const RequestHandler::Ptr& request_handler);
+  void execute_sharded(const RequestHandler::Ptr& request_handler);
+
+  void notify_shards_up(const Host::Ptr& host);
+  void notify_shards_down(const Host::Ptr& host);
 
   virtual void on_run();
   virtual void on_after_run();
@@ -229,6 +253,9 @@ private:
 
   Config config_;
   ScopedPtr<Metrics> metrics_;
+  ScopedPtr<RateLimiter> rate_limiters_[CASS_REQUEST_PRIORITY_COUNT];
+  RequestCoalescer request_coalescer_;
+  ScopedPtr<ResultCache> result_cache_;
   CassError connect_error_code_;
   std::string connect_error_message_;
   Future::Ptr connect_future_;
@@ -239,7 +266,7 @@ private:
   ResponseFuture::Ptr refresh_metadata_future_;
 
   HostMap hosts_;
-  uv_mutex_t hosts_mutex_;
+  mutable uv_mutex_t hosts_mutex_;
 
   IOWorkerVec io_workers_;
   ScopedPtr<AsyncQueue<MPMCQueue<RequestHandler*> > > request_queue_;
@@ -254,6 +281,12 @@ private:
   int pending_workers_count_;
   int current_io_worker_;
 
+  bool is_sharded_;
+  Atomic<unsigned> next_shard_;
+#if UV_VERSION_MAJOR >= 1
+  uv_key_t shard_key_;
+#endif
+
   std::string keyspace_;
   mutable uv_mutex_t keyspace_mutex_;
 };
@@ -0,0 +1,142 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "speculative_execution.hpp"
+
+#include "logger.hpp"
+#include "scoped_lock.hpp"
+#include "third_party/hdr_histogram/hdr_histogram.hpp"
+
+#include <stdlib.h>
+
+// Latencies are recorded in microseconds
+#define HIGHEST_TRACKABLE_LATENCY_US (3600LL * 1000LL * 1000LL)
+
+namespace cass {
+
+PercentileSpeculativeExecutionPolicy::HostLatency::HostLatency()
+  : histogram_(NULL)
+  , interval_start_ns_(uv_hrtime())
+  , delay_ms_(-1) {
+  uv_mutex_init(&mutex_);
+  if (hdr_init(1LL, HIGHEST_TRACKABLE_LATENCY_US, 3, &histogram_) != 0) {
+    // The host's delay stays disabled so its requests are never hedged
+    LOG_ERROR("Unable to allocate a latency histogram; "
+              "speculative executions are disabled for a host");
+    histogram_ = NULL;
+  }
+}
+
+PercentileSpeculativeExecutionPolicy::HostLatency::~HostLatency() {
+  free(histogram_);
+  uv_mutex_destroy(&mutex_);
+}
+
+void PercentileSpeculativeExecutionPolicy::HostLatency::record(uint64_t latency_ns,
+                                                               double percentile,
+                                                               uint64_t interval_ns) {
+  if (histogram_ == NULL) return;
+  uint64_t now = uv_hrtime();
+  ScopedMutex l(&mutex_);
+  hdr_record_value(histogram_, static_cast<int64_t>(latency_ns / 1000));
+  if (now - interval_start_ns_ >= interval_ns) {
+    int64_t delay_ms = -1;
+    if (histogram_->total_count >= MIN_RECORDED_VALUES) {
+      // Round up so the delay is never shorter than the percentile
+      delay_ms = (hdr_value_at_percentile(histogram_, percentile) + 999) / 1000;
+    }
+    delay_ms_.store(delay_ms, MEMORY_ORDER_RELAXED);
+    hdr_reset(histogram_);
+    interval_start_ns_ = now;
+  }
+}
+
+PercentileSpeculativeExecutionPolicy::PercentileSpeculativeExecutionPolicy(double percentile,
+                                                                           int max_speculative_executions,
+                                                                           double max_hedge_ratio,
+                                                                           uint64_t interval_ns)
+  : percentile_(percentile)
+  , max_speculative_executions_(max_speculative_executions)
+  , max_hedge_ratio_(max_hedge_ratio)
+  , interval_ns_(interval_ns)
+  , budget_per_request_(static_cast<int64_t>(max_hedge_ratio * BUDGET_UNIT))
+  , budget_(0) {
+  uv_rwlock_init(&rwlock_);
+}
+
+PercentileSpeculativeExecutionPolicy::~PercentileSpeculativeExecutionPolicy() {
+  for (HostLatencyMap::iterator i = hosts_.begin(),
+       end = hosts_.end(); i != end; ++i) {
+    delete i->second;
+  }
+  uv_rwlock_destroy(&rwlock_);
+}
+
+SpeculativeExecutionPlan* PercentileSpeculativeExecutionPolicy::new_plan(const std::string& keyspace,
+                                                                         const Request* request) {
+  earn_budget();
+  return new PercentileSpeculativeExecutionPlan(this);
+}
+
+int64_t PercentileSpeculativeExecutionPolicy::delay_ms(const Address& address) const {
+  HostLatency* host = find(address);
+  return host != NULL ? host->delay_ms() : -1;
+}
+
+void PercentileSpeculativeExecutionPolicy::record_latency(const Address& address,
+                                                          uint64_t latency_ns) {
+  HostLatency* host = find(address);
+  if (host == NULL) {
+    ScopedWriteLock l(&rwlock_);
+    HostLatencyMap::iterator it = hosts_.find(address);
+    if (it == hosts_.end()) {
+      it = hosts_.insert(HostLatencyMap::value_type(address, new HostLatency())).first;
+    }
+    host = it->second;
+  }
+  host->record(latency_ns, percentile_, interval_ns_);
+}
+
+bool PercentileSpeculativeExecutionPolicy::acquire_execution() {
+  int64_t budget = budget_.load();
+  while (budget >= BUDGET_UNIT) {
+    if (budget_.compare_exchange_weak(budget, budget - BUDGET_UNIT)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+PercentileSpeculativeExecutionPolicy::HostLatency*
+PercentileSpeculativeExecutionPolicy::find(const Address& address) const {
+  ScopedReadLock l(&rwlock_);
+  HostLatencyMap::const_iterator it = hosts_.find(address);
+  return it != hosts_.end() ? it->second : NULL;
+}
+
+void PercentileSpeculativeExecutionPolicy::earn_budget() {
+  const int64_t max_budget = MAX_BUDGET_BURST * BUDGET_UNIT;
+  int64_t budget = budget_.load();
+  while (budget < max_budget) {
+    int64_t new_budget = budget + budget_per_request_;
+    if (new_budget > max_budget) new_budget = max_budget;
+    if (budget_.compare_exchange_weak(budget, new_budget)) {
+      break;
+    }
+  }
+}
+
+} // namespace cass
@@ -17,21 +17,36 @@
 #ifndef __CASS_SPECULATIVE_EXECUTION_HPP_INCLUDED__
 #define __CASS_SPECULATIVE_EXECUTION_HPP_INCLUDED__
 
+#include "address.hpp"
+#include "atomic.hpp"
 #include "host.hpp"
+#include "macros.hpp"
+#include "object_pool.hpp"
 #include "ref_counted.hpp"
 
+#include <map>
 #include <string>
 #include <stdint.h>
+#include <uv.h>
+
+struct hdr_histogram;
 
 namespace cass {
 
 class Request;
 
-class SpeculativeExecutionPlan {
+class SpeculativeExecutionPlan : public Pooled {
 public:
   virtual ~SpeculativeExecutionPlan() { }
 
   virtual int64_t next_execution(const Host::Ptr& current_host) = 0;
+
+  // Called when a scheduled speculative execution is about to be sent.
+  // Returning false drops the execution.
+  virtual bool acquire_execution() { return true; }
+
+  // Called with the latency of each successful execution
+  virtual void record_latency(const Host::Ptr& host, uint64_t latency_ns) { }
 };
 
 class SpeculativeExecutionPolicy : public RefCounted<SpeculativeExecutionPolicy> {
@@ -94,6 +109,106 @@ public:
   const int max_speculative_executions_;
 };
 
+// Tracks a latency distribution per host and schedules speculative
+// executions once the current host's latency is past a percentile of its
+// recent latencies. Latencies are recorded in fixed intervals and a host's
+// delay is recomputed from the previous interval, so hosts without enough
+// recent samples aren't speculatively executed against. The extra load is
+// bounded by a budget that's shared by all requests: every request earns
+// `max_hedge_ratio` of a speculative execution and every speculative
+// execution sent spends one.
+class PercentileSpeculativeExecutionPolicy : public SpeculativeExecutionPolicy {
+public:
+  typedef SharedRefPtr<PercentileSpeculativeExecutionPolicy> Ptr;
+
+  static const uint64_t INTERVAL_NS = 5LL * 1000LL * 1000LL * 1000LL; // 5 seconds
+  static const int64_t MIN_RECORDED_VALUES = 100;
+  static const int64_t BUDGET_UNIT = 10000;
+  static const int64_t MAX_BUDGET_BURST = 100;
+
+  PercentileSpeculativeExecutionPolicy(double percentile,
+                                       int max_speculative_executions,
+                                       double max_hedge_ratio,
+                                       uint64_t interval_ns = INTERVAL_NS);
+  ~PercentileSpeculativeExecutionPolicy();
+
+  virtual SpeculativeExecutionPlan* new_plan(const std::string& keyspace,
+                                             const Request* request);
+
+  virtual SpeculativeExecutionPolicy* new_instance()  { return this; }
+
+  // Returns the delay (in milliseconds) before a speculative execution
+  // is sent or -1 if there aren't enough samples for the host.
+  int64_t delay_ms(const Address& address) const;
+
+  void record_latency(const Address& address, uint64_t latency_ns);
+
+  bool acquire_execution();
+
+  const double percentile_;
+  const int max_speculative_executions_;
+  const double max_hedge_ratio_;
+  const uint64_t interval_ns_;
+
+private:
+  class HostLatency {
+  public:
+    HostLatency();
+    ~HostLatency();
+
+    int64_t delay_ms() const { return delay_ms_.load(MEMORY_ORDER_RELAXED); }
+
+    void record(uint64_t latency_ns, double percentile, uint64_t interval_ns);
+
+  private:
+    uv_mutex_t mutex_;
+    hdr_histogram* histogram_;
+    uint64_t interval_start_ns_;
+    Atomic<int64_t> delay_ms_;
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(HostLatency);
+  };
+
+  typedef std::map<Address, HostLatency*> HostLatencyMap;
+
+  HostLatency* find(const Address& address) const;
+  void earn_budget();
+
+private:
+  HostLatencyMap hosts_;
+  mutable uv_rwlock_t rwlock_;
+  const int64_t budget_per_request_;
+  Atomic<int64_t> budget_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(PercentileSpeculativeExecutionPolicy);
+};
+
+class PercentileSpeculativeExecutionPlan : public SpeculativeExecutionPlan {
+public:
+  PercentileSpeculativeExecutionPlan(PercentileSpeculativeExecutionPolicy* policy)
+    : policy_(policy)
+    , count_(policy->max_speculative_executions_) { }
+
+  virtual int64_t next_execution(const Host::Ptr& current_host) {
+    if (!current_host || --count_ < 0) return -1;
+    return policy_->delay_ms(current_host->address());
+  }
+
+  virtual bool acquire_execution() {
+    return policy_->acquire_execution();
+  }
+
+  virtual void record_latency(const Host::Ptr& host, uint64_t latency_ns) {
+    policy_->record_latency(host->address(), latency_ns);
+  }
+
+private:
+  PercentileSpeculativeExecutionPolicy::Ptr policy_;
+  int count_;
+};
+
 } // namespace cass
 
 #endif
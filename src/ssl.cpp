@@ -50,6 +50,10 @@ void cass_ssl_set_verify_flags(CassSsl* ssl, int flags) {
   ssl->set_verify_flags(flags);
 }
 
+CassError cass_ssl_set_kernel_offload(CassSsl* ssl, cass_bool_t enabled) {
+  return ssl->set_kernel_offload(enabled == cass_true);
+}
+
 CassError cass_ssl_set_cert(CassSsl* ssl, const char* cert) {
   return cass_ssl_set_cert_n(ssl, cert, SAFE_STRLEN(cert));
 }
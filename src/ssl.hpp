@@ -35,6 +35,8 @@ public:
              int flags)
     : host_(host)
     , verify_flags_(flags)
+    , kernel_offload_tx_(false)
+    , kernel_offload_rx_(false)
     , error_code_(CASS_OK) {}
 
   virtual ~SslSession() {}
@@ -58,12 +60,27 @@ public:
   virtual int encrypt(const char* data, size_t data_size) = 0;
   virtual int decrypt(char* data, size_t data_size) = 0;
 
+  // Hands the record layer of an established session over to the kernel
+  // (kTLS). Returns false if the session continues to use the userspace
+  // record layer (not enabled, not supported or not possible).
+  virtual bool enable_kernel_offload(int fd) { return false; }
+
+  // The handshake resumed a previous session instead of negotiating a new one
+  virtual bool is_resumed() const { return false; }
+
+  // Encrypted writes are plain socket writes
+  bool is_kernel_offload_tx() const { return kernel_offload_tx_; }
+  // Encrypted reads are plain socket reads
+  bool is_kernel_offload_rx() const { return kernel_offload_rx_; }
+
   rb::RingBuffer& incoming() { return incoming_; }
   rb::RingBuffer& outgoing() { return outgoing_; }
 
 protected:
   Host::ConstPtr host_;
   int verify_flags_;
+  bool kernel_offload_tx_;
+  bool kernel_offload_rx_;
   rb::RingBuffer incoming_;
   rb::RingBuffer outgoing_;
   CassError error_code_;
@@ -84,6 +101,7 @@ public:
   }
 
   virtual SslSession* create_session(const Host::ConstPtr& host) = 0;
+  virtual CassError set_kernel_offload(bool enabled) = 0;
   virtual CassError add_trusted_cert(const char* cert, size_t cert_length) = 0;
   virtual CassError set_cert(const char* cert, size_t cert_length) = 0;
   virtual CassError set_private_key(const char* key,
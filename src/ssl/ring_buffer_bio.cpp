@@ -50,6 +50,9 @@
 #define BIO_set_init(b, i) ((b)->init = i)
 #endif
 
+// This control isn't part of OpenSSL's public headers (see include/internal/bio.h)
+#define CASS_BIO_CTRL_SET_KTLS 72
+
 namespace cass {
 namespace rb {
 
@@ -204,6 +207,14 @@ long RingBufferBio::ctrl(BIO* bio, int cmd, long num, void* ptr) {
     case BIO_CTRL_FLUSH:
       ret = 1;
       break;
+    case CASS_BIO_CTRL_SET_KTLS:
+      // Only the keys are captured, the ring buffer can't be offloaded. They
+      // are installed on the socket once the handshake has completed.
+      if (from_bio(bio)->ktls_callback != NULL && ptr != NULL) {
+        from_bio(bio)->ktls_callback(from_bio(bio)->ktls_data, num, ptr);
+      }
+      ret = 0;
+      break;
     case BIO_CTRL_PUSH:
     case BIO_CTRL_POP:
     default:
@@ -61,10 +61,18 @@ namespace rb {
 struct RingBufferState {
   RingBufferState(RingBuffer* ring_buffer)
     : ring_buffer(ring_buffer)
-    , ret(-1) { }
+    , ret(-1)
+    , ktls_callback(NULL)
+    , ktls_data(NULL) { }
+
+  typedef void (*KtlsCallback)(void* data, int is_tx, const void* crypto_info);
 
   RingBuffer* ring_buffer;
   int ret; // Used to keep track of the EOF return value
+  // Called with the kernel crypto parameters when OpenSSL offers to hand the
+  // record layer to kernel TLS (OpenSSL 3.0+ with SSL_OP_ENABLE_KTLS set)
+  KtlsCallback ktls_callback;
+  void* ktls_data;
 };
 
 class RingBufferBio {
@@ -28,6 +28,10 @@ SslSession* cass::NoSslContext::create_session(const Host::ConstPtr& host) {
   return new NoSslSession(host);
 }
 
+CassError cass::NoSslContext::set_kernel_offload(bool enabled) {
+  return CASS_ERROR_LIB_NOT_IMPLEMENTED;
+}
+
 CassError cass::NoSslContext::add_trusted_cert(const char* cert,
                                                size_t cert_length) {
   return CASS_ERROR_LIB_NOT_IMPLEMENTED;
@@ -36,6 +36,8 @@ public:
 
   virtual SslSession* create_session(const Host::ConstPtr& host);
 
+  virtual CassError set_kernel_offload(bool enabled);
+
   virtual CassError add_trusted_cert(const char* cert, size_t cert_length);
   virtual CassError set_cert(const char* cert, size_t cert_length);
   virtual CassError set_private_key(const char* key,
@@ -17,6 +17,7 @@
 #include "ssl.hpp"
 
 #include "logger.hpp"
+#include "scoped_lock.hpp"
 #include "utils.hpp"
 
 #include "third_party/curl/hostcheck.hpp"
@@ -26,10 +27,26 @@
 #include <openssl/x509v3.h>
 #include <string.h>
 
+#ifdef CASS_USE_KTLS
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#endif
+
 #define DEBUG_SSL 0
 
 #if OPENSSL_VERSION_NUMBER < 0x10100000L || defined(LIBRESSL_VERSION_NUMBER)
 #define ASN1_STRING_get0_data ASN1_STRING_data
+#define SSL_SESSION_up_ref(s) CRYPTO_add(&(s)->references, 1, CRYPTO_LOCK_SSL_SESSION)
 #else
 #define SSL_F_SSL_CTX_USE_CERTIFICATE_CHAIN_FILE SSL_F_USE_CERTIFICATE_CHAIN_FILE
 #endif
@@ -421,22 +438,60 @@ private:
 
 OpenSslSession::OpenSslSession(const Host::ConstPtr& host,
                                int flags,
-                               SSL_CTX* ssl_ctx)
+                               bool kernel_offload,
+                               OpenSslContext* context)
   : SslSession(host, flags)
-  , ssl_(SSL_new(ssl_ctx))
+  , context_(context)
+  , ssl_(SSL_new(context->ssl_ctx_))
   , incoming_state_(&incoming_)
   , outgoing_state_(&outgoing_)
   , incoming_bio_(rb::RingBufferBio::create(&incoming_state_))
   , outgoing_bio_(rb::RingBufferBio::create(&outgoing_state_)) {
   SSL_set_bio(ssl_, incoming_bio_, outgoing_bio_);
-  SSL_CTX_set_verify(ssl_ctx, SSL_VERIFY_NONE, ssl_no_verify_callback);
+  // Read as many records as are available from the incoming ring buffer at
+  // once instead of reading each record's header and body separately
+  SSL_set_read_ahead(ssl_, 1);
+  SSL_CTX_set_verify(context->ssl_ctx_, SSL_VERIFY_NONE, ssl_no_verify_callback);
 #if DEBUG_SSL
-  SSL_CTX_set_info_callback(ssl_ctx, ssl_info_callback);
+  SSL_CTX_set_info_callback(context->ssl_ctx_, ssl_info_callback);
 #endif
   SSL_set_connect_state(ssl_);
+  SSL_set_app_data(ssl_, this);
+
+  // Attempt to resume the last session negotiated with this host. OpenSSL
+  // falls back to a full handshake if the server doesn't accept it.
+  SSL_SESSION* session = context_->get1_session(host->address());
+  if (session != NULL) {
+    SSL_set_session(ssl_, session);
+    SSL_SESSION_free(session);
+  }
+#ifdef CASS_USE_KTLS
+  if (kernel_offload) {
+    // OpenSSL offers the traffic keys to the BIOs when it changes cipher state
+    // and continues in userspace when they decline them. The read BIO
+    // receives the server's keys and the write BIO the client's keys.
+    SSL_set_options(ssl_, SSL_OP_ENABLE_KTLS);
+    incoming_state_.ktls_callback = on_kernel_keys;
+    incoming_state_.ktls_data = &rx_keys_;
+    outgoing_state_.ktls_callback = on_kernel_keys;
+    outgoing_state_.ktls_data = &tx_keys_;
+  }
+#endif
 }
 
 OpenSslSession::~OpenSslSession() {
+  if (has_error()) {
+    // Don't attempt to resume a session that's associated with a failure
+    context_->remove_session(host_->address());
+  } else {
+    // Connections are closed without a TLS shutdown (close_notify) and OpenSSL
+    // marks the session as not resumable when it's freed in that state
+    SSL_set_shutdown(ssl_, SSL_SENT_SHUTDOWN | SSL_RECEIVED_SHUTDOWN);
+  }
+#ifdef CASS_USE_KTLS
+  tx_keys_.clear();
+  rx_keys_.clear();
+#endif
   SSL_free(ssl_);
 }
 
@@ -518,6 +573,137 @@ int OpenSslSession::decrypt(char* buf, size_t size)  {
   return rc;
 }
 
+bool OpenSslSession::enable_kernel_offload(int fd) {
+#ifdef CASS_USE_KTLS
+  if (tx_keys_.size == 0) {
+    return false; // Not enabled or the negotiated cipher isn't supported
+  }
+
+  if (setsockopt(fd, SOL_TCP, TCP_ULP, "tls", sizeof("tls")) != 0) {
+    LOG_DEBUG("Unable to enable kernel TLS for host %s (%s)",
+              host_->address_string().c_str(), strerror(errno));
+    tx_keys_.clear();
+    rx_keys_.clear();
+    return false;
+  }
+
+  // The keys were captured when the cipher state changed. With TLS 1.2 both
+  // peers' Finished messages were already protected by those keys in
+  // userspace. TLS 1.3 switches to the application traffic keys after the
+  // Finished messages.
+  bool is_tls12 = SSL_version(ssl_) == TLS1_2_VERSION;
+  if (is_tls12) {
+    tx_keys_.increment_record_sequence();
+  }
+
+  int rc = setsockopt(fd, SOL_TLS, TLS_TX, &tx_keys_.crypto, tx_keys_.size);
+  tx_keys_.clear();
+  if (rc != 0) {
+    LOG_DEBUG("Unable to install kernel TLS transmit keys for host %s (%s)",
+              host_->address_string().c_str(), strerror(errno));
+    rx_keys_.clear();
+    return false;
+  }
+  kernel_offload_tx_ = true;
+
+  // OpenSSL 3.0 only offers receive keys for TLS 1.2. Records that have
+  // already been read from the socket must also be processed in userspace so
+  // the receive path can only be handed over when nothing is buffered.
+  if (is_tls12 && rx_keys_.size > 0 &&
+      incoming_.length() == 0 && !SSL_has_pending(ssl_)) {
+    rx_keys_.increment_record_sequence();
+    if (setsockopt(fd, SOL_TLS, TLS_RX, &rx_keys_.crypto, rx_keys_.size) == 0) {
+      kernel_offload_rx_ = true;
+    } else {
+      LOG_DEBUG("Unable to install kernel TLS receive keys for host %s (%s)",
+                host_->address_string().c_str(), strerror(errno));
+    }
+  }
+  rx_keys_.clear();
+
+  return true;
+#else
+  return false;
+#endif
+}
+
+#ifdef CASS_USE_KTLS
+void OpenSslSession::on_kernel_keys(void* data, int is_tx, const void* crypto_info) {
+  KernelKeys* keys = static_cast<KernelKeys*>(data);
+  if (!keys->set(crypto_info)) {
+    keys->clear();
+  }
+}
+
+bool OpenSslSession::KernelKeys::set(const void* crypto_info) {
+  // The parameters are a "struct tls_crypto_info_all" which starts with the
+  // cipher specific structure expected by setsockopt()
+  size_t crypto_size = 0;
+  switch (static_cast<const struct tls_crypto_info*>(crypto_info)->cipher_type) {
+    case TLS_CIPHER_AES_GCM_128:
+      crypto_size = sizeof(crypto.aes_gcm_128);
+      break;
+    case TLS_CIPHER_AES_GCM_256:
+      crypto_size = sizeof(crypto.aes_gcm_256);
+      break;
+    case TLS_CIPHER_AES_CCM_128:
+      crypto_size = sizeof(crypto.aes_ccm_128);
+      break;
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+    case TLS_CIPHER_CHACHA20_POLY1305:
+      crypto_size = sizeof(struct tls12_crypto_info_chacha20_poly1305);
+      break;
+#endif
+    default:
+      return false;
+  }
+  assert(crypto_size <= sizeof(crypto));
+  memcpy(&crypto, crypto_info, crypto_size);
+  size = crypto_size;
+  return true;
+}
+
+void OpenSslSession::KernelKeys::increment_record_sequence() {
+  unsigned char* rec_seq = NULL;
+  switch (crypto.info.cipher_type) {
+    case TLS_CIPHER_AES_GCM_128:
+      rec_seq = crypto.aes_gcm_128.rec_seq;
+      break;
+    case TLS_CIPHER_AES_GCM_256:
+      rec_seq = crypto.aes_gcm_256.rec_seq;
+      break;
+    case TLS_CIPHER_AES_CCM_128:
+      rec_seq = crypto.aes_ccm_128.rec_seq;
+      break;
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+    case TLS_CIPHER_CHACHA20_POLY1305:
+      rec_seq = reinterpret_cast<struct tls12_crypto_info_chacha20_poly1305*>(crypto.data)->rec_seq;
+      break;
+#endif
+    default:
+      return;
+  }
+  // The record sequence number is a 64-bit big-endian counter
+  for (int i = TLS_CIPHER_AES_GCM_128_REC_SEQ_SIZE - 1; i >= 0; --i) {
+    if (++rec_seq[i] != 0) break;
+  }
+}
+
+void OpenSslSession::KernelKeys::clear() {
+  OPENSSL_cleanse(&crypto, sizeof(crypto));
+  size = 0;
+}
+#endif
+
+int OpenSslSession::on_new_session(SSL* ssl, SSL_SESSION* session) {
+  OpenSslSession* ssl_session = static_cast<OpenSslSession*>(SSL_get_app_data(ssl));
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L && !defined(LIBRESSL_VERSION_NUMBER)
+  if (!SSL_SESSION_is_resumable(session)) return 0;
+#endif
+  ssl_session->context_->add_session(ssl_session->host_->address(), session);
+  return 1; // The cache keeps the reference to the session
+}
+
 void OpenSslSession::check_error(int rc) {
   int err = SSL_get_error(ssl_, rc);
   if (err != SSL_ERROR_WANT_READ && err != SSL_ERROR_NONE) {
@@ -528,16 +714,65 @@ void OpenSslSession::check_error(int rc) {
 
 OpenSslContext::OpenSslContext()
   : ssl_ctx_(SSL_CTX_new(SSLv23_client_method()))
-  , trusted_store_(X509_STORE_new()) {
+  , trusted_store_(X509_STORE_new())
+  , kernel_offload_(false) {
   SSL_CTX_set_cert_store(ssl_ctx_, trusted_store_);
+  // Sessions are cached by host (see OpenSslSession::on_new_session()) instead
+  // of using OpenSSL's internal cache which isn't used by clients
+  SSL_CTX_set_session_cache_mode(ssl_ctx_, SSL_SESS_CACHE_CLIENT |
+                                           SSL_SESS_CACHE_NO_INTERNAL_STORE);
+  SSL_CTX_sess_set_new_cb(ssl_ctx_, OpenSslSession::on_new_session);
+  uv_mutex_init(&sessions_mutex_);
 }
 
 OpenSslContext::~OpenSslContext() {
+  for (SessionMap::iterator it = sessions_.begin(),
+       end = sessions_.end(); it != end; ++it) {
+    SSL_SESSION_free(it->second);
+  }
+  uv_mutex_destroy(&sessions_mutex_);
   SSL_CTX_free(ssl_ctx_);
 }
 
 SslSession* OpenSslContext::create_session(const Host::ConstPtr& host) {
-  return new OpenSslSession(host, verify_flags_, ssl_ctx_);
+  return new OpenSslSession(host, verify_flags_, kernel_offload_, this);
+}
+
+SSL_SESSION* OpenSslContext::get1_session(const Address& address) {
+  ScopedMutex l(&sessions_mutex_);
+  SessionMap::iterator it = sessions_.find(address);
+  if (it == sessions_.end()) return NULL;
+  SSL_SESSION_up_ref(it->second);
+  return it->second;
+}
+
+void OpenSslContext::add_session(const Address& address, SSL_SESSION* session) {
+  ScopedMutex l(&sessions_mutex_);
+  SessionMap::iterator it = sessions_.find(address);
+  if (it != sessions_.end()) {
+    SSL_SESSION_free(it->second);
+    it->second = session;
+  } else {
+    sessions_[address] = session;
+  }
+}
+
+void OpenSslContext::remove_session(const Address& address) {
+  ScopedMutex l(&sessions_mutex_);
+  SessionMap::iterator it = sessions_.find(address);
+  if (it != sessions_.end()) {
+    SSL_SESSION_free(it->second);
+    sessions_.erase(it);
+  }
+}
+
+CassError OpenSslContext::set_kernel_offload(bool enabled) {
+#ifdef CASS_USE_KTLS
+  kernel_offload_ = enabled;
+  return CASS_OK;
+#else
+  return enabled ? CASS_ERROR_LIB_NOT_IMPLEMENTED : CASS_OK;
+#endif
 }
 
 CassError OpenSslContext::add_trusted_cert(const char* cert,
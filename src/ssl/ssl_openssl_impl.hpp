@@ -23,13 +23,25 @@
 #include <openssl/ssl.h>
 #include <openssl/bio.h>
 
+// OpenSSL only offers the traffic keys for kernel TLS starting with 3.0
+#if defined(HAVE_KTLS) && !defined(OPENSSL_NO_KTLS) && \
+    OPENSSL_VERSION_NUMBER >= 0x30000000L && !defined(LIBRESSL_VERSION_NUMBER)
+#define CASS_USE_KTLS
+#include <linux/tls.h>
+#endif
+
+#include <map>
+
 namespace cass {
 
+class OpenSslContext;
+
 class OpenSslSession : public SslSession {
 public:
   OpenSslSession(const Host::ConstPtr& host,
                  int flags,
-                 SSL_CTX* ssl_ctx);
+                 bool kernel_offload,
+                 OpenSslContext* context);
   ~OpenSslSession();
 
   virtual bool is_handshake_done() const {
@@ -42,9 +54,43 @@ public:
   virtual int encrypt(const char* buf, size_t size);
   virtual int decrypt(char* buf, size_t size);
 
+  virtual bool enable_kernel_offload(int fd);
+
+  virtual bool is_resumed() const {
+    return SSL_session_reused(ssl_) != 0;
+  }
+
+  static int on_new_session(SSL* ssl, SSL_SESSION* session);
+
 private:
   void check_error(int rc);
 
+#ifdef CASS_USE_KTLS
+  struct KernelKeys {
+    KernelKeys()
+      : size(0) { }
+
+    union {
+      struct tls_crypto_info info;
+      struct tls12_crypto_info_aes_gcm_128 aes_gcm_128;
+      struct tls12_crypto_info_aes_gcm_256 aes_gcm_256;
+      struct tls12_crypto_info_aes_ccm_128 aes_ccm_128;
+      unsigned char data[64]; // Large enough for the other ciphers
+    } crypto;
+    size_t size; // Zero if OpenSSL didn't offer the keys
+
+    bool set(const void* crypto_info);
+    void increment_record_sequence();
+    void clear();
+  };
+
+  static void on_kernel_keys(void* data, int is_tx, const void* crypto_info);
+
+  KernelKeys tx_keys_;
+  KernelKeys rx_keys_;
+#endif
+
+  SharedRefPtr<OpenSslContext> context_;
   SSL* ssl_;
   rb::RingBufferState incoming_state_;
   rb::RingBufferState outgoing_state_;
@@ -60,6 +106,8 @@ public:
 
   virtual SslSession* create_session(const Host::ConstPtr& host);
 
+  virtual CassError set_kernel_offload(bool enabled);
+
   virtual CassError add_trusted_cert(const char* cert, size_t cert_length);
   virtual CassError set_cert(const char* cert, size_t cert_length);
   virtual CassError set_private_key(const char* key,
@@ -67,9 +115,23 @@ public:
                                     const char* password,
                                     size_t password_length);
 
+private:
+  friend class OpenSslSession;
+
+  // Client-side session cache used to resume TLS sessions when reconnecting
+  // to a host. The cache holds a reference to each session.
+  typedef std::map<Address, SSL_SESSION*> SessionMap;
+
+  SSL_SESSION* get1_session(const Address& address);
+  void add_session(const Address& address, SSL_SESSION* session);
+  void remove_session(const Address& address);
+
 private:
   SSL_CTX* ssl_ctx_;
   X509_STORE* trusted_store_;
+  bool kernel_offload_;
+  uv_mutex_t sessions_mutex_;
+  SessionMap sessions_;
 };
 
 class OpenSslContextFactory : SslContextFactoryBase<OpenSslContextFactory> {
@@ -53,9 +53,21 @@ CassError cass_statement_reset_parameters(CassStatement* statement, size_t count
   return CASS_OK;
 }
 
+CassStatement* cass_statement_clone(const CassStatement* statement) {
+  cass::Statement* clone = statement->clone();
+  clone->inc_ref();
+  return CassStatement::to(clone);
+}
+
+CassError cass_statement_set_contiguous_values(CassStatement* statement,
+                                              cass_bool_t enabled) {
+  statement->set_contiguous(enabled == cass_true);
+  return CASS_OK;
+}
+
 CassError cass_statement_add_key_index(CassStatement* statement, size_t index) {
   if (statement->kind() != CASS_BATCH_KIND_QUERY) return CASS_ERROR_LIB_BAD_PARAMS;
-  if (index >= statement->elements().size()) return CASS_ERROR_LIB_BAD_PARAMS;
+  if (index >= statement->elements_count()) return CASS_ERROR_LIB_BAD_PARAMS;
   statement->add_key_index(index);
   return CASS_OK;
 }
@@ -128,12 +140,28 @@ CassError cass_statement_set_request_timeout(CassStatement* statement,
   return CASS_OK;
 }
 
+CassError cass_statement_set_deadline(CassStatement* statement,
+                                      cass_uint64_t deadline_ms) {
+  statement->set_deadline_ms(deadline_ms);
+  return CASS_OK;
+}
+
 CassError cass_statement_set_is_idempotent(CassStatement* statement,
                                            cass_bool_t is_idempotent) {
   statement->set_is_idempotent(is_idempotent == cass_true);
   return CASS_OK;
 }
 
+CassError cass_statement_set_priority(CassStatement* statement,
+                                      CassRequestPriority priority) {
+  if (priority < CASS_REQUEST_PRIORITY_INTERACTIVE ||
+      priority > CASS_REQUEST_PRIORITY_BACKGROUND) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  statement->set_priority(priority);
+  return CASS_OK;
+}
+
 CassError cass_statement_set_custom_payload(CassStatement* statement,
                                             const CassCustomPayload* payload) {
   statement->set_custom_payload(payload);
@@ -208,6 +236,60 @@ CassError cass_statement_bind_string_by_name_n(CassStatement* statement,
                         cass::CassString(value, SAFE_STRLEN(value)));
 }
 
+CassError cass_statement_bind_bytes_external(CassStatement* statement,
+                                             size_t index,
+                                             const cass_byte_t* value,
+                                             size_t value_size,
+                                             CassReleaseCallback release_callback,
+                                             void* release_data) {
+  return statement->set_external(index,
+                                 cass::CassBytes(value, value_size),
+                                 cass::Buffer::external(reinterpret_cast<const char*>(value),
+                                                        value_size,
+                                                        release_callback,
+                                                        release_data));
+}
+
+CassError cass_statement_bind_bytes_by_name_external(CassStatement* statement,
+                                                     const char* name,
+                                                     const cass_byte_t* value,
+                                                     size_t value_size,
+                                                     CassReleaseCallback release_callback,
+                                                     void* release_data) {
+  return statement->set_external(cass::StringRef(name),
+                                 cass::CassBytes(value, value_size),
+                                 cass::Buffer::external(reinterpret_cast<const char*>(value),
+                                                        value_size,
+                                                        release_callback,
+                                                        release_data));
+}
+
+CassError cass_statement_bind_string_external(CassStatement* statement,
+                                              size_t index,
+                                              const char* value,
+                                              size_t value_length,
+                                              CassReleaseCallback release_callback,
+                                              void* release_data) {
+  return statement->set_external(index,
+                                 cass::CassString(value, value_length),
+                                 cass::Buffer::external(value, value_length,
+                                                        release_callback,
+                                                        release_data));
+}
+
+CassError cass_statement_bind_string_by_name_external(CassStatement* statement,
+                                                      const char* name,
+                                                      const char* value,
+                                                      size_t value_length,
+                                                      CassReleaseCallback release_callback,
+                                                      void* release_data) {
+  return statement->set_external(cass::StringRef(name),
+                                 cass::CassString(value, value_length),
+                                 cass::Buffer::external(value, value_length,
+                                                        release_callback,
+                                                        release_data));
+}
+
 CassError cass_statement_bind_custom(CassStatement* statement,
                                      size_t index,
                                      const char* class_name,
@@ -290,6 +372,21 @@ Statement::Statement(const Prepared* prepared)
   }
 }
 
+Statement::Statement(const Statement& other)
+  : RoutableRequest(other.opcode())
+  , AbstractData(0)
+  , query_or_id_(other.query_or_id_)
+  , flags_(other.flags_)
+  , page_size_(other.page_size_)
+  , paging_state_(other.paging_state_)
+  , key_indices_(other.key_indices_) {
+  set_settings(other.settings());
+  set_timestamp(other.timestamp());
+  set_record_attempted_addresses(other.record_attempted_addresses());
+  set_custom_payload(other.custom_payload().get());
+  copy_values(other);
+}
+
 std::string Statement::query() const {
   if (opcode() == CQL_OPCODE_QUERY) {
     return std::string(query_or_id_.data() + sizeof(int32_t),
@@ -320,11 +417,11 @@ int32_t Statement::encode_batch(int version, RequestCallback* callback, BufferVe
   { // <n> [short]
     bufs->push_back(Buffer(sizeof(uint16_t)));
     Buffer& buf = bufs->back();
-    buf.encode_uint16(0, elements().size());
+    buf.encode_uint16(0, elements_count());
     length += sizeof(uint16_t);
   }
 
-  if (elements().size() > 0) {
+  if (elements_count() > 0) {
     int32_t result = encode_values(version, callback, bufs);
     if (result < 0) return result;
     length += result;
@@ -356,7 +453,7 @@ int32_t Statement::encode_v1(RequestCallback* callback, BufferVec* bufs) const {
   if (opcode() == CQL_OPCODE_EXECUTE) {
     { // <n> [short]
       Buffer buf(sizeof(uint16_t));
-      buf.encode_uint16(0, elements().size());
+      buf.encode_uint16(0, elements_count());
       bufs->push_back(buf);
       length += sizeof(uint16_t);
     }
@@ -463,14 +560,36 @@ int32_t Statement::encode_begin(int version, uint16_t element_count,
 // where:
 // <value> is a [bytes]
 int32_t Statement::encode_values(int version, RequestCallback* callback, BufferVec* bufs) const {
+  // Contiguous values are already encoded as a single buffer. Collections
+  // are encoded for protocol v3+ so older versions encode each value.
+  // External values are written as separate buffers to avoid copying them.
+  const EncodedValues* encoded = encoded_values();
+  if (encoded != NULL && !encoded->has_externals() &&
+      (version >= 3 || !encoded->has_collections())) {
+    if (version < 4) {
+      for (size_t i = 0; i < encoded->count(); ++i) {
+        if (encoded->is_unset(i)) {
+          std::stringstream ss;
+          ss << "Query parameter at index " << i << " was not set";
+          callback->on_error(CASS_ERROR_LIB_PARAMETER_UNSET, ss.str());
+          return Request::REQUEST_ERROR_PARAMETER_UNSET;
+        }
+      }
+    }
+    if (encoded->size() > 0) {
+      bufs->push_back(encoded->encode());
+    }
+    return encoded->size();
+  }
+
   int32_t length = 0;
-  for (size_t i = 0; i < elements().size(); ++i) {
-    const Element& element = elements()[i];
-    if (!element.is_unset()) {
-      bufs->push_back(element.get_buffer(version));
+  for (size_t i = 0; i < elements_count(); ++i) {
+    if (!is_unset(i)) {
+      length += get_buffers(i, version, bufs);
     } else  {
       if (version >= 4) {
         bufs->push_back(cass::encode_with_length(CassUnset()));
+        length += bufs->back().size();
       } else {
         std::stringstream ss;
         ss << "Query parameter at index " << i << " was not set";
@@ -478,7 +597,6 @@ int32_t Statement::encode_values(int version, RequestCallback* callback, BufferV
         return Request::REQUEST_ERROR_PARAMETER_UNSET;
       }
     }
-    length += bufs->back().size();
   }
   return length;
 }
@@ -551,12 +669,12 @@ bool Statement::calculate_routing_key(const std::vector<size_t>& key_indices, st
   if (key_indices.empty()) return false;
 
   if (key_indices.size() == 1) {
-    assert(key_indices.front() < elements().size());
-    const AbstractData::Element& element(elements()[key_indices.front()]);
-    if (element.is_unset() || element.is_null()) {
+    assert(key_indices.front() < elements_count());
+    size_t index = key_indices.front();
+    if (is_unset(index) || is_null(index)) {
       return false;
     }
-    Buffer buf(element.get_buffer(CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION));
+    Buffer buf(get_buffer(index, CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION));
     routing_key->assign(buf.data() + sizeof(int32_t),
                         buf.size() - sizeof(int32_t));
   } else {
@@ -564,12 +682,11 @@ bool Statement::calculate_routing_key(const std::vector<size_t>& key_indices, st
 
     for (std::vector<size_t>::const_iterator i = key_indices.begin();
          i != key_indices.end(); ++i) {
-      assert(*i < elements().size());
-      const AbstractData::Element& element(elements()[*i]);
-      if (element.is_unset() || element.is_null()) {
+      assert(*i < elements_count());
+      if (is_unset(*i) || is_null(*i)) {
         return false;
       }
-      size_t size = element.get_size(CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION) - sizeof(int32_t);
+      size_t size = get_size(*i, CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION) - sizeof(int32_t);
       length += sizeof(uint16_t) + size + 1;
     }
 
@@ -578,8 +695,7 @@ bool Statement::calculate_routing_key(const std::vector<size_t>& key_indices, st
 
     for (std::vector<size_t>::const_iterator i = key_indices.begin();
          i != key_indices.end(); ++i) {
-      const AbstractData::Element& element(elements()[*i]);
-      Buffer buf(element.get_buffer(CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION));
+      Buffer buf(get_buffer(*i, CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION));
       size_t size = buf.size() - sizeof(int32_t);
 
       char size_buf[sizeof(uint16_t)];
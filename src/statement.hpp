@@ -46,6 +46,11 @@ public:
 
   virtual ~Statement() { }
 
+  // Creates a copy of the statement with the same settings and values. This
+  // doesn't copy the query (or prepared ID) or the values' buffers so it's
+  // much cheaper than creating a new statement.
+  virtual Statement* clone() const = 0;
+
   // Used to get the original query string from a simple statement. To get the
   // query from a execute request (bound statement) cast it and get it from the
   // prepared object.
@@ -87,6 +92,8 @@ public:
   int32_t encode_batch(int version, RequestCallback* callback, BufferVec* bufs) const;
 
 protected:
+  Statement(const Statement& other);
+
   bool with_keyspace(int version) const;
 
   int32_t encode_v1(RequestCallback* callback, BufferVec* bufs) const;
@@ -107,7 +114,7 @@ private:
   std::vector<size_t> key_indices_;
 
 private:
-  DISALLOW_COPY_AND_ASSIGN(Statement);
+  Statement& operator=(const Statement&);
 };
 
 } // namespace cass
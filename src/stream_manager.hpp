@@ -17,6 +17,7 @@
 #ifndef __CASS_STREAM_MANAGER_HPP_INCLUDED__
 #define __CASS_STREAM_MANAGER_HPP_INCLUDED__
 
+#include "dense_hash_map.hpp"
 #include "macros.hpp"
 #include "scoped_ptr.hpp"
 
@@ -24,7 +25,6 @@
 #include <stdint.h>
 #include <string.h>
 
-#include <sparsehash/dense_hash_map>
 
 #if defined(_MSC_VER)
 #include <intrin.h>
@@ -69,6 +69,15 @@ public:
     release_stream(stream);
   }
 
+  bool get_pending(int stream, T& output) const {
+    typename PendingMap::const_iterator i = pending_.find(stream);
+    if (i != pending_.end()) {
+      output = i->second;
+      return true;
+    }
+    return false;
+  }
+
   bool get_pending_and_release(int stream, T& output) {
     typename PendingMap::iterator i = pending_.find(stream);
     if (i != pending_.end()) {
@@ -85,7 +94,7 @@ public:
   size_t max_streams() const { return max_streams_; }
 
 private:
-  typedef sparsehash::dense_hash_map<int, T> PendingMap;
+  typedef DenseHashMap<int, T> PendingMap;
 
 #if defined(_MSC_VER) && defined(_M_AMD64)
   typedef __int64 word_t;
@@ -19,6 +19,8 @@
 
 #include "collection_iterator.hpp"
 #include "constants.hpp"
+#include "dense_hash_map.hpp"
+#include "dense_hash_set.hpp"
 #include "map_iterator.hpp"
 #include "result_iterator.hpp"
 #include "result_response.hpp"
@@ -29,8 +31,6 @@
 
 #include "third_party/rapidjson/rapidjson/document.h"
 
-#include <sparsehash/dense_hash_map>
-
 #include <assert.h>
 #include <algorithm>
 #include <queue>
@@ -69,7 +69,7 @@ struct HostHash {
 
 class IdGenerator {
 public:
-  typedef sparsehash::dense_hash_map<std::string, uint32_t> IdMap;
+  typedef DenseHashMap<std::string, uint32_t> IdMap;
 
   static const uint32_t EMPTY_KEY;
   static const uint32_t DELETED_KEY;
@@ -138,7 +138,7 @@ public:
   static StringRef name() { return "ByteOrderedPartitioner"; }
 };
 
-class HostSet : public sparsehash::dense_hash_set<Host::Ptr, HostHash> {
+class HostSet : public DenseHashSet<Host::Ptr, HostHash> {
 public:
   HostSet() {
     set_empty_key(Host::Ptr(new Host(Address::EMPTY_KEY, false)));
@@ -146,7 +146,7 @@ public:
   }
 };
 
-class RackSet : public sparsehash::dense_hash_set<uint32_t> {
+class RackSet : public DenseHashSet<uint32_t> {
 public:
   RackSet() {
     set_empty_key(IdGenerator::EMPTY_KEY);
@@ -161,7 +161,7 @@ struct Datacenter {
   RackSet racks;
 };
 
-class DatacenterMap : public sparsehash::dense_hash_map<uint32_t, Datacenter> {
+class DatacenterMap : public DenseHashMap<uint32_t, Datacenter> {
 public:
   DatacenterMap() {
     set_empty_key(IdGenerator::EMPTY_KEY);
@@ -193,7 +193,7 @@ inline void build_datacenters(const HostSet& hosts, DatacenterMap& result) {
   }
 }
 
-class ReplicationFactorMap : public sparsehash::dense_hash_map<uint32_t, ReplicationFactor> {
+class ReplicationFactorMap : public DenseHashMap<uint32_t, ReplicationFactor> {
 public:
   ReplicationFactorMap() {
     set_empty_key(IdGenerator::EMPTY_KEY);
@@ -225,10 +225,10 @@ public:
     TokenHostQueue skipped_endpoints;
   };
 
-  class DatacenterRackInfoMap : public sparsehash::dense_hash_map<uint32_t, DatacenterRackInfo> {
+  class DatacenterRackInfoMap : public DenseHashMap<uint32_t, DatacenterRackInfo> {
   public:
     DatacenterRackInfoMap () {
-      sparsehash::dense_hash_map<uint32_t, DatacenterRackInfo>::set_empty_key(IdGenerator::EMPTY_KEY);
+      DenseHashMap<uint32_t, DatacenterRackInfo>::set_empty_key(IdGenerator::EMPTY_KEY);
     }
   };
 
@@ -547,8 +547,8 @@ public:
     }
   };
 
-  typedef sparsehash::dense_hash_map<std::string, TokenReplicasVec> KeyspaceReplicaMap;
-  typedef sparsehash::dense_hash_map<std::string, ReplicationStrategy<Partitioner> > KeyspaceStrategyMap;
+  typedef DenseHashMap<std::string, TokenReplicasVec> KeyspaceReplicaMap;
+  typedef DenseHashMap<std::string, ReplicationStrategy<Partitioner> > KeyspaceStrategyMap;
 
   static const CopyOnWriteHostVec NO_REPLICAS;
 
@@ -79,6 +79,20 @@ CASS_TUPLE_SET(duration,
 
 #undef CASS_TUPLE_SET
 
+#define CASS_TUPLE_SET_ARRAY(Name, Type)                                    \
+ CassError cass_tuple_set_##Name##_array(CassTuple* tuple, size_t index,    \
+                                         const Type* values, size_t count) { \
+   return tuple->set(index, values, count);                                 \
+ }
+
+CASS_TUPLE_SET_ARRAY(int32, cass_int32_t)
+CASS_TUPLE_SET_ARRAY(int64, cass_int64_t)
+CASS_TUPLE_SET_ARRAY(float, cass_float_t)
+CASS_TUPLE_SET_ARRAY(double, cass_double_t)
+CASS_TUPLE_SET_ARRAY(uuid, CassUuid)
+
+#undef CASS_TUPLE_SET_ARRAY
+
 CassError cass_tuple_set_string(CassTuple* tuple,
                                 size_t index,
                                 const char* value) {
@@ -123,6 +137,41 @@ CassError Tuple::set(size_t index, CassNull value) {
   return CASS_OK;
 }
 
+CassError Tuple::set(size_t index, const cass_int32_t* values, size_t count) {
+  return set_array(index, values, count);
+}
+
+CassError Tuple::set(size_t index, const cass_int64_t* values, size_t count) {
+  return set_array(index, values, count);
+}
+
+CassError Tuple::set(size_t index, const cass_float_t* values, size_t count) {
+  return set_array(index, values, count);
+}
+
+CassError Tuple::set(size_t index, const cass_double_t* values, size_t count) {
+  return set_array(index, values, count);
+}
+
+CassError Tuple::set(size_t index, const CassUuid* values, size_t count) {
+  return set_array(index, values, count);
+}
+
+template <class T>
+CassError Tuple::set_array(size_t index, const T* values, size_t count) {
+  if (index + count > items_.size()) {
+    return CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS;
+  }
+  // Validate all the items first so that nothing is set on error
+  for (size_t i = 0; i < count; ++i) {
+    CASS_TUPLE_CHECK_INDEX_AND_TYPE(index + i, values[i]);
+  }
+  for (size_t i = 0; i < count; ++i) {
+    items_[index + i] = cass::encode_with_length(values[i]);
+  }
+  return CASS_OK;
+}
+
 CassError Tuple::set(size_t index, const Tuple* value) {
   CASS_TUPLE_CHECK_INDEX_AND_TYPE(index, value);
   items_[index] = value->encode_with_length();
@@ -78,6 +78,13 @@ public:
   CassError set(size_t index, const Tuple* value);
   CassError set(size_t index, const UserTypeValue* value);
 
+  // Sets "count" consecutive items starting at "index"
+  CassError set(size_t index, const cass_int32_t* values, size_t count);
+  CassError set(size_t index, const cass_int64_t* values, size_t count);
+  CassError set(size_t index, const cass_float_t* values, size_t count);
+  CassError set(size_t index, const cass_double_t* values, size_t count);
+  CassError set(size_t index, const CassUuid* values, size_t count);
+
   Buffer encode() const;
   Buffer encode_with_length() const;
 
@@ -97,6 +104,9 @@ private:
     return CASS_OK;
   }
 
+  template <class T>
+  CassError set_array(size_t index, const T* values, size_t count);
+
   size_t get_buffers_size() const;
   void encode_buffers(size_t pos, Buffer* buf) const;
 